@@ -0,0 +1,154 @@
+#include <vulkan/vulkan.hpp>
+#include "BindlessTable.h"
+#include "Device.h"
+#include "LayoutCache.h"
+#include <array>
+
+namespace vg {
+BindlessTable::BindlessTable(
+    uint32_t maxSampledImages, uint32_t maxStorageBuffers, uint32_t maxSamplers, uint32_t frameCount,
+    Flags<ShaderStage> stages
+)
+    : m_currentFrame(0) {
+    assert(currentDevice->IsExtensionEnabled(VK_EXT_DESCRIPTOR_INDEXING_EXTENSION_NAME));
+    assert(frameCount > 0);
+
+    m_images.capacity = maxSampledImages;
+    m_buffers.capacity = maxStorageBuffers;
+    m_samplers.capacity = maxSamplers;
+    m_images.retired.resize(frameCount);
+    m_buffers.retired.resize(frameCount);
+    m_samplers.retired.resize(frameCount);
+
+    std::array<DescriptorSetLayoutBinding, 3> bindings = {
+        DescriptorSetLayoutBinding(sampledImageBinding, DescriptorType::SampledImage, maxSampledImages, stages),
+        DescriptorSetLayoutBinding(storageBufferBinding, DescriptorType::StorageBuffer, maxStorageBuffers, stages),
+        DescriptorSetLayoutBinding(samplerBinding, DescriptorType::Sampler, maxSamplers, stages),
+    };
+    Flags<DescriptorBinding> flags = {
+        DescriptorBinding::PartiallyBound, DescriptorBinding::UpdateAfterBind,
+        DescriptorBinding::UpdateUnusedWhilePending
+    };
+    std::array<Flags<DescriptorBinding>, 3> bindingFlags = {
+        flags, flags, flags | DescriptorBinding::VariableDescriptorCount
+    };
+    m_setLayout = currentDevice->GetLayoutCache().AcquireSetLayout(
+        bindings, DescriptorSetLayoutCreate::UpdateAfterBindPool, bindingFlags
+    );
+
+    DeviceHandle device = *currentDevice;
+    std::array<vk::DescriptorPoolSize, 3> sizes = {
+        vk::DescriptorPoolSize(vk::DescriptorType::eSampledImage, maxSampledImages),
+        vk::DescriptorPoolSize(vk::DescriptorType::eStorageBuffer, maxStorageBuffers),
+        vk::DescriptorPoolSize(vk::DescriptorType::eSampler, maxSamplers),
+    };
+    m_pool = device.createDescriptorPool(
+        vk::DescriptorPoolCreateInfo(vk::DescriptorPoolCreateFlagBits::eUpdateAfterBind, 1, sizes)
+    );
+
+    vk::DescriptorSetVariableDescriptorCountAllocateInfo variableCountInfo(1, &maxSamplers);
+    vk::DescriptorSetLayout setLayout = m_setLayout;
+    m_set = device.allocateDescriptorSets(vk::DescriptorSetAllocateInfo(m_pool, 1, &setLayout, &variableCountInfo))[0];
+}
+
+BindlessTable::BindlessTable() : m_currentFrame(0) {}
+
+BindlessTable::BindlessTable(BindlessTable &&other) noexcept : BindlessTable() { *this = std::move(other); }
+
+BindlessTable::~BindlessTable() {
+    if (!m_pool) return;
+
+    ((DeviceHandle)*currentDevice).destroyDescriptorPool(m_pool);
+    currentDevice->GetLayoutCache().Release(m_setLayout);
+    m_pool = nullptr;
+}
+
+BindlessTable &BindlessTable::operator=(BindlessTable &&other) noexcept {
+    if (&other == this) return *this;
+
+    std::swap(m_setLayout, other.m_setLayout);
+    std::swap(m_pool, other.m_pool);
+    std::swap(m_set, other.m_set);
+    std::swap(m_writer, other.m_writer);
+    std::swap(m_images, other.m_images);
+    std::swap(m_buffers, other.m_buffers);
+    std::swap(m_samplers, other.m_samplers);
+    std::swap(m_currentFrame, other.m_currentFrame);
+
+    return *this;
+}
+
+BindlessTable::operator const DescriptorSetHandle &() const { return m_set; }
+
+uint32_t BindlessTable::AddImage(const ImageView &imageView, ImageLayout layout) {
+    uint32_t index = m_images.Allocate();
+    m_writer.WriteImages(
+        m_set, sampledImageBinding, DescriptorType::SampledImage,
+        DescriptorImageInfo(SamplerHandle(), imageView, layout), index
+    );
+    return index;
+}
+
+uint32_t BindlessTable::AddBuffer(const Buffer &buffer, uint64_t offset, uint64_t range) {
+    uint32_t index = m_buffers.Allocate();
+    m_writer.WriteBuffer(m_set, storageBufferBinding, DescriptorType::StorageBuffer, buffer, offset, range, index);
+    return index;
+}
+
+uint32_t BindlessTable::AddSampler(const Sampler &sampler) {
+    uint32_t index = m_samplers.Allocate();
+    m_writer.WriteImages(m_set, samplerBinding, DescriptorType::Sampler, DescriptorImageInfo(sampler), index);
+    return index;
+}
+
+void BindlessTable::RemoveImage(uint32_t index) { m_images.Retire(index, m_currentFrame); }
+
+void BindlessTable::RemoveBuffer(uint32_t index) { m_buffers.Retire(index, m_currentFrame); }
+
+void BindlessTable::RemoveSampler(uint32_t index) { m_samplers.Retire(index, m_currentFrame); }
+
+void BindlessTable::Update() {
+    m_writer.Flush();
+
+    // Indices retired frameCount updates ago can no longer be used by the GPU.
+    m_currentFrame = (m_currentFrame + 1) % m_images.retired.size();
+    m_images.Recycle(m_currentFrame);
+    m_buffers.Recycle(m_currentFrame);
+    m_samplers.Recycle(m_currentFrame);
+}
+
+DescriptorSetLayoutHandle BindlessTable::GetSetLayout() const { return m_setLayout; }
+
+uint32_t BindlessTable::GetImageCount() const { return m_images.GetCount(); }
+
+uint32_t BindlessTable::GetBufferCount() const { return m_buffers.GetCount(); }
+
+uint32_t BindlessTable::GetSamplerCount() const { return m_samplers.GetCount(); }
+
+uint32_t BindlessTable::Slots::Allocate() {
+    if (!free.empty()) {
+        uint32_t index = free.back();
+        free.pop_back();
+        return index;
+    }
+
+    if (next == capacity) throw std::runtime_error("Bindless table is full");
+    return next++;
+}
+
+void BindlessTable::Slots::Retire(uint32_t index, uint32_t frame) {
+    assert(index < next);
+    retired[frame].push_back(index);
+}
+
+void BindlessTable::Slots::Recycle(uint32_t frame) {
+    free.insert(free.end(), retired[frame].begin(), retired[frame].end());
+    retired[frame].clear();
+}
+
+uint32_t BindlessTable::Slots::GetCount() const {
+    uint32_t count = next - free.size();
+    for (auto &&frame : retired) count -= frame.size();
+    return count;
+}
+} // namespace vg
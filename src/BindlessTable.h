@@ -0,0 +1,98 @@
+#pragma once
+#include <vector>
+#include "Handle.h"
+#include "Structs.h"
+#include "Buffer.h"
+#include "ImageView.h"
+#include "Sampler.h"
+#include "DescriptorWriter.h"
+
+namespace vg {
+/**
+ *@brief One large descriptor set holding every sampled image, storage buffer and sampler
+ * Resources get stable indices that shaders read from push constants, so the set is bound once per frame instead of
+ * once per draw. Built on descriptor indexing, the device has to be created with VK_EXT_descriptor_indexing.
+ * Bindings are partially bound and update after bind, the sampler binding has a variable count.
+ */
+class BindlessTable {
+  public:
+    static constexpr uint32_t sampledImageBinding = 0;
+    static constexpr uint32_t storageBufferBinding = 1;
+    static constexpr uint32_t samplerBinding = 2;
+
+  public:
+    /**
+     *@brief Construct a new Bindless Table object
+     *
+     * @param maxSampledImages Capacity of the sampled image binding
+     * @param maxStorageBuffers Capacity of the storage buffer binding
+     * @param maxSamplers Capacity of the sampler binding
+     * @param frameCount Count of frames that can be in flight, removed indices are reused only after that many updates
+     * @param stages Shader stages that can access the table
+     */
+    BindlessTable(
+        uint32_t maxSampledImages = 16384, uint32_t maxStorageBuffers = 16384, uint32_t maxSamplers = 256,
+        uint32_t frameCount = 2, Flags<ShaderStage> stages = ShaderStage::All
+    );
+
+    BindlessTable();
+    BindlessTable(BindlessTable &&other) noexcept;
+    BindlessTable(const BindlessTable &other) = delete;
+    ~BindlessTable();
+
+    BindlessTable &operator=(BindlessTable &&other) noexcept;
+    BindlessTable &operator=(const BindlessTable &other) = delete;
+    operator const DescriptorSetHandle &() const;
+
+    /**
+     *@brief Add resource to the table
+     * The descriptor is written on the next \ref BindlessTable::Update().
+     *
+     * @return Index of the resource in its binding, stays valid until removed
+     */
+    uint32_t AddImage(const ImageView &imageView, ImageLayout layout = ImageLayout::ShaderReadOnlyOptimal);
+    uint32_t AddBuffer(const Buffer &buffer, uint64_t offset = 0, uint64_t range = ~0ULL);
+    uint32_t AddSampler(const Sampler &sampler);
+
+    /**
+     *@brief Remove resource from the table
+     * The index is recycled once frames that could still use it are finished.
+     */
+    void RemoveImage(uint32_t index);
+    void RemoveBuffer(uint32_t index);
+    void RemoveSampler(uint32_t index);
+
+    /**
+     *@brief Write added descriptors and recycle indices of the oldest frame, call once per frame
+     */
+    void Update();
+
+    DescriptorSetLayoutHandle GetSetLayout() const;
+    uint32_t GetImageCount() const;
+    uint32_t GetBufferCount() const;
+    uint32_t GetSamplerCount() const;
+
+  private:
+    struct Slots {
+        uint32_t capacity = 0;
+        uint32_t next = 0;
+        std::vector<uint32_t> free;
+        std::vector<std::vector<uint32_t>> retired;
+
+        uint32_t Allocate();
+        void Retire(uint32_t index, uint32_t frame);
+        void Recycle(uint32_t frame);
+        uint32_t GetCount() const;
+    };
+
+  private:
+    DescriptorSetLayoutHandle m_setLayout;
+    DescriptorPoolHandle m_pool;
+    DescriptorSetHandle m_set;
+    DescriptorWriter m_writer;
+    Slots m_images;
+    Slots m_buffers;
+    Slots m_samplers;
+    uint32_t m_currentFrame;
+};
+} // namespace vg
@@ -35,7 +35,15 @@ uint64_t Buffer::GetSize() const { return m_size; }
 uint64_t Buffer::GetOffset() const { return m_offset; }
 MemoryBlock *Buffer::GetMemory() const { return m_memory; }
 
+uint64_t Buffer::GetDeviceAddress() const {
+    return ((DeviceHandle)*currentDevice).getBufferAddress(vk::BufferDeviceAddressInfo(m_handle));
+}
+
 char *Buffer::MapMemory() { return GetMemory()->GetMappedMemory() + m_offset; }
 
 void Buffer::UnmapMemory() { GetMemory()->UnmapMemory(); }
+
+void Buffer::InvalidateMemory() { GetMemory()->InvalidateMappedMemory(); }
+
+void Buffer::FlushMemory() { GetMemory()->FlushMappedMemory(); }
 } // namespace vg
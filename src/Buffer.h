@@ -23,9 +23,22 @@ namespace vg
         uint64_t GetSize() const;
         uint64_t GetOffset() const;
         class MemoryBlock* GetMemory() const;
+        /**
+         *@brief Get address of the buffer for use in shaders, needs BufferUsage::ShaderDeviceAddress and the device
+         * created with VK_KHR_buffer_device_address
+         */
+        uint64_t GetDeviceAddress() const;
 
         char* MapMemory();
         void UnmapMemory();
+        /**
+         *@brief Make device writes visible to the host, needed for memory that is not HostCoherent
+         */
+        void InvalidateMemory();
+        /**
+         *@brief Make host writes visible to the device, needed for memory that is not HostCoherent
+         */
+        void FlushMemory();
 
     private:
         BufferHandle m_handle;
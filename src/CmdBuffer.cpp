@@ -1,5 +1,41 @@
 #include <vulkan/vulkan.hpp>
 #include "CmdBuffer.h"
+#include "DeviceFunction.h"
+
+void vkCmdPushDescriptorSetKHR(VkCommandBuffer commandBuffer, VkPipelineBindPoint bindPoint, VkPipelineLayout layout, uint32_t set, uint32_t writeCount, const VkWriteDescriptorSet* writes)
+{
+    vg::GetDeviceFunction<PFN_vkCmdPushDescriptorSetKHR, "vkCmdPushDescriptorSetKHR">()(commandBuffer, bindPoint, layout, set, writeCount, writes);
+}
+
+void vkCmdDrawMultiIndexedEXT(VkCommandBuffer commandBuffer, uint32_t drawCount, const VkMultiDrawIndexedInfoEXT* indexInfo, uint32_t instanceCount, uint32_t firstInstance, uint32_t stride, const int32_t* vertexOffset)
+{
+    vg::GetDeviceFunction<PFN_vkCmdDrawMultiIndexedEXT, "vkCmdDrawMultiIndexedEXT">()(commandBuffer, drawCount, indexInfo, instanceCount, firstInstance, stride, vertexOffset);
+}
+
+void vkCmdDrawMeshTasksEXT(VkCommandBuffer commandBuffer, uint32_t groupCountX, uint32_t groupCountY, uint32_t groupCountZ)
+{
+    vg::GetDeviceFunction<PFN_vkCmdDrawMeshTasksEXT, "vkCmdDrawMeshTasksEXT">()(commandBuffer, groupCountX, groupCountY, groupCountZ);
+}
+
+void vkCmdDrawMeshTasksIndirectEXT(VkCommandBuffer commandBuffer, VkBuffer buffer, VkDeviceSize offset, uint32_t drawCount, uint32_t stride)
+{
+    vg::GetDeviceFunction<PFN_vkCmdDrawMeshTasksIndirectEXT, "vkCmdDrawMeshTasksIndirectEXT">()(commandBuffer, buffer, offset, drawCount, stride);
+}
+
+void vkCmdDrawMeshTasksIndirectCountEXT(VkCommandBuffer commandBuffer, VkBuffer buffer, VkDeviceSize offset, VkBuffer countBuffer, VkDeviceSize countOffset, uint32_t maxDrawCount, uint32_t stride)
+{
+    vg::GetDeviceFunction<PFN_vkCmdDrawMeshTasksIndirectCountEXT, "vkCmdDrawMeshTasksIndirectCountEXT">()(commandBuffer, buffer, offset, countBuffer, countOffset, maxDrawCount, stride);
+}
+
+void vkCmdDrawIndirectCountKHR(VkCommandBuffer commandBuffer, VkBuffer buffer, VkDeviceSize offset, VkBuffer countBuffer, VkDeviceSize countOffset, uint32_t maxDrawCount, uint32_t stride)
+{
+    vg::GetDeviceFunction<PFN_vkCmdDrawIndirectCountKHR, "vkCmdDrawIndirectCountKHR">()(commandBuffer, buffer, offset, countBuffer, countOffset, maxDrawCount, stride);
+}
+
+void vkCmdDrawIndexedIndirectCountKHR(VkCommandBuffer commandBuffer, VkBuffer buffer, VkDeviceSize offset, VkBuffer countBuffer, VkDeviceSize countOffset, uint32_t maxDrawCount, uint32_t stride)
+{
+    vg::GetDeviceFunction<PFN_vkCmdDrawIndexedIndirectCountKHR, "vkCmdDrawIndexedIndirectCountKHR">()(commandBuffer, buffer, offset, countBuffer, countOffset, maxDrawCount, stride);
+}
 
 namespace vg
 {
@@ -25,6 +61,48 @@ namespace vg
             CmdBufferHandle(commandBuffer).bindDescriptorSets((vk::PipelineBindPoint) bindPoint, layout, firstSet, descriptorSets.size(), &descriptorSets[0], 0, nullptr);
         }
 
+        void PushDescriptorSet::operator()(CmdBuffer& commandBuffer) const
+        {
+            std::vector<vk::WriteDescriptorSet> descriptorWrites(writes.size());
+            for (int i = 0; i < writes.size(); i++)
+            {
+                descriptorWrites[i].dstBinding = writes[i].binding;
+                descriptorWrites[i].dstArrayElement = writes[i].arrayElement;
+                descriptorWrites[i].descriptorCount = 1;
+                descriptorWrites[i].descriptorType = (vk::DescriptorType) writes[i].descriptorType;
+                switch (writes[i].descriptorType)
+                {
+                case DescriptorType::UniformBuffer:
+                case DescriptorType::StorageBuffer:
+                case DescriptorType::UniformBufferDynamic:
+                case DescriptorType::StorageBufferDynamic:
+                    descriptorWrites[i].pBufferInfo = (const vk::DescriptorBufferInfo*) &bufferInfos[writes[i].infoIndex];
+                    break;
+                case DescriptorType::UniformTexelBuffer:
+                case DescriptorType::StorageTexelBuffer:
+                    descriptorWrites[i].pTexelBufferView = (const vk::BufferView*) &texelBufferViews[writes[i].infoIndex];
+                    break;
+                default:
+                    descriptorWrites[i].pImageInfo = (const vk::DescriptorImageInfo*) &imageInfos[writes[i].infoIndex];
+                    break;
+                }
+            }
+            CmdBufferHandle(commandBuffer).pushDescriptorSetKHR((vk::PipelineBindPoint) bindPoint, layout, set, descriptorWrites);
+        }
+
+        void BindDescriptorBuffers::operator()(CmdBuffer& commandBuffer) const
+        {
+            std::vector<vk::DescriptorBufferBindingInfoEXT> bindings(addresses.size());
+            for (int i = 0; i < addresses.size(); i++)
+                bindings[i] = vk::DescriptorBufferBindingInfoEXT(addresses[i], (vk::BufferUsageFlags) usages[i]);
+            CmdBufferHandle(commandBuffer).bindDescriptorBuffersEXT(bindings);
+        }
+
+        void SetDescriptorBufferOffsets::operator()(CmdBuffer& commandBuffer) const
+        {
+            CmdBufferHandle(commandBuffer).setDescriptorBufferOffsetsEXT((vk::PipelineBindPoint) bindPoint, layout, firstSet, bufferIndices, *(std::vector<vk::DeviceSize>*) &offsets);
+        }
+
         void BeginRenderpass::operator()(CmdBuffer& commandBuffer) const
         {
             auto info = vk::RenderPassBeginInfo(renderpass, framebuffer, vk::Rect2D(offset, *(vk::Extent2D*) &extend), *(std::vector<vk::ClearValue>*) & clearValues);
@@ -126,6 +204,50 @@ namespace vg
             CmdBufferHandle(commandBuffer).drawIndexedIndirect(buffer, offset, drawCount, stride);
         }
 
+        void DrawMultiIndexed::operator ()(CmdBuffer& commandBuffer)const
+        {
+            CmdBufferHandle(commandBuffer).drawMultiIndexedEXT(
+                indexInfo.size(), (const vk::MultiDrawIndexedInfoEXT*)indexInfo.data(), instanceCount, firstInstance,
+                sizeof(MultiDrawIndexedInfo), nullptr
+            );
+        }
+
+        void DrawIndirectCount::operator ()(CmdBuffer& commandBuffer)const
+        {
+            assert(currentDevice->IsDrawIndirectCountEnabled());
+            // Devices older than Vulkan 1.2 only have the entry point of VK_KHR_draw_indirect_count.
+            if (currentDevice->GetApiVersion() >= VK_API_VERSION_1_2)
+                CmdBufferHandle(commandBuffer).drawIndirectCount(buffer, offset, countBuffer, countOffset, maxDrawCount, stride);
+            else
+                CmdBufferHandle(commandBuffer).drawIndirectCountKHR(buffer, offset, countBuffer, countOffset, maxDrawCount, stride);
+        }
+
+        void DrawIndexedIndirectCount::operator ()(CmdBuffer& commandBuffer)const
+        {
+            assert(currentDevice->IsDrawIndirectCountEnabled());
+            if (currentDevice->GetApiVersion() >= VK_API_VERSION_1_2)
+                CmdBufferHandle(commandBuffer).drawIndexedIndirectCount(buffer, offset, countBuffer, countOffset, maxDrawCount, stride);
+            else
+                CmdBufferHandle(commandBuffer).drawIndexedIndirectCountKHR(buffer, offset, countBuffer, countOffset, maxDrawCount, stride);
+        }
+
+        void DrawMeshTasks::operator ()(CmdBuffer& commandBuffer)const
+        {
+            CmdBufferHandle(commandBuffer).drawMeshTasksEXT(groupCountX, groupCountY, groupCountZ);
+        }
+
+        void DrawMeshTasksIndirect::operator ()(CmdBuffer& commandBuffer)const
+        {
+            CmdBufferHandle(commandBuffer).drawMeshTasksIndirectEXT(buffer, offset, drawCount, stride);
+        }
+
+        void DrawMeshTasksIndirectCount::operator ()(CmdBuffer& commandBuffer)const
+        {
+            CmdBufferHandle(commandBuffer).drawMeshTasksIndirectCountEXT(
+                buffer, offset, countBuffer, countOffset, maxDrawCount, stride
+            );
+        }
+
         void Dispatch::operator ()(CmdBuffer& commandBuffer)const
         {
             CmdBufferHandle(commandBuffer).dispatch(groupCountX, groupCountY, groupCountZ);
@@ -285,15 +407,30 @@ namespace vg
 
     CmdBuffer& CmdBuffer::Submit(Span<const std::tuple<Flags<PipelineStage>, SemaphoreHandle>> waitStages, Span<const SemaphoreHandle> signalSemaphores, const Fence& fence)
     {
-        std::vector<vk::Semaphore> semaphores(waitStages.size());
-        std::vector<vk::PipelineStageFlags> stages(waitStages.size());
+        // Usual wait counts fit on the stack, so a per frame submit doesn't allocate
+        const uint32_t inlineWaitCount = 8;
+        vk::Semaphore inlineSemaphores[inlineWaitCount];
+        vk::PipelineStageFlags inlineStages[inlineWaitCount];
+        std::vector<vk::Semaphore> heapSemaphores;
+        std::vector<vk::PipelineStageFlags> heapStages;
+        vk::Semaphore* semaphores = inlineSemaphores;
+        vk::PipelineStageFlags* stages = inlineStages;
+        if (waitStages.size() > inlineWaitCount)
+        {
+            heapSemaphores.resize(waitStages.size());
+            heapStages.resize(waitStages.size());
+            semaphores = heapSemaphores.data();
+            stages = heapStages.data();
+        }
+
         for (int i = 0; i < waitStages.size(); i++)
         {
             semaphores[i] = std::get<1>(waitStages[i]);
             stages[i] = (vk::PipelineStageFlags) std::get<0>(waitStages[i]);
         }
         vk::CommandBuffer b[1] = { m_handle };
-        m_queue.submit({ vk::SubmitInfo(semaphores,stages,b, *(Span<const vk::Semaphore>*) & signalSemaphores) }, (FenceHandle) fence);
+        vk::SubmitInfo submit(waitStages.size(), semaphores, stages, 1, b, signalSemaphores.size(), (const vk::Semaphore*) signalSemaphores.data());
+        m_queue.submit(submit, (FenceHandle) fence);
 
         return *this;
     }
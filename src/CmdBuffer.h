@@ -82,6 +82,88 @@ struct BindDescriptorSets {
     void operator()(CmdBuffer &commandBuffer) const;
     friend CmdBuffer;
 };
+/**
+ *@brief Write descriptors of a set inline into the command buffer, needs VK_KHR_push_descriptor
+ * The set layout has to be created with DescriptorSetLayoutCreate::PushDescriptor.
+ */
+struct PushDescriptorSet {
+    PushDescriptorSet() {}
+    PushDescriptorSet(PipelineLayoutHandle layout, PipelineBindPoint bindPoint, uint32_t set)
+        : layout(layout), bindPoint(bindPoint), set(set) {}
+
+    PushDescriptorSet &WriteBuffer(
+        uint32_t binding, DescriptorType descriptorType, const DescriptorBufferInfo &buffer, uint32_t arrayElement = 0
+    ) {
+        writes.push_back({binding, arrayElement, descriptorType, (uint32_t)bufferInfos.size()});
+        bufferInfos.push_back(buffer);
+        return *this;
+    }
+
+    PushDescriptorSet &WriteImage(
+        uint32_t binding, DescriptorType descriptorType, const DescriptorImageInfo &image, uint32_t arrayElement = 0
+    ) {
+        writes.push_back({binding, arrayElement, descriptorType, (uint32_t)imageInfos.size()});
+        imageInfos.push_back(image);
+        return *this;
+    }
+
+    PushDescriptorSet &WriteTexelBuffer(
+        uint32_t binding, DescriptorType descriptorType, BufferViewHandle bufferView, uint32_t arrayElement = 0
+    ) {
+        writes.push_back({binding, arrayElement, descriptorType, (uint32_t)texelBufferViews.size()});
+        texelBufferViews.push_back(bufferView);
+        return *this;
+    }
+
+    struct Write {
+        uint32_t binding;
+        uint32_t arrayElement;
+        DescriptorType descriptorType;
+        uint32_t infoIndex;
+    };
+
+    PipelineBindPoint bindPoint;
+    PipelineLayoutHandle layout;
+    uint32_t set;
+    std::vector<Write> writes;
+    std::vector<DescriptorBufferInfo> bufferInfos;
+    std::vector<DescriptorImageInfo> imageInfos;
+    std::vector<BufferViewHandle> texelBufferViews;
+
+  private:
+    void operator()(CmdBuffer &commandBuffer) const;
+    friend CmdBuffer;
+};
+struct BindDescriptorBuffers {
+    BindDescriptorBuffers() {}
+    BindDescriptorBuffers(const std::vector<uint64_t> &addresses, const std::vector<Flags<BufferUsage>> &usages)
+        : addresses(addresses), usages(usages) {}
+
+    std::vector<uint64_t> addresses;
+    std::vector<Flags<BufferUsage>> usages;
+
+  private:
+    void operator()(CmdBuffer &commandBuffer) const;
+    friend CmdBuffer;
+};
+struct SetDescriptorBufferOffsets {
+    SetDescriptorBufferOffsets() {}
+    SetDescriptorBufferOffsets(
+        PipelineLayoutHandle layout, PipelineBindPoint bindPoint, uint32_t firstSet,
+        const std::vector<uint32_t> &bufferIndices, const std::vector<uint64_t> &offsets
+    )
+        : layout(layout), bindPoint(bindPoint), firstSet(firstSet), bufferIndices(bufferIndices), offsets(offsets) {}
+
+    PipelineBindPoint bindPoint;
+    PipelineLayoutHandle layout;
+    uint32_t firstSet;
+    std::vector<uint32_t> bufferIndices;
+    std::vector<uint64_t> offsets;
+
+  private:
+    void operator()(CmdBuffer &commandBuffer) const;
+    friend CmdBuffer;
+};
 struct BeginRenderpass {
     BeginRenderpass() {}
     BeginRenderpass(
@@ -168,6 +250,24 @@ struct DrawIndexed {
     void operator()(CmdBuffer &commandBuffer) const;
     friend CmdBuffer;
 };
+/**
+ *@brief Several indexed draws sharing instance parameters in one call, needs VK_EXT_multi_draw
+ */
+struct DrawMultiIndexed {
+    DrawMultiIndexed() {}
+    DrawMultiIndexed(
+        std::vector<MultiDrawIndexedInfo> indexInfo, uint32_t instanceCount = 1, uint32_t firstInstance = 0
+    )
+        : indexInfo(indexInfo), instanceCount(instanceCount), firstInstance(firstInstance) {}
+
+    std::vector<MultiDrawIndexedInfo> indexInfo;
+    uint32_t instanceCount;
+    uint32_t firstInstance;
+
+  private:
+    void operator()(CmdBuffer &commandBuffer) const;
+    friend CmdBuffer;
+};
 struct CopyBuffer {
     CopyBuffer() {}
     CopyBuffer(Buffer &src, Buffer &dst, const std::vector<BufferCopyRegion> &regions)
@@ -398,6 +498,114 @@ struct DrawIndexedIndirect {
     void operator()(CmdBuffer &commandBuffer) const;
     friend CmdBuffer;
 };
+/**
+ *@brief Draw with parameters and draw count read from buffers, needs VK_KHR_draw_indirect_count or Vulkan 1.2,
+ * see \ref Device::IsDrawIndirectCountEnabled()
+ */
+struct DrawIndirectCount {
+    DrawIndirectCount() {}
+    DrawIndirectCount(
+        BufferHandle buffer, uint64_t offset, BufferHandle countBuffer, uint64_t countOffset, uint32_t maxDrawCount,
+        uint32_t stride
+    )
+        : buffer(buffer), offset(offset), countBuffer(countBuffer), countOffset(countOffset),
+          maxDrawCount(maxDrawCount), stride(stride) {}
+
+    BufferHandle buffer;
+    uint64_t offset;
+    BufferHandle countBuffer;
+    uint64_t countOffset;
+    uint32_t maxDrawCount;
+    uint32_t stride;
+
+  private:
+    void operator()(CmdBuffer &commandBuffer) const;
+    friend CmdBuffer;
+};
+/**
+ *@brief Indexed draw with parameters and draw count read from buffers, needs VK_KHR_draw_indirect_count or Vulkan 1.2,
+ * see \ref Device::IsDrawIndirectCountEnabled()
+ */
+struct DrawIndexedIndirectCount {
+    DrawIndexedIndirectCount() {}
+    DrawIndexedIndirectCount(
+        BufferHandle buffer, uint64_t offset, BufferHandle countBuffer, uint64_t countOffset, uint32_t maxDrawCount,
+        uint32_t stride
+    )
+        : buffer(buffer), offset(offset), countBuffer(countBuffer), countOffset(countOffset),
+          maxDrawCount(maxDrawCount), stride(stride) {}
+
+    BufferHandle buffer;
+    uint64_t offset;
+    BufferHandle countBuffer;
+    uint64_t countOffset;
+    uint32_t maxDrawCount;
+    uint32_t stride;
+
+  private:
+    void operator()(CmdBuffer &commandBuffer) const;
+    friend CmdBuffer;
+};
+/**
+ *@brief Draw with a pipeline using mesh shaders, launches task shader workgroups or mesh shader workgroups if the
+ * pipeline has no task shader, needs VK_EXT_mesh_shader
+ */
+struct DrawMeshTasks {
+    DrawMeshTasks() {}
+    DrawMeshTasks(uint32_t groupCountX, uint32_t groupCountY = 1, uint32_t groupCountZ = 1)
+        : groupCountX(groupCountX), groupCountY(groupCountY), groupCountZ(groupCountZ) {}
+
+    uint32_t groupCountX;
+    uint32_t groupCountY;
+    uint32_t groupCountZ;
+
+  private:
+    void operator()(CmdBuffer &commandBuffer) const;
+    friend CmdBuffer;
+};
+/**
+ *@brief Mesh shader draws with workgroup counts read from a buffer of \ref DrawMeshTasksIndirectCommand
+ */
+struct DrawMeshTasksIndirect {
+    DrawMeshTasksIndirect() {}
+    DrawMeshTasksIndirect(
+        BufferHandle buffer, uint64_t offset, uint32_t drawCount,
+        uint32_t stride = sizeof(DrawMeshTasksIndirectCommand)
+    )
+        : buffer(buffer), offset(offset), drawCount(drawCount), stride(stride) {}
+
+    BufferHandle buffer;
+    uint64_t offset;
+    uint32_t drawCount;
+    uint32_t stride;
+
+  private:
+    void operator()(CmdBuffer &commandBuffer) const;
+    friend CmdBuffer;
+};
+/**
+ *@brief Mesh shader draws with workgroup counts and draw count read from buffers, e.g. written by a culling pass
+ */
+struct DrawMeshTasksIndirectCount {
+    DrawMeshTasksIndirectCount() {}
+    DrawMeshTasksIndirectCount(
+        BufferHandle buffer, uint64_t offset, BufferHandle countBuffer, uint64_t countOffset, uint32_t maxDrawCount,
+        uint32_t stride = sizeof(DrawMeshTasksIndirectCommand)
+    )
+        : buffer(buffer), offset(offset), countBuffer(countBuffer), countOffset(countOffset),
+          maxDrawCount(maxDrawCount), stride(stride) {}
+
+    BufferHandle buffer;
+    uint64_t offset;
+    BufferHandle countBuffer;
+    uint64_t countOffset;
+    uint32_t maxDrawCount;
+    uint32_t stride;
+
+  private:
+    void operator()(CmdBuffer &commandBuffer) const;
+    friend CmdBuffer;
+};
 struct Dispatch {
     Dispatch() {}
     Dispatch(uint32_t groupCountX, uint32_t groupCountY, uint32_t groupCountZ)
@@ -770,6 +978,7 @@ class CmdBuffer {
 
     /**
      *@brief Submit command buffers and all relevant data
+     * Doesn't allocate unless there are more than 8 wait semaphores.
      *
      * @param submits Synchronization info
      * @param fence Fence to be signaled upon all submits finish
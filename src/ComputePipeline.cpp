@@ -3,10 +3,34 @@
 #include "ComputePipeline.h"
 
 namespace vg {
+static vk::PipelineCreateFlags GetCreateFlags(const PipelineLayout &layout) {
+    return layout.UsesDescriptorBuffer() ? vk::PipelineCreateFlagBits::eDescriptorBufferEXT : vk::PipelineCreateFlags();
+}
+
 ComputePipeline::ComputePipeline(const Shader &shader, PipelineLayout &&layout, PipelineCacheHandle cache) {
     m_pipelineLayout = std::move(layout);
     m_handle = ((DeviceHandle)*currentDevice)
-                   .createComputePipeline(cache, vk::ComputePipelineCreateInfo({}, shader, m_pipelineLayout.m_handle))
+                   .createComputePipeline(
+                       cache,
+                       vk::ComputePipelineCreateInfo(GetCreateFlags(m_pipelineLayout), shader, m_pipelineLayout.m_handle)
+                   )
+                   .value;
+}
+
+ComputePipeline::ComputePipeline(
+    const Shader &shader, PipelineLayout &&layout, const SpecializationConstants &specialization,
+    PipelineCacheHandle cache
+) {
+    m_pipelineLayout = std::move(layout);
+
+    vk::PipelineShaderStageCreateInfo stage = shader;
+    stage.pSpecializationInfo =
+        specialization.IsEmpty() ? nullptr : (const vk::SpecializationInfo *)specialization.GetInfo();
+    m_handle = ((DeviceHandle)*currentDevice)
+                   .createComputePipeline(
+                       cache,
+                       vk::ComputePipelineCreateInfo(GetCreateFlags(m_pipelineLayout), stage, m_pipelineLayout.m_handle)
+                   )
                    .value;
 }
 
@@ -10,6 +10,14 @@ class ComputePipeline {
   public:
     ComputePipeline(const Shader &shader, PipelineLayout &&layout, PipelineCacheHandle cache = PipelineCacheHandle());
 
+    /**
+     *@brief Construct a new Compute Pipeline object with specialization constants overriding the shader's own
+     */
+    ComputePipeline(
+        const Shader &shader, PipelineLayout &&layout, const SpecializationConstants &specialization,
+        PipelineCacheHandle cache = PipelineCacheHandle()
+    );
+
     ComputePipeline();
     ComputePipeline(ComputePipeline &&other) noexcept;
     ComputePipeline(const ComputePipeline &other) = delete;
@@ -0,0 +1,57 @@
+#include <vulkan/vulkan.hpp>
+#include "ComputePipelineVariants.h"
+#include "Device.h"
+#include "GraphicsPipelineCreateInfo.h"
+
+namespace vg {
+ComputePipelineVariants::ComputePipelineVariants(const Shader &shader, PipelineLayout &&layout, PipelineCacheHandle cache)
+    : m_shader(&shader), m_pipelineLayout(std::move(layout)), m_cache(cache) {}
+
+ComputePipelineVariants::ComputePipelineVariants() : m_shader(nullptr) {}
+
+ComputePipelineVariants::ComputePipelineVariants(ComputePipelineVariants &&other) noexcept
+    : ComputePipelineVariants() {
+    *this = std::move(other);
+}
+
+ComputePipelineVariants::~ComputePipelineVariants() {
+    for (auto &&[key, pipeline] : m_variants) ((DeviceHandle)*currentDevice).destroyPipeline(pipeline);
+    m_variants.clear();
+}
+
+ComputePipelineVariants &ComputePipelineVariants::operator=(ComputePipelineVariants &&other) noexcept {
+    if (&other == this) return *this;
+
+    std::swap(m_shader, other.m_shader);
+    std::swap(m_pipelineLayout, other.m_pipelineLayout);
+    std::swap(m_cache, other.m_cache);
+    std::swap(m_variants, other.m_variants);
+
+    return *this;
+}
+
+ComputePipelineHandle ComputePipelineVariants::Get(const SpecializationConstants &specialization) {
+    std::string key = specialization.GetKey();
+    auto it = m_variants.find(key);
+    if (it != m_variants.end()) return it->second;
+
+    vk::PipelineShaderStageCreateInfo stage = *m_shader;
+    stage.pSpecializationInfo =
+        specialization.IsEmpty() ? nullptr : (const vk::SpecializationInfo *)specialization.GetInfo();
+
+    PipelineLayoutHandle layout = m_pipelineLayout;
+    ComputePipelineHandle pipeline =
+        ((DeviceHandle)*currentDevice)
+            .createComputePipeline(
+                m_cache,
+                vk::ComputePipelineCreateInfo(GraphicsPipelineCreateInfo::GetLayoutFlags(layout), stage, layout)
+            )
+            .value;
+    m_variants[key] = pipeline;
+    return pipeline;
+}
+
+const PipelineLayout &ComputePipelineVariants::GetPipelineLayout() const { return m_pipelineLayout; }
+
+uint32_t ComputePipelineVariants::GetVariantCount() const { return m_variants.size(); }
+} // namespace vg
@@ -0,0 +1,50 @@
+#pragma once
+#include <string>
+#include <unordered_map>
+#include "Handle.h"
+#include "PipelineLayout.h"
+#include "Shader.h"
+#include "SpecializationConstants.h"
+
+namespace vg {
+/**
+ *@brief Specialized variants of one compute shader
+ * Each distinct set of specialization constant values is compiled once and reused, so tuning parameters like workgroup
+ * size can be baked in per dispatch without recompiling. All variants share one pipeline layout.
+ */
+class ComputePipelineVariants {
+  public:
+    /**
+     *@brief Construct a new Compute Pipeline Variants object
+     *
+     * @param shader Compute shader, has to outlive the object
+     * @param layout Pipeline layout shared by all variants
+     * @param cache Pipeline cache used when compiling variants
+     */
+    ComputePipelineVariants(
+        const Shader &shader, PipelineLayout &&layout, PipelineCacheHandle cache = PipelineCacheHandle()
+    );
+
+    ComputePipelineVariants();
+    ComputePipelineVariants(ComputePipelineVariants &&other) noexcept;
+    ComputePipelineVariants(const ComputePipelineVariants &other) = delete;
+    ~ComputePipelineVariants();
+
+    ComputePipelineVariants &operator=(ComputePipelineVariants &&other) noexcept;
+    ComputePipelineVariants &operator=(const ComputePipelineVariants &other) = delete;
+
+    /**
+     *@brief Get variant with the constant values, compiling it on first use
+     */
+    ComputePipelineHandle Get(const SpecializationConstants &specialization);
+
+    const PipelineLayout &GetPipelineLayout() const;
+    uint32_t GetVariantCount() const;
+
+  private:
+    const Shader *m_shader;
+    PipelineLayout m_pipelineLayout;
+    PipelineCacheHandle m_cache;
+    std::unordered_map<std::string, ComputePipelineHandle> m_variants;
+};
+} // namespace vg
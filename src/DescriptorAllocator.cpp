@@ -0,0 +1,159 @@
+#include <vulkan/vulkan.hpp>
+#include <algorithm>
+#include <bit>
+#include "DescriptorAllocator.h"
+#include "Device.h"
+#include "LayoutCache.h"
+
+namespace vg {
+DescriptorAllocator::DescriptorAllocator(
+    uint32_t frameCount, uint32_t setsPerPool, Span<const DescriptorPoolSize> descriptorsPerSet
+)
+    : m_frames(frameCount), m_poolSizes(descriptorsPerSet.begin(), descriptorsPerSet.end()), m_currentFrame(0),
+      m_setsPerPool(setsPerPool), m_generation(0) {
+    assert(frameCount > 0 && setsPerPool > 0);
+
+    for (auto &&size : m_poolSizes) size.descriptorCount *= setsPerPool;
+}
+
+DescriptorAllocator::DescriptorAllocator() : m_currentFrame(0), m_setsPerPool(0), m_generation(0) {}
+
+DescriptorAllocator::DescriptorAllocator(DescriptorAllocator &&other) noexcept : DescriptorAllocator() {
+    *this = std::move(other);
+}
+
+DescriptorAllocator::~DescriptorAllocator() {
+    for (auto &&frame : m_frames)
+        for (auto &&pool : frame.pools) DestroyPool(pool);
+    for (auto &&pool : m_freePools) DestroyPool(pool);
+}
+
+DescriptorAllocator &DescriptorAllocator::operator=(DescriptorAllocator &&other) noexcept {
+    if (&other == this) return *this;
+
+    std::swap(m_frames, other.m_frames);
+    std::swap(m_freePools, other.m_freePools);
+    std::swap(m_poolSizes, other.m_poolSizes);
+    std::swap(m_setCounts, other.m_setCounts);
+    std::swap(m_currentFrame, other.m_currentFrame);
+    std::swap(m_setsPerPool, other.m_setsPerPool);
+    std::swap(m_generation, other.m_generation);
+
+    return *this;
+}
+
+DescriptorSet DescriptorAllocator::Allocate(DescriptorSetLayoutHandle setLayout) {
+    Frame &frame = m_frames[m_currentFrame];
+    if (frame.pools.empty()) frame.pools.push_back(GetPool());
+
+    VkDescriptorSetLayout layout = setLayout;
+    VkDescriptorSetAllocateInfo info{};
+    info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+    info.descriptorPool = frame.pools.back().handle;
+    info.descriptorSetCount = 1;
+    info.pSetLayouts = &layout;
+
+    VkDescriptorSet set;
+    VkResult result = vkAllocateDescriptorSets((DeviceHandle)*currentDevice, &info, &set);
+    LayoutCache &layoutCache = currentDevice->GetLayoutCache();
+    if (result == VK_ERROR_OUT_OF_POOL_MEMORY || result == VK_ERROR_FRAGMENTED_POOL) {
+        // A single set can need more descriptors of a type than a whole pool holds.
+        m_setCounts.clear();
+        layoutCache.AddDescriptorCounts(setLayout, m_setCounts);
+        Grow(1, m_setCounts);
+
+        frame.pools.push_back(GetPool());
+        info.descriptorPool = frame.pools.back().handle;
+        result = vkAllocateDescriptorSets((DeviceHandle)*currentDevice, &info, &set);
+    }
+    if (result != VK_SUCCESS) throw std::runtime_error("Failed to allocate descriptor set");
+
+    frame.setCount++;
+    layoutCache.AddDescriptorCounts(setLayout, frame.descriptorCounts);
+    return DescriptorSet(vk::DescriptorSet(set), DescriptorPoolHandle());
+}
+
+std::vector<DescriptorSet> DescriptorAllocator::Allocate(Span<const DescriptorSetLayoutHandle> setLayouts) {
+    std::vector<DescriptorSet> sets;
+    sets.reserve(setLayouts.size());
+    for (auto &&setLayout : setLayouts) sets.push_back(Allocate(setLayout));
+    return sets;
+}
+
+void DescriptorAllocator::NextFrame() {
+    m_currentFrame = (m_currentFrame + 1) % m_frames.size();
+    Frame &frame = m_frames[m_currentFrame];
+
+    // Frame overflowed its pool, grow so next time a single pool is enough.
+    if (frame.pools.size() > 1) Grow(frame.setCount, frame.descriptorCounts);
+
+    for (auto &&pool : frame.pools) {
+        if (pool.generation != m_generation) {
+            DestroyPool(pool);
+            continue;
+        }
+        vkResetDescriptorPool((DeviceHandle)*currentDevice, pool.handle, 0);
+        m_freePools.push_back(pool);
+    }
+    frame.pools.clear();
+    frame.setCount = 0;
+    frame.descriptorCounts.clear();
+}
+
+uint32_t DescriptorAllocator::GetFrameCount() const { return m_frames.size(); }
+
+uint32_t DescriptorAllocator::GetCurrentFrame() const { return m_currentFrame; }
+
+uint32_t DescriptorAllocator::GetSetsPerPool() const { return m_setsPerPool; }
+
+uint32_t DescriptorAllocator::GetPoolCount() const {
+    uint32_t count = m_freePools.size();
+    for (auto &&frame : m_frames) count += frame.pools.size();
+    return count;
+}
+
+DescriptorAllocator::Pool DescriptorAllocator::GetPool() {
+    while (!m_freePools.empty()) {
+        Pool pool = m_freePools.back();
+        m_freePools.pop_back();
+        if (pool.generation == m_generation) return pool;
+        DestroyPool(pool);
+    }
+
+    Pool pool;
+    pool.generation = m_generation;
+    pool.handle = ((DeviceHandle)*currentDevice)
+                      .createDescriptorPool(vk::DescriptorPoolCreateInfo(
+                          {}, m_setsPerPool, m_poolSizes.size(), (const vk::DescriptorPoolSize *)m_poolSizes.data()
+                      ));
+    return pool;
+}
+
+void DescriptorAllocator::DestroyPool(const Pool &pool) {
+    ((DeviceHandle)*currentDevice).destroyDescriptorPool(pool.handle);
+}
+
+void DescriptorAllocator::Grow(uint32_t setCount, Span<const DescriptorPoolSize> descriptorCounts) {
+    bool grown = false;
+    if (std::bit_ceil(setCount) > m_setsPerPool) {
+        m_setsPerPool = std::bit_ceil(setCount);
+        grown = true;
+    }
+
+    for (auto &&count : descriptorCounts) {
+        uint32_t required = std::bit_ceil(count.descriptorCount);
+        auto size = std::find_if(m_poolSizes.begin(), m_poolSizes.end(), [&](const DescriptorPoolSize &size) {
+            return size.descriptorType == count.descriptorType;
+        });
+        if (size == m_poolSizes.end()) {
+            m_poolSizes.emplace_back(count.descriptorType, required);
+            grown = true;
+        } else if (size->descriptorCount < required) {
+            size->descriptorCount = required;
+            grown = true;
+        }
+    }
+
+    if (grown) m_generation++;
+}
+} // namespace vg
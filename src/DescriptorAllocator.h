@@ -0,0 +1,101 @@
+#pragma once
+#include <vector>
+#include "Handle.h"
+#include "Structs.h"
+#include "DescriptorSet.h"
+#include "Span.h"
+
+namespace vg {
+/**
+ *@brief Allocates short lived descriptor sets from recycled pools
+ * Each frame allocates from its own chain of pools, a new pool is chained when the current one runs out. Sets are never
+ * freed individually, \ref DescriptorAllocator::NextFrame() resets all pools of the frame at once. Pool size grows to
+ * the peak count of sets and of descriptors of each type a frame needed, so after a few frames every frame fits into
+ * a single pool. Descriptors are counted for layouts from the device's \ref LayoutCache.
+ */
+class DescriptorAllocator {
+  public:
+    /**
+     *@brief Construct a new Descriptor Allocator object
+     *
+     * @param frameCount Count of frames that can be in flight at once
+     * @param setsPerPool Initial count of sets per pool
+     * @param descriptorsPerSet Expected count of descriptors of each type in one set, the first pools are sized from
+     * it
+     */
+    DescriptorAllocator(
+        uint32_t frameCount = 2, uint32_t setsPerPool = 64,
+        Span<const DescriptorPoolSize> descriptorsPerSet =
+            {{DescriptorType::Sampler, 1},
+             {DescriptorType::CombinedImageSampler, 4},
+             {DescriptorType::SampledImage, 4},
+             {DescriptorType::StorageImage, 1},
+             {DescriptorType::UniformTexelBuffer, 1},
+             {DescriptorType::StorageTexelBuffer, 1},
+             {DescriptorType::UniformBuffer, 2},
+             {DescriptorType::StorageBuffer, 2},
+             {DescriptorType::UniformBufferDynamic, 1},
+             {DescriptorType::StorageBufferDynamic, 1},
+             {DescriptorType::InputAttachment, 1}}
+    );
+
+    DescriptorAllocator(DescriptorAllocator &&other) noexcept;
+    DescriptorAllocator(const DescriptorAllocator &other) = delete;
+    ~DescriptorAllocator();
+
+    DescriptorAllocator &operator=(DescriptorAllocator &&other) noexcept;
+    DescriptorAllocator &operator=(const DescriptorAllocator &other) = delete;
+
+    /**
+     *@brief Allocate descriptor set for the current frame
+     *
+     * @param setLayout Layout of the set
+     * @return Descriptor set valid until the current frame is reset, destroying it does nothing
+     */
+    DescriptorSet Allocate(DescriptorSetLayoutHandle setLayout);
+    std::vector<DescriptorSet> Allocate(Span<const DescriptorSetLayoutHandle> setLayouts);
+
+    /**
+     *@brief Move to the next frame and reset all its pools
+     * Sets allocated frameCount frames ago become invalid, so the GPU has to be done with them.
+     */
+    void NextFrame();
+
+    uint32_t GetFrameCount() const;
+    uint32_t GetCurrentFrame() const;
+    uint32_t GetSetsPerPool() const;
+    uint32_t GetPoolCount() const;
+
+  private:
+    struct Pool {
+        DescriptorPoolHandle handle;
+        /**
+         *@brief Value of m_generation the pool was created with, pools from older generations are too small
+         */
+        uint32_t generation;
+    };
+
+    struct Frame {
+        std::vector<Pool> pools;
+        uint32_t setCount = 0;
+        std::vector<DescriptorPoolSize> descriptorCounts;
+    };
+
+    DescriptorAllocator();
+    Pool GetPool();
+    void DestroyPool(const Pool &pool);
+    /**
+     *@brief Raise pool sizes to fit the counts, rounded up to a power of two
+     */
+    void Grow(uint32_t setCount, Span<const DescriptorPoolSize> descriptorCounts);
+
+  private:
+    std::vector<Frame> m_frames;
+    std::vector<Pool> m_freePools;
+    std::vector<DescriptorPoolSize> m_poolSizes;
+    std::vector<DescriptorPoolSize> m_setCounts;
+    uint32_t m_currentFrame;
+    uint32_t m_setsPerPool;
+    uint32_t m_generation;
+};
+} // namespace vg
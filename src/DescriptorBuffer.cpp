@@ -0,0 +1,195 @@
+#include <vulkan/vulkan.hpp>
+#include "DescriptorBuffer.h"
+#include "MemoryManager.h"
+#include "Device.h"
+#include "DeviceFunction.h"
+
+void vkGetDescriptorSetLayoutSizeEXT(VkDevice device, VkDescriptorSetLayout layout, VkDeviceSize *size) {
+    vg::GetDeviceFunction<PFN_vkGetDescriptorSetLayoutSizeEXT, "vkGetDescriptorSetLayoutSizeEXT">()(
+        device, layout, size
+    );
+}
+
+void vkGetDescriptorSetLayoutBindingOffsetEXT(
+    VkDevice device, VkDescriptorSetLayout layout, uint32_t binding, VkDeviceSize *offset
+) {
+    vg::GetDeviceFunction<PFN_vkGetDescriptorSetLayoutBindingOffsetEXT, "vkGetDescriptorSetLayoutBindingOffsetEXT">()(
+        device, layout, binding, offset
+    );
+}
+
+void vkGetDescriptorEXT(VkDevice device, const VkDescriptorGetInfoEXT *info, size_t size, void *descriptor) {
+    vg::GetDeviceFunction<PFN_vkGetDescriptorEXT, "vkGetDescriptorEXT">()(device, info, size, descriptor);
+}
+
+void vkCmdBindDescriptorBuffersEXT(
+    VkCommandBuffer commandBuffer, uint32_t bufferCount, const VkDescriptorBufferBindingInfoEXT *bindingInfos
+) {
+    vg::GetDeviceFunction<PFN_vkCmdBindDescriptorBuffersEXT, "vkCmdBindDescriptorBuffersEXT">()(
+        commandBuffer, bufferCount, bindingInfos
+    );
+}
+
+void vkCmdSetDescriptorBufferOffsetsEXT(
+    VkCommandBuffer commandBuffer, VkPipelineBindPoint bindPoint, VkPipelineLayout layout, uint32_t firstSet,
+    uint32_t setCount, const uint32_t *bufferIndices, const VkDeviceSize *offsets
+) {
+    vg::GetDeviceFunction<PFN_vkCmdSetDescriptorBufferOffsetsEXT, "vkCmdSetDescriptorBufferOffsetsEXT">()(
+        commandBuffer, bindPoint, layout, firstSet, setCount, bufferIndices, offsets
+    );
+}
+
+namespace vg {
+DescriptorBuffer::DescriptorBuffer(uint64_t frameSize, uint32_t frameCount, Flags<BufferUsage> usage)
+    : m_usage(usage), m_frameCount(frameCount), m_currentFrame(0), m_usedSize(0) {
+    assert(currentDevice->IsExtensionEnabled(VK_EXT_DESCRIPTOR_BUFFER_EXTENSION_NAME));
+    assert(frameCount > 0);
+
+    vk::PhysicalDeviceDescriptorBufferPropertiesEXT properties;
+    vk::PhysicalDeviceProperties2 properties2({}, &properties);
+    ((PhysicalDeviceHandle)*currentDevice).getProperties2(&properties2);
+
+    m_alignment = properties.descriptorBufferOffsetAlignment;
+    m_descriptorSizes = {
+        (uint32_t)properties.samplerDescriptorSize,
+        (uint32_t)properties.combinedImageSamplerDescriptorSize,
+        (uint32_t)properties.sampledImageDescriptorSize,
+        (uint32_t)properties.storageImageDescriptorSize,
+        (uint32_t)properties.uniformTexelBufferDescriptorSize,
+        (uint32_t)properties.storageTexelBufferDescriptorSize,
+        (uint32_t)properties.uniformBufferDescriptorSize,
+        (uint32_t)properties.storageBufferDescriptorSize,
+        0,
+        0,
+        (uint32_t)properties.inputAttachmentDescriptorSize,
+    };
+
+    m_frameSize = (frameSize + m_alignment - 1) / m_alignment * m_alignment;
+    m_buffer = Buffer(m_frameSize * frameCount, usage | BufferUsage::ShaderDeviceAddress);
+    vg::Allocate(&m_buffer, {MemoryProperty::HostVisible, MemoryProperty::HostCoherent});
+    m_data = m_buffer.MapMemory();
+    m_address = m_buffer.GetDeviceAddress();
+}
+
+DescriptorBuffer::DescriptorBuffer()
+    : m_data(nullptr), m_address(0), m_frameSize(0), m_frameCount(0), m_currentFrame(0), m_usedSize(0),
+      m_alignment(1), m_descriptorSizes{} {}
+
+DescriptorBuffer::DescriptorBuffer(DescriptorBuffer &&other) noexcept : DescriptorBuffer() { *this = std::move(other); }
+
+DescriptorBuffer::~DescriptorBuffer() {}
+
+DescriptorBuffer &DescriptorBuffer::operator=(DescriptorBuffer &&other) noexcept {
+    if (&other == this) return *this;
+
+    std::swap(m_buffer, other.m_buffer);
+    std::swap(m_data, other.m_data);
+    std::swap(m_address, other.m_address);
+    std::swap(m_usage, other.m_usage);
+    std::swap(m_frameSize, other.m_frameSize);
+    std::swap(m_frameCount, other.m_frameCount);
+    std::swap(m_currentFrame, other.m_currentFrame);
+    std::swap(m_usedSize, other.m_usedSize);
+    std::swap(m_alignment, other.m_alignment);
+    std::swap(m_descriptorSizes, other.m_descriptorSizes);
+
+    return *this;
+}
+
+DescriptorBuffer::Set DescriptorBuffer::Allocate(DescriptorSetLayoutHandle setLayout) {
+    VkDeviceSize size;
+    vkGetDescriptorSetLayoutSizeEXT((DeviceHandle)*currentDevice, setLayout, &size);
+
+    uint64_t offset = (m_usedSize + m_alignment - 1) / m_alignment * m_alignment;
+    if (offset + size > m_frameSize) throw std::runtime_error("Descriptor buffer frame is full");
+    m_usedSize = offset + size;
+
+    offset += m_frameSize * m_currentFrame;
+    return {setLayout, offset, m_data + offset};
+}
+
+void DescriptorBuffer::WriteBuffer(
+    const Set &set, uint32_t binding, DescriptorType descriptorType, const Buffer &buffer, uint64_t offset,
+    uint64_t range, uint32_t arrayElement
+) {
+    assert(
+        descriptorType != DescriptorType::UniformTexelBuffer && descriptorType != DescriptorType::StorageTexelBuffer
+    );
+
+    // Descriptor buffers do not accept VK_WHOLE_SIZE.
+    if (range == ~0ULL) range = buffer.GetSize() - offset;
+
+    vk::DescriptorAddressInfoEXT address(buffer.GetDeviceAddress() + offset, range);
+    Write(set, binding, descriptorType, arrayElement, &address);
+}
+
+void DescriptorBuffer::WriteTexelBuffer(
+    const Set &set, uint32_t binding, DescriptorType descriptorType, const Buffer &buffer, Format format,
+    uint64_t offset, uint64_t range, uint32_t arrayElement
+) {
+    assert(
+        descriptorType == DescriptorType::UniformTexelBuffer || descriptorType == DescriptorType::StorageTexelBuffer
+    );
+    assert(format != Format::Undefined);
+
+    if (range == ~0ULL) range = buffer.GetSize() - offset;
+
+    vk::DescriptorAddressInfoEXT address(buffer.GetDeviceAddress() + offset, range, (vk::Format)format);
+    Write(set, binding, descriptorType, arrayElement, &address);
+}
+
+void DescriptorBuffer::WriteImage(
+    const Set &set, uint32_t binding, DescriptorType descriptorType, const DescriptorImageInfo &image,
+    uint32_t arrayElement
+) {
+    if (descriptorType == DescriptorType::Sampler) Write(set, binding, descriptorType, arrayElement, &image.sampler);
+    else Write(set, binding, descriptorType, arrayElement, &image);
+}
+
+void DescriptorBuffer::NextFrame() {
+    m_currentFrame = (m_currentFrame + 1) % m_frameCount;
+    m_usedSize = 0;
+}
+
+cmd::BindDescriptorBuffers DescriptorBuffer::Bind() const { return cmd::BindDescriptorBuffers({m_address}, {m_usage}); }
+
+cmd::SetDescriptorBufferOffsets DescriptorBuffer::SetOffsets(
+    PipelineLayoutHandle layout, PipelineBindPoint bindPoint, uint32_t firstSet, Span<const Set> sets
+) const {
+    std::vector<uint64_t> offsets(sets.size());
+    for (uint32_t i = 0; i < sets.size(); i++) offsets[i] = sets[i].offset;
+
+    return cmd::SetDescriptorBufferOffsets(
+        layout, bindPoint, firstSet, std::vector<uint32_t>(sets.size(), 0), offsets
+    );
+}
+
+const Buffer &DescriptorBuffer::GetBuffer() const { return m_buffer; }
+
+uint64_t DescriptorBuffer::GetAddress() const { return m_address; }
+
+uint64_t DescriptorBuffer::GetFrameSize() const { return m_frameSize; }
+
+uint64_t DescriptorBuffer::GetUsedSize() const { return m_usedSize; }
+
+void DescriptorBuffer::Write(
+    const Set &set, uint32_t binding, DescriptorType descriptorType, uint32_t arrayElement, const void *info
+) {
+    uint32_t type = (uint32_t)descriptorType;
+    assert(type < m_descriptorSizes.size() && m_descriptorSizes[type] != 0);
+
+    VkDeviceSize bindingOffset;
+    vkGetDescriptorSetLayoutBindingOffsetEXT((DeviceHandle)*currentDevice, set.setLayout, binding, &bindingOffset);
+
+    // Every member of the data union is a pointer, so any of them can carry the info.
+    VkDescriptorGetInfoEXT getInfo{};
+    getInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_GET_INFO_EXT;
+    getInfo.type = (VkDescriptorType)descriptorType;
+    getInfo.data.pSampler = (const VkSampler *)info;
+
+    uint32_t size = m_descriptorSizes[type];
+    vkGetDescriptorEXT(
+        (DeviceHandle)*currentDevice, &getInfo, size, set.data + bindingOffset + (uint64_t)arrayElement * size
+    );
+}
+} // namespace vg
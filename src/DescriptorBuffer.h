@@ -0,0 +1,119 @@
+#pragma once
+#include <array>
+#include <vector>
+#include "Handle.h"
+#include "Structs.h"
+#include "Buffer.h"
+#include "CmdBuffer.h"
+#include "Span.h"
+
+namespace vg {
+/**
+ *@brief Descriptors written straight into a host visible buffer, alternative to \ref DescriptorPool
+ * Sets are suballocated linearly from a per frame region and written with vkGetDescriptorEXT, there are no pools and no
+ * vkUpdateDescriptorSets calls. Needs the device created with VK_EXT_descriptor_buffer and
+ * VK_KHR_buffer_device_address. Set layouts have to be created with DescriptorSetLayoutCreate::DescriptorBuffer,
+ * pipelines created with such layouts are flagged for descriptor buffers automatically.
+ */
+class DescriptorBuffer {
+  public:
+    /**
+     *@brief Set suballocated from the buffer
+     */
+    struct Set {
+        DescriptorSetLayoutHandle setLayout;
+        uint64_t offset;
+        char *data;
+    };
+
+  public:
+    /**
+     *@brief Construct a new Descriptor Buffer object
+     *
+     * @param frameSize Size in bytes available to one frame
+     * @param frameCount Count of frames that can be in flight at once
+     * @param usage Descriptor buffer usages, resource and sampler descriptors can share one buffer
+     */
+    DescriptorBuffer(
+        uint64_t frameSize, uint32_t frameCount = 2,
+        Flags<BufferUsage> usage = {BufferUsage::ResourceDescriptorBuffer, BufferUsage::SamplerDescriptorBuffer}
+    );
+
+    DescriptorBuffer();
+    DescriptorBuffer(DescriptorBuffer &&other) noexcept;
+    DescriptorBuffer(const DescriptorBuffer &other) = delete;
+    ~DescriptorBuffer();
+
+    DescriptorBuffer &operator=(DescriptorBuffer &&other) noexcept;
+    DescriptorBuffer &operator=(const DescriptorBuffer &other) = delete;
+
+    /**
+     *@brief Suballocate set in the current frame
+     *
+     * @param setLayout Layout created for descriptor buffers
+     * @return Set valid until the frame is reused
+     */
+    Set Allocate(DescriptorSetLayoutHandle setLayout);
+
+    /**
+     *@brief Write buffer descriptor, dynamic buffer types are not supported. Texel buffers need a format, they are
+     * written with \ref DescriptorBuffer::WriteTexelBuffer()
+     */
+    void WriteBuffer(
+        const Set &set, uint32_t binding, DescriptorType descriptorType, const Buffer &buffer, uint64_t offset = 0,
+        uint64_t range = ~0ULL, uint32_t arrayElement = 0
+    );
+
+    /**
+     *@brief Write uniform or storage texel buffer descriptor, no buffer view is needed
+     */
+    void WriteTexelBuffer(
+        const Set &set, uint32_t binding, DescriptorType descriptorType, const Buffer &buffer, Format format,
+        uint64_t offset = 0, uint64_t range = ~0ULL, uint32_t arrayElement = 0
+    );
+
+    /**
+     *@brief Write sampler, image or input attachment descriptor
+     */
+    void WriteImage(
+        const Set &set, uint32_t binding, DescriptorType descriptorType, const DescriptorImageInfo &image,
+        uint32_t arrayElement = 0
+    );
+
+    /**
+     *@brief Move to the next frame, its sets become invalid so the GPU has to be done with them
+     */
+    void NextFrame();
+
+    /**
+     *@brief Command binding the buffer, has to be recorded before \ref DescriptorBuffer::SetOffsets()
+     */
+    cmd::BindDescriptorBuffers Bind() const;
+
+    /**
+     *@brief Command pointing consecutive set slots of the layout at the sets
+     */
+    cmd::SetDescriptorBufferOffsets
+    SetOffsets(PipelineLayoutHandle layout, PipelineBindPoint bindPoint, uint32_t firstSet, Span<const Set> sets) const;
+
+    const Buffer &GetBuffer() const;
+    uint64_t GetAddress() const;
+    uint64_t GetFrameSize() const;
+    uint64_t GetUsedSize() const;
+
+  private:
+    void Write(const Set &set, uint32_t binding, DescriptorType descriptorType, uint32_t arrayElement, const void *info);
+
+  private:
+    Buffer m_buffer;
+    char *m_data;
+    uint64_t m_address;
+    Flags<BufferUsage> m_usage;
+    uint64_t m_frameSize;
+    uint32_t m_frameCount;
+    uint32_t m_currentFrame;
+    uint64_t m_usedSize;
+    uint64_t m_alignment;
+    std::array<uint32_t, 11> m_descriptorSizes;
+};
+} // namespace vg
@@ -16,7 +16,7 @@ namespace vg
     DescriptorSet::~DescriptorSet()
     {
         if (!m_handle) return;
-        ((DeviceHandle) *currentDevice).freeDescriptorSets(m_pool, { m_handle });
+        if (m_pool) ((DeviceHandle) *currentDevice).freeDescriptorSets(m_pool, { m_handle });
         m_handle = nullptr;
     }
 
@@ -13,6 +13,12 @@ namespace vg
     {
     public:
         DescriptorSet();
+        /**
+         *@brief Construct a new Descriptor Set object
+         *
+         * @param handle Descriptor set
+         * @param pool Pool to free the set to when destroyed, if nullptr the set is freed with its pool
+         */
         DescriptorSet(DescriptorSetHandle handle, DescriptorPoolHandle pool);
         DescriptorSet(DescriptorSet&& other) noexcept;
         DescriptorSet(const DescriptorSet& other) = delete;
@@ -0,0 +1,42 @@
+#include <vulkan/vulkan.hpp>
+#include "DescriptorUpdateTemplate.h"
+#include "Device.h"
+
+namespace vg {
+DescriptorUpdateTemplate::DescriptorUpdateTemplate(
+    DescriptorSetLayoutHandle setLayout, Span<const DescriptorUpdateTemplateEntry> entries
+) {
+    m_handle = ((DeviceHandle)*currentDevice)
+                   .createDescriptorUpdateTemplate(vk::DescriptorUpdateTemplateCreateInfo(
+                       {}, entries.size(), (const vk::DescriptorUpdateTemplateEntry *)entries.data(),
+                       vk::DescriptorUpdateTemplateType::eDescriptorSet, setLayout
+                   ));
+}
+
+DescriptorUpdateTemplate::DescriptorUpdateTemplate() : m_handle() {}
+
+DescriptorUpdateTemplate::DescriptorUpdateTemplate(DescriptorUpdateTemplate &&other) noexcept
+    : DescriptorUpdateTemplate() {
+    *this = std::move(other);
+}
+
+DescriptorUpdateTemplate::~DescriptorUpdateTemplate() {
+    if (!m_handle) return;
+    ((DeviceHandle)*currentDevice).destroyDescriptorUpdateTemplate(m_handle);
+    m_handle = nullptr;
+}
+
+DescriptorUpdateTemplate &DescriptorUpdateTemplate::operator=(DescriptorUpdateTemplate &&other) noexcept {
+    if (&other == this) return *this;
+
+    std::swap(m_handle, other.m_handle);
+
+    return *this;
+}
+
+DescriptorUpdateTemplate::operator const DescriptorUpdateTemplateHandle &() const { return m_handle; }
+
+void DescriptorUpdateTemplate::Update(DescriptorSetHandle set, const void *data) const {
+    ((DeviceHandle)*currentDevice).updateDescriptorSetWithTemplate(set, m_handle, data);
+}
+} // namespace vg
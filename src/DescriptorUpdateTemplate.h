@@ -0,0 +1,48 @@
+#pragma once
+#include <type_traits>
+#include "Handle.h"
+#include "Structs.h"
+#include "Span.h"
+
+namespace vg {
+/**
+ *@brief Updates a whole descriptor set from a plain struct in one call
+ * Entries describe where in the struct the \ref DescriptorBufferInfo, \ref DescriptorImageInfo or
+ * \ref BufferViewHandle of each binding lives.
+ */
+class DescriptorUpdateTemplate {
+  public:
+    /**
+     *@brief Construct a new Descriptor Update Template object
+     *
+     * @param setLayout Layout of the sets that will be updated
+     * @param entries Bindings to update, offsets and strides are in bytes into the data passed to Update
+     */
+    DescriptorUpdateTemplate(DescriptorSetLayoutHandle setLayout, Span<const DescriptorUpdateTemplateEntry> entries);
+
+    DescriptorUpdateTemplate();
+    DescriptorUpdateTemplate(DescriptorUpdateTemplate &&other) noexcept;
+    DescriptorUpdateTemplate(const DescriptorUpdateTemplate &other) = delete;
+    ~DescriptorUpdateTemplate();
+
+    DescriptorUpdateTemplate &operator=(DescriptorUpdateTemplate &&other) noexcept;
+    DescriptorUpdateTemplate &operator=(const DescriptorUpdateTemplate &other) = delete;
+    operator const DescriptorUpdateTemplateHandle &() const;
+
+    /**
+     *@brief Write all entries of the set
+     *
+     * @param set Set to update, must have the layout the template was created with
+     * @param data Data laid out as described by the entries
+     */
+    void Update(DescriptorSetHandle set, const void *data) const;
+    template <typename T>
+        requires(!std::is_pointer_v<T>)
+    void Update(DescriptorSetHandle set, const T &data) const {
+        Update(set, (const void *)&data);
+    }
+
+  private:
+    DescriptorUpdateTemplateHandle m_handle;
+};
+} // namespace vg
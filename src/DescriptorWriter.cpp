@@ -0,0 +1,106 @@
+#include <vulkan/vulkan.hpp>
+#include "DescriptorWriter.h"
+#include "Device.h"
+
+namespace vg {
+DescriptorWriter::DescriptorWriter() {}
+
+DescriptorWriter &DescriptorWriter::WriteBuffers(
+    DescriptorSetHandle set, uint32_t binding, DescriptorType descriptorType, Span<const DescriptorBufferInfo> buffers,
+    uint32_t arrayElement
+) {
+    AddWrite(set, binding, descriptorType, arrayElement, buffers.size(), InfoType::Buffer, m_bufferInfos.size());
+    m_bufferInfos.insert(m_bufferInfos.end(), buffers.begin(), buffers.end());
+    return *this;
+}
+
+DescriptorWriter &DescriptorWriter::WriteBuffer(
+    DescriptorSetHandle set, uint32_t binding, DescriptorType descriptorType, const Buffer &buffer, uint64_t offset,
+    uint64_t range, uint32_t arrayElement
+) {
+    return WriteBuffers(set, binding, descriptorType, DescriptorBufferInfo(buffer, offset, range), arrayElement);
+}
+
+DescriptorWriter &DescriptorWriter::WriteImages(
+    DescriptorSetHandle set, uint32_t binding, DescriptorType descriptorType, Span<const DescriptorImageInfo> images,
+    uint32_t arrayElement
+) {
+    AddWrite(set, binding, descriptorType, arrayElement, images.size(), InfoType::Image, m_imageInfos.size());
+    m_imageInfos.insert(m_imageInfos.end(), images.begin(), images.end());
+    return *this;
+}
+
+DescriptorWriter &DescriptorWriter::WriteImage(
+    DescriptorSetHandle set, uint32_t binding, DescriptorType descriptorType, ImageLayout layout,
+    const ImageView &imageView, const Sampler &sampler, uint32_t arrayElement
+) {
+    return WriteImages(set, binding, descriptorType, DescriptorImageInfo(sampler, imageView, layout), arrayElement);
+}
+
+DescriptorWriter &DescriptorWriter::WriteTexelBuffers(
+    DescriptorSetHandle set, uint32_t binding, DescriptorType descriptorType, Span<const BufferViewHandle> bufferViews,
+    uint32_t arrayElement
+) {
+    AddWrite(
+        set, binding, descriptorType, arrayElement, bufferViews.size(), InfoType::TexelBuffer,
+        m_texelBufferViews.size()
+    );
+    m_texelBufferViews.insert(m_texelBufferViews.end(), bufferViews.begin(), bufferViews.end());
+    return *this;
+}
+
+void DescriptorWriter::Flush() {
+    if (m_writes.empty()) return;
+
+    // Infos are only stable once all writes are queued, so pointers are resolved here.
+    std::vector<vk::WriteDescriptorSet> writes(m_writes.size());
+    for (uint32_t i = 0; i < m_writes.size(); i++) {
+        const Write &write = m_writes[i];
+        writes[i].dstSet = write.set;
+        writes[i].dstBinding = write.binding;
+        writes[i].dstArrayElement = write.arrayElement;
+        writes[i].descriptorCount = write.count;
+        writes[i].descriptorType = (vk::DescriptorType)write.descriptorType;
+        switch (write.infoType) {
+        case InfoType::Buffer:
+            writes[i].pBufferInfo = (const vk::DescriptorBufferInfo *)&m_bufferInfos[write.infoIndex];
+            break;
+        case InfoType::Image:
+            writes[i].pImageInfo = (const vk::DescriptorImageInfo *)&m_imageInfos[write.infoIndex];
+            break;
+        case InfoType::TexelBuffer:
+            writes[i].pTexelBufferView = (const vk::BufferView *)&m_texelBufferViews[write.infoIndex];
+            break;
+        }
+    }
+
+    ((DeviceHandle)*currentDevice).updateDescriptorSets(writes, {});
+    Clear();
+}
+
+void DescriptorWriter::Clear() {
+    m_writes.clear();
+    m_bufferInfos.clear();
+    m_imageInfos.clear();
+    m_texelBufferViews.clear();
+}
+
+uint32_t DescriptorWriter::GetWriteCount() const { return m_writes.size(); }
+
+void DescriptorWriter::AddWrite(
+    DescriptorSetHandle set, uint32_t binding, DescriptorType descriptorType, uint32_t arrayElement, uint32_t count,
+    InfoType infoType, uint32_t infoIndex
+) {
+    if (!m_writes.empty()) {
+        Write &last = m_writes.back();
+        if (last.set == set && last.binding == binding && last.descriptorType == descriptorType &&
+            last.infoType == infoType && last.arrayElement + last.count == arrayElement &&
+            last.infoIndex + last.count == infoIndex) {
+            last.count += count;
+            return;
+        }
+    }
+
+    m_writes.push_back({set, binding, arrayElement, count, descriptorType, infoType, infoIndex});
+}
+} // namespace vg
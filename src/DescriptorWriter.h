@@ -0,0 +1,106 @@
+#pragma once
+#include <vector>
+#include "Handle.h"
+#include "Structs.h"
+#include "Buffer.h"
+#include "ImageView.h"
+#include "Sampler.h"
+#include "Span.h"
+
+namespace vg {
+/**
+ *@brief Accumulates descriptor writes and submits them in one call
+ * Writes can target any number of sets. Consecutive writes to neighbouring array elements of the same binding are
+ * merged into a single write.
+ */
+class DescriptorWriter {
+  public:
+    DescriptorWriter();
+
+    /**
+     *@brief Queue write of buffer descriptors
+     *
+     * @param set Set to write to
+     * @param binding Binding in the set
+     * @param descriptorType Uniform or storage buffer type, dynamic or not
+     * @param buffers Buffer regions
+     * @param arrayElement First array element to write
+     */
+    DescriptorWriter &WriteBuffers(
+        DescriptorSetHandle set, uint32_t binding, DescriptorType descriptorType,
+        Span<const DescriptorBufferInfo> buffers, uint32_t arrayElement = 0
+    );
+    DescriptorWriter &WriteBuffer(
+        DescriptorSetHandle set, uint32_t binding, DescriptorType descriptorType, const Buffer &buffer,
+        uint64_t offset = 0, uint64_t range = ~0ULL, uint32_t arrayElement = 0
+    );
+
+    /**
+     *@brief Queue write of image and sampler descriptors
+     *
+     * @param set Set to write to
+     * @param binding Binding in the set
+     * @param descriptorType Sampler, image or input attachment type
+     * @param images Images, fields that the type does not use are ignored
+     * @param arrayElement First array element to write
+     */
+    DescriptorWriter &WriteImages(
+        DescriptorSetHandle set, uint32_t binding, DescriptorType descriptorType, Span<const DescriptorImageInfo> images,
+        uint32_t arrayElement = 0
+    );
+    DescriptorWriter &WriteImage(
+        DescriptorSetHandle set, uint32_t binding, DescriptorType descriptorType, ImageLayout layout,
+        const ImageView &imageView, const Sampler &sampler, uint32_t arrayElement = 0
+    );
+
+    /**
+     *@brief Queue write of texel buffer descriptors
+     *
+     * @param set Set to write to
+     * @param binding Binding in the set
+     * @param descriptorType Uniform or storage texel buffer
+     * @param bufferViews Buffer views
+     * @param arrayElement First array element to write
+     */
+    DescriptorWriter &WriteTexelBuffers(
+        DescriptorSetHandle set, uint32_t binding, DescriptorType descriptorType,
+        Span<const BufferViewHandle> bufferViews, uint32_t arrayElement = 0
+    );
+
+    /**
+     *@brief Submit all queued writes with one vkUpdateDescriptorSets call and clear them
+     */
+    void Flush();
+
+    /**
+     *@brief Drop queued writes without submitting them
+     */
+    void Clear();
+
+    uint32_t GetWriteCount() const;
+
+  private:
+    enum class InfoType { Buffer, Image, TexelBuffer };
+
+    struct Write {
+        DescriptorSetHandle set;
+        uint32_t binding;
+        uint32_t arrayElement;
+        uint32_t count;
+        DescriptorType descriptorType;
+        InfoType infoType;
+        uint32_t infoIndex;
+    };
+
+    void AddWrite(
+        DescriptorSetHandle set, uint32_t binding, DescriptorType descriptorType, uint32_t arrayElement, uint32_t count,
+        InfoType infoType, uint32_t infoIndex
+    );
+
+  private:
+    std::vector<Write> m_writes;
+    std::vector<DescriptorBufferInfo> m_bufferInfos;
+    std::vector<DescriptorImageInfo> m_imageInfos;
+    std::vector<BufferViewHandle> m_texelBufferViews;
+};
+} // namespace vg
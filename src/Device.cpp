@@ -3,6 +3,8 @@
 #include <map>
 #include <iostream>
 #include "Device.h"
+#include "LayoutCache.h"
+#include "SamplerCache.h"
 
 namespace vg {
 Device *currentDevice;
@@ -27,9 +29,10 @@ Device::Device(
         int(PhysicalDeviceHandle id, Span<Queue *const> supportedQueues,
             const std::set<std::string> &supportedExtensions, DeviceType type, const DeviceLimits &limits,
             const DeviceFeatures &features)>
-        scoreFunction
+        scoreFunction,
+    const std::set<std::string> &hintedExtensions
 )
-    : m_queues(queues.begin(), queues.end()) {
+    : m_queues(queues.begin(), queues.end()), m_layoutCache(nullptr), m_samplerCache(nullptr) {
     assert(queues.size() > 0);
     bool hasPresentQueueType = false;
     for (auto &&queue : queues) {
@@ -160,19 +163,76 @@ Device::Device(
     for (auto &&[index, priorities] : queueFamilyPriorities)
         queueCreateInfos.push_back(vk::DeviceQueueCreateInfo({}, index, priorities.size(), priorities.data()));
 
+    // Hinted extensions are added as far as the picked device supports them.
+    std::set<std::string> enabledExtensions = extensions;
+    for (const auto &extension : m_physicalDevice.enumerateDeviceExtensionProperties())
+        if (hintedExtensions.contains(extension.extensionName)) enabledExtensions.insert(extension.extensionName);
+
     std::vector<const char *> extensionsConstChar;
-    for (const auto &extension : extensions) extensionsConstChar.push_back(extension.data());
+    for (const auto &extension : enabledExtensions) extensionsConstChar.push_back(extension.data());
 
     auto features_ = m_physicalDevice.getFeatures();
     DeviceFeatures features = *(DeviceFeatures *)&features_;
     features &= hintedDeviceEnabledFeatures;
+    m_enabledFeatures = features;
+
+    // Features of requested extensions are enabled as far as the device supports them.
+    void *extensionFeatures = nullptr;
+    auto chainFeatures = [&](auto &extensionFeature, const char *extension) {
+        if (!enabledExtensions.contains(extension)) return;
+        extensionFeature.pNext = extensionFeatures;
+        extensionFeatures = &extensionFeature;
+    };
+    vk::PhysicalDeviceGraphicsPipelineLibraryFeaturesEXT graphicsPipelineLibraryFeatures;
+    chainFeatures(graphicsPipelineLibraryFeatures, VK_EXT_GRAPHICS_PIPELINE_LIBRARY_EXTENSION_NAME);
+    // Vulkan 1.2 features enable drawIndirectCount, they can't be chained along with the structs they promoted.
+    m_apiVersion = m_physicalDevice.getProperties().apiVersion;
+    bool vulkan12 = m_apiVersion >= VK_API_VERSION_1_2;
+    vk::PhysicalDeviceVulkan12Features vulkan12Features;
+    vk::PhysicalDeviceDescriptorIndexingFeatures descriptorIndexingFeatures;
+    vk::PhysicalDeviceBufferDeviceAddressFeatures bufferDeviceAddressFeatures;
+    if (vulkan12) {
+        vulkan12Features.pNext = extensionFeatures;
+        extensionFeatures = &vulkan12Features;
+    } else {
+        chainFeatures(descriptorIndexingFeatures, VK_EXT_DESCRIPTOR_INDEXING_EXTENSION_NAME);
+        chainFeatures(bufferDeviceAddressFeatures, VK_KHR_BUFFER_DEVICE_ADDRESS_EXTENSION_NAME);
+    }
+    vk::PhysicalDeviceDescriptorBufferFeaturesEXT descriptorBufferFeatures;
+    chainFeatures(descriptorBufferFeatures, VK_EXT_DESCRIPTOR_BUFFER_EXTENSION_NAME);
+    vk::PhysicalDeviceMultiDrawFeaturesEXT multiDrawFeatures;
+    chainFeatures(multiDrawFeatures, VK_EXT_MULTI_DRAW_EXTENSION_NAME);
+    vk::PhysicalDeviceMeshShaderFeaturesEXT meshShaderFeatures;
+    chainFeatures(meshShaderFeatures, VK_EXT_MESH_SHADER_EXTENSION_NAME);
+    vk::PhysicalDevicePresentIdFeaturesKHR presentIdFeatures;
+    chainFeatures(presentIdFeatures, VK_KHR_PRESENT_ID_EXTENSION_NAME);
+    vk::PhysicalDevicePresentWaitFeaturesKHR presentWaitFeatures;
+    chainFeatures(presentWaitFeatures, VK_KHR_PRESENT_WAIT_EXTENSION_NAME);
+
+    vk::PhysicalDeviceFeatures2 features2({}, extensionFeatures);
+    if (extensionFeatures) {
+        vkGetPhysicalDeviceFeatures2(m_physicalDevice, (VkPhysicalDeviceFeatures2 *)&features2);
+        features2.features = *(vk::PhysicalDeviceFeatures *)&features;
+        // These depend on multiview and fragment shading rate features which aren't enabled.
+        meshShaderFeatures.multiviewMeshShader = false;
+        meshShaderFeatures.primitiveFragmentShadingRateMeshShader = false;
+        vulkan12Features.bufferDeviceAddressCaptureReplay = false;
+        vulkan12Features.bufferDeviceAddressMultiDevice = false;
+    }
+    m_drawIndirectCount =
+        vulkan12Features.drawIndirectCount || enabledExtensions.contains(VK_KHR_DRAW_INDIRECT_COUNT_EXTENSION_NAME);
+    m_presentWait = presentIdFeatures.presentId && presentWaitFeatures.presentWait;
 
     vk::DeviceCreateInfo createInfo(
-        vk::DeviceCreateFlags(), queueCreateInfos, nullptr, extensionsConstChar, (vk::PhysicalDeviceFeatures *)&features
+        vk::DeviceCreateFlags(), queueCreateInfos, nullptr, extensionsConstChar,
+        extensionFeatures ? nullptr : (vk::PhysicalDeviceFeatures *)&features, extensionFeatures ? &features2 : nullptr
     );
     m_handle = m_physicalDevice.createDevice(createInfo);
+    m_extensions = enabledExtensions;
 
     SCOPED_DEVICE_CHANGE(this);
+    m_layoutCache = new LayoutCache();
+    m_samplerCache = new SamplerCache(m_physicalDevice.getProperties().limits.maxSamplerAllocationCount);
 
     std::map<unsigned int, unsigned int> queueIndices;
     std::map<unsigned int, std::vector<Queue *>> queuePointers;
@@ -202,7 +262,7 @@ Device::Device(
     }
 }
 
-Device::Device() : m_handle(nullptr), m_physicalDevice(nullptr), m_queues{} {}
+Device::Device() : m_handle(nullptr), m_physicalDevice(nullptr), m_queues{}, m_apiVersion(0), m_drawIndirectCount(false), m_presentWait(false), m_layoutCache(nullptr), m_samplerCache(nullptr) {}
 
 Device::Device(Device &&other) noexcept : Device() { *this = std::move(other); }
 
@@ -210,6 +270,10 @@ Device::~Device() {
     if (m_handle == nullptr) return;
 
     SCOPED_DEVICE_CHANGE(this);
+    delete m_layoutCache;
+    delete m_samplerCache;
+    m_layoutCache = nullptr;
+    m_samplerCache = nullptr;
     for (auto &&queue : m_queues) {
         ((DeviceHandle)*currentDevice).destroyCommandPool(queue->m_commandPool);
         ((DeviceHandle)*currentDevice).destroyCommandPool(queue->m_transientCommandPool);
@@ -227,6 +291,13 @@ Device &Device::operator=(Device &&other) noexcept {
     std::swap(m_handle, other.m_handle);
     std::swap(m_physicalDevice, other.m_physicalDevice);
     std::swap(m_queues, other.m_queues);
+    std::swap(m_extensions, other.m_extensions);
+    std::swap(m_enabledFeatures, other.m_enabledFeatures);
+    std::swap(m_apiVersion, other.m_apiVersion);
+    std::swap(m_drawIndirectCount, other.m_drawIndirectCount);
+    std::swap(m_presentWait, other.m_presentWait);
+    std::swap(m_layoutCache, other.m_layoutCache);
+    std::swap(m_samplerCache, other.m_samplerCache);
 
     return *this;
 }
@@ -245,6 +316,8 @@ std::set<std::string> Device::GetExtensions() const {
     return supportedExtensions;
 }
 
+bool Device::IsExtensionEnabled(const std::string &extension) const { return m_extensions.contains(extension); }
+
 DeviceLimits Device::GetLimits() const { return GetProperties().limits; }
 
 DeviceProperties Device::GetProperties() const {
@@ -257,10 +330,22 @@ DeviceFeatures Device::GetFeatures() const {
     return *(DeviceFeatures *)&features;
 }
 
+const DeviceFeatures &Device::GetEnabledFeatures() const { return m_enabledFeatures; }
+
+uint32_t Device::GetApiVersion() const { return m_apiVersion; }
+
+bool Device::IsDrawIndirectCountEnabled() const { return m_drawIndirectCount; }
+
+bool Device::IsPresentWaitEnabled() const { return m_presentWait; }
+
 FormatProperties Device::GetFormatProperties(Format format) const {
     auto properties = m_physicalDevice.getFormatProperties((vk::Format)format);
     return *(FormatProperties *)&properties;
 }
 
 const Queue &Device::GetQueue(uint32_t queueIndex) const { return *m_queues[queueIndex]; }
+
+LayoutCache &Device::GetLayoutCache() { return *m_layoutCache; }
+
+SamplerCache &Device::GetSamplerCache() { return *m_samplerCache; }
 } // namespace vg
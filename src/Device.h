@@ -9,6 +9,9 @@
 
 namespace vg
 {
+    class LayoutCache;
+    class SamplerCache;
+
     /**
      *@brief Represents GPU device
      * Handles both physical and logical device
@@ -24,13 +27,15 @@ namespace vg
          * @param hintedDeviceEnabledFeatures Features to be enabled if available, by default all
          * @param surface Surface when device is used to render to a window
          * @param scoreFunction Function for scroing each device, function should return score or -1 if device is not an option
+         * @param hintedExtensions Extensions to be enabled if the picked device supports them
          */
         Device(
             Span<Queue* const> queues,
             const std::set<std::string>& extensions = {},
             const DeviceFeatures& hintedDeviceEnabledFeatures = {},
             SurfaceHandle surface = {},
-            std::function<int(PhysicalDeviceHandle id, Span<Queue* const> supportedQueues, const std::set<std::string>& supportedExtensions, DeviceType type, const DeviceLimits& limits, const DeviceFeatures& features)> scoreFunction = nullptr);
+            std::function<int(PhysicalDeviceHandle id, Span<Queue* const> supportedQueues, const std::set<std::string>& supportedExtensions, DeviceType type, const DeviceLimits& limits, const DeviceFeatures& features)> scoreFunction = nullptr,
+            const std::set<std::string>& hintedExtensions = {});
         /**
          *@brief Construct a new Device object
          *
@@ -65,17 +70,54 @@ namespace vg
         void WaitUntilIdle();
 
         std::set<std::string> GetExtensions() const;
+        /**
+         *@brief Check if extension was enabled when creating the device, either required or hinted and supported
+         */
+        bool IsExtensionEnabled(const std::string& extension) const;
         DeviceLimits GetLimits() const;
         DeviceProperties GetProperties() const;
         DeviceFeatures GetFeatures() const;
+        /**
+         *@brief Get features the device was created with, subset of \ref Device::GetFeatures()
+         */
+        const DeviceFeatures& GetEnabledFeatures() const;
+        /**
+         *@brief Get Vulkan version supported by the physical device, core functions of newer versions are missing
+         */
+        uint32_t GetApiVersion() const;
+        /**
+         *@brief Check if indirect draws with a count buffer can be recorded, needs Vulkan 1.2 support or
+         * VK_KHR_draw_indirect_count
+         */
+        bool IsDrawIndirectCountEnabled() const;
+        /**
+         *@brief Check if presentId and presentWait features are enabled, requesting VK_KHR_present_id and
+         * VK_KHR_present_wait alone doesn't enable them
+         */
+        bool IsPresentWaitEnabled() const;
         FormatProperties GetFormatProperties(Format format) const;
         const Queue& GetQueue(uint32_t queueIndex) const;
+        /**
+         *@brief Cache of descriptor set and pipeline layouts shared by everything created on this device
+         */
+        LayoutCache& GetLayoutCache();
+        /**
+         *@brief Cache of samplers shared by everything created on this device
+         */
+        SamplerCache& GetSamplerCache();
 
 
     private:
         DeviceHandle m_handle;
         PhysicalDeviceHandle m_physicalDevice;
         std::vector<Queue*> m_queues;
+        std::set<std::string> m_extensions;
+        DeviceFeatures m_enabledFeatures;
+        uint32_t m_apiVersion;
+        bool m_drawIndirectCount;
+        bool m_presentWait;
+        LayoutCache* m_layoutCache;
+        SamplerCache* m_samplerCache;
     };
 
     extern Device* currentDevice;
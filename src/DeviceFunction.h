@@ -0,0 +1,32 @@
+#pragma once
+#include <algorithm>
+#include <vulkan/vulkan.hpp>
+#include "Device.h"
+
+namespace vg {
+/**
+ *@brief Name of a device function usable as a template argument, so each function gets its own cache
+ */
+template <size_t N> struct DeviceFunctionName {
+    constexpr DeviceFunctionName(const char (&name)[N]) { std::copy_n(name, N, value); }
+    char value[N];
+};
+
+/**
+ *@brief Get entry point of a device extension function for the current device
+ * The loader does not export extension functions, so they are resolved on first use and cached per thread. Every
+ * function has its own cache, so the lookup doesn't allocate or hash and is cheap enough for per draw commands.
+ * Only meant to be included from source files.
+ */
+template <typename T, DeviceFunctionName name> T GetDeviceFunction() {
+    thread_local VkDevice device = VK_NULL_HANDLE;
+    thread_local T function = nullptr;
+
+    VkDevice current = (DeviceHandle)*currentDevice;
+    if (device != current) {
+        function = (T)vkGetDeviceProcAddr(current, name.value);
+        device = current;
+    }
+    return function;
+}
+} // namespace vg
@@ -0,0 +1,153 @@
+#include <vulkan/vulkan.hpp>
+#include "DrawBatcher.h"
+#include "Device.h"
+#include "MemoryManager.h"
+
+namespace vg {
+DrawBatcher::DrawBatcher(Mode mode, uint32_t maxDrawsPerFrame, uint32_t frameCount)
+    : m_mode(mode), m_maxDrawsPerFrame(maxDrawsPerFrame), m_maxMultiDrawCount(0), m_currentFrame(0),
+      m_cmdBuffer(nullptr) {
+    assert(frameCount > 0);
+
+    if (mode == Mode::MultiDraw) {
+        assert(currentDevice->IsExtensionEnabled(VK_EXT_MULTI_DRAW_EXTENSION_NAME));
+
+        vk::PhysicalDeviceMultiDrawPropertiesEXT properties;
+        vk::PhysicalDeviceProperties2 properties2({}, &properties);
+        ((PhysicalDeviceHandle)*currentDevice).getProperties2(&properties2);
+        m_maxMultiDrawCount = properties.maxMultiDrawCount;
+    }
+
+    if (mode == Mode::Indirect) {
+        assert(maxDrawsPerFrame > 0);
+
+        m_frames.resize(frameCount);
+        std::vector<Buffer *> buffers(frameCount);
+        for (uint32_t i = 0; i < frameCount; i++) {
+            m_frames[i].indirect =
+                Buffer(maxDrawsPerFrame * sizeof(DrawIndexedIndirectCommand), {BufferUsage::IndirectBuffer});
+            buffers[i] = &m_frames[i].indirect;
+        }
+        vg::Allocate(buffers, {MemoryProperty::HostVisible, MemoryProperty::HostCoherent});
+
+        for (auto &&frame : m_frames) frame.commands = (DrawIndexedIndirectCommand *)frame.indirect.MapMemory();
+    }
+}
+
+DrawBatcher::DrawBatcher()
+    : m_mode(Mode::Loop), m_maxDrawsPerFrame(0), m_maxMultiDrawCount(0), m_currentFrame(0), m_cmdBuffer(nullptr) {}
+
+DrawBatcher::DrawBatcher(DrawBatcher &&other) noexcept : DrawBatcher() { *this = std::move(other); }
+
+DrawBatcher &DrawBatcher::operator=(DrawBatcher &&other) noexcept {
+    if (&other == this) return *this;
+
+    std::swap(m_mode, other.m_mode);
+    std::swap(m_maxDrawsPerFrame, other.m_maxDrawsPerFrame);
+    std::swap(m_maxMultiDrawCount, other.m_maxMultiDrawCount);
+    std::swap(m_frames, other.m_frames);
+    std::swap(m_currentFrame, other.m_currentFrame);
+    std::swap(m_cmdBuffer, other.m_cmdBuffer);
+    std::swap(m_pending, other.m_pending);
+    std::swap(m_stats, other.m_stats);
+    std::swap(m_lastStats, other.m_lastStats);
+
+    return *this;
+}
+
+DrawBatcher &DrawBatcher::Begin(CmdBuffer &cmdBuffer) {
+    assert(!m_cmdBuffer);
+    m_cmdBuffer = &cmdBuffer;
+    return *this;
+}
+
+DrawBatcher &DrawBatcher::Flush() {
+    if (m_pending.empty()) return *this;
+
+    uint32_t drawCount = m_pending.size();
+    m_stats.drawCount += drawCount;
+
+    if (drawCount == 1 || m_mode == Mode::Loop) {
+        for (auto &&draw : m_pending) m_cmdBuffer->Append(draw);
+        m_stats.callCount += drawCount;
+    } else if (m_mode == Mode::MultiDraw) {
+        std::vector<MultiDrawIndexedInfo> indexInfo(drawCount);
+        for (uint32_t i = 0; i < drawCount; i++)
+            indexInfo[i] =
+                MultiDrawIndexedInfo(m_pending[i].indexCount, m_pending[i].firstIndex, m_pending[i].vertexOffset);
+
+        m_cmdBuffer->Append(
+            cmd::DrawMultiIndexed(std::move(indexInfo), m_pending[0].instanceCount, m_pending[0].firstInstance)
+        );
+        m_stats.callCount++;
+    } else {
+        // Whatever does not fit into this frame's indirect buffer is drawn one by one.
+        Frame &frame = m_frames[m_currentFrame];
+        uint32_t indirectCount = std::min(drawCount, m_maxDrawsPerFrame - frame.usedCount);
+        if (indirectCount == 1) indirectCount = 0;
+
+        for (uint32_t i = 0; i < indirectCount; i++) {
+            const cmd::DrawIndexed &draw = m_pending[i];
+            frame.commands[frame.usedCount + i] = DrawIndexedIndirectCommand(
+                draw.indexCount, draw.instanceCount, draw.firstIndex, draw.vertexOffset, draw.firstInstance
+            );
+        }
+        if (indirectCount > 0) {
+            m_cmdBuffer->Append(cmd::DrawIndexedIndirect(
+                frame.indirect, frame.usedCount * sizeof(DrawIndexedIndirectCommand), indirectCount,
+                sizeof(DrawIndexedIndirectCommand)
+            ));
+            frame.usedCount += indirectCount;
+            m_stats.callCount++;
+        }
+
+        for (uint32_t i = indirectCount; i < drawCount; i++) m_cmdBuffer->Append(m_pending[i]);
+        m_stats.callCount += drawCount - indirectCount;
+    }
+
+    m_pending.clear();
+    return *this;
+}
+
+void DrawBatcher::End() {
+    Flush();
+    m_cmdBuffer = nullptr;
+}
+
+void DrawBatcher::NextFrame() {
+    assert(!m_cmdBuffer);
+
+    m_lastStats = m_stats;
+    m_stats = Stats();
+
+    if (m_frames.empty()) return;
+    m_currentFrame = (m_currentFrame + 1) % m_frames.size();
+    m_frames[m_currentFrame].usedCount = 0;
+}
+
+DrawBatcher::Mode DrawBatcher::GetMode() const { return m_mode; }
+
+const DrawBatcher::Stats &DrawBatcher::GetStats() const { return m_lastStats; }
+
+const DrawBatcher::Stats &DrawBatcher::GetCurrentStats() const { return m_stats; }
+
+DrawBatcher::Mode DrawBatcher::GetBestMode() {
+    if (currentDevice->IsExtensionEnabled(VK_EXT_MULTI_DRAW_EXTENSION_NAME)) return Mode::MultiDraw;
+
+    const DeviceFeatures &features = currentDevice->GetEnabledFeatures();
+    if (features.multiDrawIndirect && features.drawIndirectFirstInstance) return Mode::Indirect;
+
+    return Mode::Loop;
+}
+
+void DrawBatcher::Add(const cmd::DrawIndexed &draw) {
+    if (m_mode == Mode::MultiDraw && !m_pending.empty()) {
+        const cmd::DrawIndexed &first = m_pending.front();
+        if (first.instanceCount != draw.instanceCount || first.firstInstance != draw.firstInstance ||
+            m_pending.size() == m_maxMultiDrawCount)
+            Flush();
+    }
+
+    m_pending.push_back(draw);
+}
+} // namespace vg
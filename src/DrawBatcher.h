@@ -0,0 +1,144 @@
+#pragma once
+#include <cassert>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+#include "Handle.h"
+#include "Buffer.h"
+#include "CmdBuffer.h"
+#include "Structs.h"
+
+namespace vg {
+/**
+ *@brief Merges runs of compatible indexed draws into fewer draw calls
+ * Commands are appended through the batcher instead of the command buffer. Consecutive \ref cmd::DrawIndexed are
+ * collected and any other command flushes them first, so state changes split batches exactly where they have to.
+ * Collected draws are emitted as one multi draw, one indirect draw from a generated buffer or a plain loop of draws,
+ * depending on what the device supports.
+ */
+class DrawBatcher {
+  public:
+    enum class Mode {
+        /**
+         *@brief vkCmdDrawMultiIndexedEXT, draws in a batch share instanceCount and firstInstance
+         */
+        MultiDraw,
+        /**
+         *@brief Draws are written to a host visible buffer and issued with one vkCmdDrawIndexedIndirect
+         */
+        Indirect,
+        /**
+         *@brief One vkCmdDrawIndexed per draw
+         */
+        Loop
+    };
+
+    struct Stats {
+        uint32_t drawCount = 0;
+        uint32_t callCount = 0;
+
+        /**
+         *@brief Count of draw calls saved by merging
+         */
+        uint32_t GetMergedCount() const { return drawCount - callCount; }
+    };
+
+  public:
+    /**
+     *@brief Construct a new Draw Batcher object
+     *
+     * @param mode How batches are emitted, \ref DrawBatcher::GetBestMode() picks the best the device has enabled
+     * @param maxDrawsPerFrame Capacity of the indirect buffer of each frame, draws past it fall back to a loop
+     * @param frameCount Count of frames in flight, indirect buffers are reused after that many \ref NextFrame() calls
+     */
+    DrawBatcher(Mode mode, uint32_t maxDrawsPerFrame = 16384, uint32_t frameCount = 2);
+
+    DrawBatcher();
+    DrawBatcher(DrawBatcher &&other) noexcept;
+    DrawBatcher(const DrawBatcher &other) = delete;
+    ~DrawBatcher() = default;
+
+    DrawBatcher &operator=(DrawBatcher &&other) noexcept;
+    DrawBatcher &operator=(const DrawBatcher &other) = delete;
+
+    /**
+     *@brief Start batching into the command buffer, has to be between \ref CmdBuffer::Begin() and \ref CmdBuffer::End()
+     */
+    DrawBatcher &Begin(CmdBuffer &cmdBuffer);
+
+    /**
+     *@brief Append commands, draws are deferred and everything else is recorded right after pending draws
+     */
+    template <Commands... T> DrawBatcher &Append(const T &...commands) {
+        assert(m_cmdBuffer);
+        (..., _Append(commands));
+        return *this;
+    }
+
+    /**
+     *@brief Record pending draws
+     */
+    DrawBatcher &Flush();
+
+    /**
+     *@brief Record pending draws and stop batching into the command buffer
+     */
+    void End();
+
+    /**
+     *@brief Move to the next frame's indirect buffer and restart frame statistics
+     */
+    void NextFrame();
+
+    Mode GetMode() const;
+    /**
+     *@brief Statistics of the last finished frame
+     */
+    const Stats &GetStats() const;
+    /**
+     *@brief Statistics of the frame being recorded
+     */
+    const Stats &GetCurrentStats() const;
+
+    /**
+     *@brief Best mode enabled on the current device
+     * VK_EXT_multi_draw is preferred, then multiDrawIndirect with drawIndirectFirstInstance, then a loop.
+     */
+    static Mode GetBestMode();
+
+  private:
+    template <Command... T> void _Append(const std::tuple<T...> &commandTuple) {
+        std::apply([this](const T &...args) { (..., _Append(args)); }, commandTuple);
+    }
+
+    template <Command T> void _Append(const T &command) {
+        if constexpr (std::is_same_v<T, cmd::DrawIndexed>) {
+            Add(command);
+        } else {
+            Flush();
+            m_cmdBuffer->Append(command);
+        }
+    }
+
+    void Add(const cmd::DrawIndexed &draw);
+
+  private:
+    struct Frame {
+        Buffer indirect;
+        DrawIndexedIndirectCommand *commands = nullptr;
+        uint32_t usedCount = 0;
+    };
+
+    Mode m_mode;
+    uint32_t m_maxDrawsPerFrame;
+    uint32_t m_maxMultiDrawCount;
+    std::vector<Frame> m_frames;
+    uint32_t m_currentFrame;
+
+    CmdBuffer *m_cmdBuffer;
+    std::vector<cmd::DrawIndexed> m_pending;
+
+    Stats m_stats;
+    Stats m_lastStats;
+};
+} // namespace vg
@@ -1057,6 +1057,22 @@ namespace vg
         Mutable = 1000351000,
     };
 
+    enum class DescriptorSetLayoutCreate
+    {
+        PushDescriptor = 0x00000001,
+        UpdateAfterBindPool = 0x00000002,
+        DescriptorBuffer = 0x00000010,
+        EmbeddedImmutableSamplers = 0x00000020,
+    };
+
+    enum class DescriptorBinding
+    {
+        UpdateAfterBind = 0x00000001,
+        UpdateUnusedWhilePending = 0x00000002,
+        PartiallyBound = 0x00000004,
+        VariableDescriptorCount = 0x00000008,
+    };
+
     enum class InputRate
     {
         Vertex = 0,
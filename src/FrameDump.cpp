@@ -0,0 +1,119 @@
+#include "FrameDump.h"
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+#include "MemoryManager.h"
+
+namespace vg {
+FrameDump::FrameDump(const Presenter &presenter, std::string pathPrefix, uint32_t interval)
+    : m_presenter(&presenter), m_pathPrefix(std::move(pathPrefix)), m_interval(interval),
+      m_slots(presenter.GetFrameCount()), m_frameNumber(0), m_writtenCount(0) {
+    assert(interval > 0);
+
+    Format format = presenter.GetSurface().GetFormat();
+    if (format == Format::BGRA8UNORM || format == Format::BGRA8SRGB) m_bgra = true;
+    else if (format == Format::RGBA8UNORM || format == Format::RGBA8SRGB) m_bgra = false;
+    else throw std::runtime_error("Frame dumps need an 8 bit RGBA or BGRA surface format");
+}
+
+FrameDump::FrameDump() : m_presenter(nullptr), m_interval(1), m_bgra(false), m_frameNumber(0), m_writtenCount(0) {}
+
+FrameDump::FrameDump(FrameDump &&other) noexcept : FrameDump() { *this = std::move(other); }
+
+FrameDump &FrameDump::operator=(FrameDump &&other) noexcept {
+    if (&other == this) return *this;
+
+    std::swap(m_presenter, other.m_presenter);
+    std::swap(m_pathPrefix, other.m_pathPrefix);
+    std::swap(m_interval, other.m_interval);
+    std::swap(m_bgra, other.m_bgra);
+    std::swap(m_slots, other.m_slots);
+    std::swap(m_frameNumber, other.m_frameNumber);
+    std::swap(m_writtenCount, other.m_writtenCount);
+
+    return *this;
+}
+
+void FrameDump::Record(CmdBuffer &cmdBuffer) {
+    // The presenter waited for the slot's previous frame when acquiring, so its copy has arrived.
+    Slot &slot = m_slots[m_presenter->GetFrameIndex()];
+    if (slot.pending) Write(slot);
+
+    uint64_t frameNumber = m_frameNumber++;
+    if (frameNumber % m_interval != 0) return;
+
+    const Swapchain &swapchain = m_presenter->GetSwapchain();
+    uint64_t size = (uint64_t)swapchain.GetWidth() * swapchain.GetHeight() * 4;
+    if (slot.staging.GetSize() != size) {
+        slot.staging = Buffer(size, {BufferUsage::TransferDst});
+        // Host cached memory makes CPU reads fast, fall back to coherent memory if device has none.
+        try {
+            vg::Allocate({&slot.staging}, {MemoryProperty::HostVisible, MemoryProperty::HostCached});
+        } catch (const std::runtime_error &) {
+            vg::Allocate({&slot.staging}, {MemoryProperty::HostVisible, MemoryProperty::HostCoherent});
+        }
+    }
+    slot.width = swapchain.GetWidth();
+    slot.height = swapchain.GetHeight();
+    slot.frameNumber = frameNumber;
+    slot.pending = true;
+
+    ImageHandle image = swapchain.GetImages()[m_presenter->GetImageIndex()];
+    cmdBuffer.Append(
+        cmd::PipelineBarier(
+            {PipelineStage::ColorAttachmentOutput, PipelineStage::Transfer}, PipelineStage::Transfer,
+            std::vector<ImageMemoryBarrier>{ImageMemoryBarrier(
+                image, ImageLayout::PresentSrc, ImageLayout::TransferSrcOptimal,
+                {Access::ColorAttachmentWrite, Access::TransferWrite}, Access::TransferRead, ImageAspect::Color
+            )}
+        ),
+        cmd::CopyImageToBuffer(
+            image, ImageLayout::TransferSrcOptimal, slot.staging,
+            {BufferImageCopy(
+                0, 0, 0, ImageSubresourceLayers(ImageAspect::Color), Point2D<uint32_t>{slot.width, slot.height}
+            )}
+        ),
+        cmd::PipelineBarier(
+            PipelineStage::Transfer, {PipelineStage::BottomOfPipe, PipelineStage::Host},
+            std::vector<BufferMemoryBarrier>{
+                BufferMemoryBarrier(Access::TransferWrite, Access::HostRead, slot.staging, 0, size)},
+            std::vector<ImageMemoryBarrier>{ImageMemoryBarrier(
+                image, ImageLayout::TransferSrcOptimal, ImageLayout::PresentSrc, Access::TransferRead, {},
+                ImageAspect::Color
+            )}
+        )
+    );
+}
+
+void FrameDump::Flush() {
+    for (auto &&slot : m_slots)
+        if (slot.pending) Write(slot);
+}
+
+uint32_t FrameDump::GetWrittenCount() const { return m_writtenCount; }
+
+void FrameDump::Write(Slot &slot) {
+    slot.pending = false;
+    slot.staging.InvalidateMemory();
+    const char *pixels = slot.staging.MapMemory();
+
+    std::ostringstream path;
+    path << m_pathPrefix << std::setw(6) << std::setfill('0') << slot.frameNumber << ".ppm";
+    std::ofstream file(path.str(), std::ios::binary);
+    if (!file) throw std::runtime_error("Failed to open " + path.str());
+
+    file << "P6\n" << slot.width << ' ' << slot.height << "\n255\n";
+    std::vector<char> row(slot.width * 3);
+    for (uint32_t y = 0; y < slot.height; y++) {
+        const char *src = pixels + (size_t)y * slot.width * 4;
+        for (uint32_t x = 0; x < slot.width; x++) {
+            row[x * 3 + 0] = src[x * 4 + (m_bgra ? 2 : 0)];
+            row[x * 3 + 1] = src[x * 4 + 1];
+            row[x * 3 + 2] = src[x * 4 + (m_bgra ? 0 : 2)];
+        }
+        file.write(row.data(), row.size());
+    }
+    m_writtenCount++;
+}
+} // namespace vg
@@ -0,0 +1,71 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "Buffer.h"
+#include "CmdBuffer.h"
+#include "Presenter.h"
+
+namespace vg {
+/**
+ *@brief Writes presented frames of a \ref Presenter to disk as binary PPM images, e.g. for checking headless runs
+ * Copies are recorded into the frame's command buffer and written once the frame's slot is acquired again, so dumping
+ * never stalls the GPU. Swapchain images need Usage::TransferSrc and an 8 bit RGBA or BGRA format.
+ */
+class FrameDump {
+  public:
+    /**
+     *@brief Construct a new Frame Dump object
+     *
+     * @param presenter Presenter whose images are dumped, has to outlive the dump
+     * @param pathPrefix Files are named pathPrefix followed by the six digit frame number and .ppm
+     * @param interval Every interval-th frame is dumped, starting with the first
+     */
+    FrameDump(const Presenter &presenter, std::string pathPrefix, uint32_t interval = 1);
+
+    FrameDump();
+    FrameDump(FrameDump &&other) noexcept;
+    FrameDump(const FrameDump &other) = delete;
+    ~FrameDump() = default;
+
+    FrameDump &operator=(FrameDump &&other) noexcept;
+    FrameDump &operator=(const FrameDump &other) = delete;
+
+    /**
+     *@brief Record a copy of the acquired image if the frame is dumped, call after rendering and before
+     * \ref Presenter::Submit(), the image has to be in ImageLayout::PresentSrc
+     */
+    void Record(CmdBuffer &cmdBuffer);
+
+    /**
+     *@brief Write all recorded frames, the GPU has to be done with them, e.g. after \ref Presenter::WaitIdle()
+     */
+    void Flush();
+
+    /**
+     *@brief Count of frames written to disk
+     */
+    uint32_t GetWrittenCount() const;
+
+  private:
+    struct Slot {
+        Buffer staging;
+        uint32_t width = 0;
+        uint32_t height = 0;
+        uint64_t frameNumber = 0;
+        bool pending = false;
+    };
+
+    void Write(Slot &slot);
+
+  private:
+    const Presenter *m_presenter;
+    std::string m_pathPrefix;
+    uint32_t m_interval;
+    bool m_bgra;
+
+    std::vector<Slot> m_slots;
+    uint64_t m_frameNumber;
+    uint32_t m_writtenCount;
+};
+} // namespace vg
@@ -0,0 +1,142 @@
+#include <vulkan/vulkan.hpp>
+#include "GpuCulling.h"
+#include "DescriptorWriter.h"
+#include "Device.h"
+#include "MemoryManager.h"
+#include "Shader.h"
+#include <cmath>
+
+namespace vg {
+Frustum Frustum::FromMatrix(const float *m) {
+    // Gribb-Hartmann, rows of the matrix are m[i], m[4 + i], m[8 + i], m[12 + i].
+    auto row = [m](int i, float out[4]) {
+        for (int j = 0; j < 4; j++) out[j] = m[j * 4 + i];
+    };
+    float r0[4], r1[4], r2[4], r3[4];
+    row(0, r0);
+    row(1, r1);
+    row(2, r2);
+    row(3, r3);
+
+    Frustum frustum;
+    for (int j = 0; j < 4; j++) {
+        frustum.planes[0][j] = r3[j] + r0[j];
+        frustum.planes[1][j] = r3[j] - r0[j];
+        frustum.planes[2][j] = r3[j] + r1[j];
+        frustum.planes[3][j] = r3[j] - r1[j];
+        frustum.planes[4][j] = r2[j];
+        frustum.planes[5][j] = r3[j] - r2[j];
+    }
+
+    // Normalize so distances to the planes can be compared against sphere radii.
+    for (auto &&plane : frustum.planes) {
+        float length = std::sqrt(plane[0] * plane[0] + plane[1] * plane[1] + plane[2] * plane[2]);
+        for (int j = 0; j < 4; j++) plane[j] /= length;
+    }
+
+    return frustum;
+}
+
+// SPIR-V of shaders/cull.comp compiled with the library, so it doesn't depend on files next to the executable.
+static const uint32_t cullShaderCode[] = {
+#include "cull.comp.inc"
+};
+
+struct CullPushConstants {
+    Frustum frustum;
+    uint32_t instanceCount;
+};
+
+GpuCulling::GpuCulling(const Buffer &instances, uint32_t maxInstances, const char *shaderPath)
+    : m_maxInstances(maxInstances) {
+    assert(maxInstances > 0);
+
+    Shader shader;
+    if (shaderPath) shader = Shader(ShaderStage::Compute, shaderPath);
+    else shader = Shader(ShaderStage::Compute, cullShaderCode);
+    m_pipeline = ComputePipeline(
+        shader,
+        PipelineLayout(
+            {{DescriptorSetLayoutBinding(0, DescriptorType::StorageBuffer, 1, ShaderStage::Compute),
+              DescriptorSetLayoutBinding(1, DescriptorType::StorageBuffer, 1, ShaderStage::Compute),
+              DescriptorSetLayoutBinding(2, DescriptorType::StorageBuffer, 1, ShaderStage::Compute)}},
+            {PushConstantRange({ShaderStage::Compute}, 0, sizeof(CullPushConstants))}
+        )
+    );
+
+    m_draws = Buffer(
+        maxInstances * sizeof(DrawIndexedIndirectCommand), {BufferUsage::StorageBuffer, BufferUsage::IndirectBuffer}
+    );
+    m_count = Buffer(
+        sizeof(uint32_t), {BufferUsage::StorageBuffer, BufferUsage::IndirectBuffer, BufferUsage::TransferDst}
+    );
+    vg::Allocate({&m_draws, &m_count}, {MemoryProperty::DeviceLocal});
+
+    m_descriptorPool = DescriptorPool(1, {{DescriptorType::StorageBuffer, 3}});
+    m_descriptorPool.Allocate(m_pipeline.GetDescriptorSets()[0], &m_descriptorSet);
+
+    DescriptorWriter()
+        .WriteBuffer(m_descriptorSet, 0, DescriptorType::StorageBuffer, instances)
+        .WriteBuffer(m_descriptorSet, 1, DescriptorType::StorageBuffer, m_draws)
+        .WriteBuffer(m_descriptorSet, 2, DescriptorType::StorageBuffer, m_count)
+        .Flush();
+}
+
+GpuCulling::GpuCulling() : m_maxInstances(0) {}
+
+GpuCulling::GpuCulling(GpuCulling &&other) noexcept : GpuCulling() { *this = std::move(other); }
+
+GpuCulling &GpuCulling::operator=(GpuCulling &&other) noexcept {
+    if (&other == this) return *this;
+
+    std::swap(m_pipeline, other.m_pipeline);
+    std::swap(m_descriptorPool, other.m_descriptorPool);
+    std::swap(m_descriptorSet, other.m_descriptorSet);
+    std::swap(m_draws, other.m_draws);
+    std::swap(m_count, other.m_count);
+    std::swap(m_maxInstances, other.m_maxInstances);
+
+    return *this;
+}
+
+GpuCulling::CullCommands GpuCulling::Cull(const Frustum &frustum, uint32_t instanceCount) const {
+    assert(instanceCount <= m_maxInstances);
+
+    CullPushConstants pushConstants{frustum, instanceCount};
+    return {
+        // Previous draws from the buffers have to finish before they are overwritten.
+        cmd::PipelineBarier(
+            PipelineStage::DrawIndirect, {PipelineStage::Transfer, PipelineStage::ComputeShader},
+            std::vector<MemoryBarrier>{}
+        ),
+        cmd::FillBuffer(m_count, 0, sizeof(uint32_t), 0),
+        cmd::PipelineBarier(
+            PipelineStage::Transfer, PipelineStage::ComputeShader,
+            std::vector<MemoryBarrier>{
+                MemoryBarrier(Access::TransferWrite, {Access::ShaderRead, Access::ShaderWrite})}
+        ),
+        cmd::BindPipeline(m_pipeline),
+        cmd::BindDescriptorSets(m_pipeline.GetPipelineLayout(), PipelineBindPoint::Compute, 0, {m_descriptorSet}),
+        cmd::PushConstants(m_pipeline.GetPipelineLayout(), ShaderStage::Compute, 0, pushConstants),
+        cmd::Dispatch((instanceCount + workgroupSize - 1) / workgroupSize, 1, 1),
+        cmd::PipelineBarier(
+            PipelineStage::ComputeShader, PipelineStage::DrawIndirect,
+            std::vector<BufferMemoryBarrier>{
+                BufferMemoryBarrier(Access::ShaderWrite, Access::IndirectCommandRead, m_draws, 0, m_draws.GetSize()),
+                BufferMemoryBarrier(Access::ShaderWrite, Access::IndirectCommandRead, m_count, 0, m_count.GetSize())}
+        )};
+}
+
+cmd::DrawIndexedIndirectCount GpuCulling::Draw() const {
+    assert(currentDevice->IsDrawIndirectCountEnabled());
+    return cmd::DrawIndexedIndirectCount(
+        m_draws, 0, m_count, 0, m_maxInstances, sizeof(DrawIndexedIndirectCommand)
+    );
+}
+
+const Buffer &GpuCulling::GetDrawBuffer() const { return m_draws; }
+
+const Buffer &GpuCulling::GetCountBuffer() const { return m_count; }
+
+uint32_t GpuCulling::GetMaxInstances() const { return m_maxInstances; }
+} // namespace vg
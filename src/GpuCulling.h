@@ -0,0 +1,98 @@
+#pragma once
+#include <tuple>
+#include "Handle.h"
+#include "Buffer.h"
+#include "CmdBuffer.h"
+#include "ComputePipeline.h"
+#include "DescriptorPool.h"
+#include "DescriptorSet.h"
+
+namespace vg {
+/**
+ *@brief Camera frustum as six planes, a point p is inside when dot(plane.xyz, p) + plane.w >= 0 for every plane
+ */
+struct Frustum {
+    float planes[6][4];
+
+    /**
+     *@brief Extract planes from a view projection matrix
+     *
+     * @param viewProjection Column major 4x4 matrix with Vulkan clip space, depth in [0, 1]
+     */
+    static Frustum FromMatrix(const float *viewProjection);
+};
+
+/**
+ *@brief Instance as read by the culling shader, 32 bytes with std430 layout
+ */
+struct CullInstance {
+    float center[3];
+    float radius;
+    uint32_t indexCount;
+    uint32_t firstIndex;
+    int32_t vertexOffset;
+    uint32_t instanceIndex;
+};
+
+/**
+ *@brief Frustum culls instances on the GPU and generates a compacted indirect draw list
+ * Every instance is tested against the frustum by its bounding sphere. Visible instances are compacted with a
+ * workgroup prefix sum into DrawIndexedIndirectCommands and counted, so the whole list is drawn with one
+ * \ref cmd::DrawIndexedIndirectCount without any per-instance work on the CPU. Needs VK_KHR_draw_indirect_count or
+ * Vulkan 1.2, see \ref Device::IsDrawIndirectCountEnabled().
+ */
+class GpuCulling {
+  public:
+    typedef std::tuple<
+        cmd::PipelineBarier, cmd::FillBuffer, cmd::PipelineBarier, cmd::BindPipeline, cmd::BindDescriptorSets,
+        cmd::PushConstants, cmd::Dispatch, cmd::PipelineBarier>
+        CullCommands;
+
+  public:
+    /**
+     *@brief Construct a new Gpu Culling object
+     *
+     * @param instances Buffer of CullInstance, needs BufferUsage::StorageBuffer and has to outlive the object
+     * @param maxInstances Maximal count of instances culled at once
+     * @param shaderPath Path to a compiled replacement of cull.comp, the copy built into the library is used if null
+     */
+    GpuCulling(const Buffer &instances, uint32_t maxInstances, const char *shaderPath = nullptr);
+
+    GpuCulling();
+    GpuCulling(GpuCulling &&other) noexcept;
+    GpuCulling(const GpuCulling &other) = delete;
+    ~GpuCulling() = default;
+
+    GpuCulling &operator=(GpuCulling &&other) noexcept;
+    GpuCulling &operator=(const GpuCulling &other) = delete;
+
+    /**
+     *@brief Commands that cull instances and make the results available to indirect draws, record them outside of
+     * a render pass
+     *
+     * @param frustum Camera frustum
+     * @param instanceCount Count of instances to cull from the start of the instance buffer
+     */
+    CullCommands Cull(const Frustum &frustum, uint32_t instanceCount) const;
+
+    /**
+     *@brief Draw of all instances that passed the last \ref GpuCulling::Cull()
+     */
+    cmd::DrawIndexedIndirectCount Draw() const;
+
+    const Buffer &GetDrawBuffer() const;
+    const Buffer &GetCountBuffer() const;
+    uint32_t GetMaxInstances() const;
+
+  public:
+    static constexpr uint32_t workgroupSize = 256;
+
+  private:
+    ComputePipeline m_pipeline;
+    DescriptorPool m_descriptorPool;
+    DescriptorSet m_descriptorSet;
+    Buffer m_draws;
+    Buffer m_count;
+    uint32_t m_maxInstances;
+};
+} // namespace vg
@@ -15,7 +15,8 @@ GraphicsPipeline::GraphicsPipeline(
       inputAssembly(inputAssembly), tesselation(tesselation), viewportState(viewportState), rasterizer(rasterizer),
       multisampling(multisampling), depthStencil(depthStencil), colorBlending(colorBlending),
       dynamicState(dynamicState), parentIndex(parentIndex),
-      parent(parent ? parent->m_handle : GraphicsPipelineHandle()) {}
+      parent(parent ? parent->m_handle : GraphicsPipelineHandle()),
+      m_parentUsesMeshShader(parent && parent->UsesMeshShader()) {}
 
 GraphicsPipeline::GraphicsPipeline(
     uint32_t pipelineLayout, std::vector<Shader> &&shaders, const VertexLayout &vertexInput,
@@ -28,12 +29,13 @@ GraphicsPipeline::GraphicsPipeline(
       inputAssembly(inputAssembly), tesselation(tesselation), viewportState(viewportState), rasterizer(rasterizer),
       multisampling(multisampling), depthStencil(depthStencil), colorBlending(colorBlending),
       dynamicState(dynamicState), parentIndex(parentIndex),
-      parent(parent ? parent->m_handle : GraphicsPipelineHandle()) {
+      parent(parent ? parent->m_handle : GraphicsPipelineHandle()),
+      m_parentUsesMeshShader(parent && parent->UsesMeshShader()) {
     this->shaders = std::vector<Shader *>(shaders_.size());
     for (int i = 0; i < shaders_.size(); i++) this->shaders[i] = &shaders_[i];
 }
 
-GraphicsPipeline::GraphicsPipeline() : m_handle(nullptr) {}
+GraphicsPipeline::GraphicsPipeline() : m_handle(nullptr), m_parentUsesMeshShader(false) {}
 
 GraphicsPipeline::GraphicsPipeline(GraphicsPipeline &&other) noexcept : GraphicsPipeline() { *this = std::move(other); }
 
@@ -55,10 +57,19 @@ GraphicsPipeline &GraphicsPipeline::operator=(GraphicsPipeline &&other) noexcept
     std::swap(dynamicState, other.dynamicState);
     std::swap(parentIndex, other.parentIndex);
     std::swap(parent, other.parent);
+    std::swap(m_parentUsesMeshShader, other.m_parentUsesMeshShader);
 
     return *this;
 }
 
 GraphicsPipeline::operator const GraphicsPipelineHandle &() const { return m_handle; }
 
+bool GraphicsPipeline::UsesMeshShader() const {
+    // Derived pipelines without shaders of their own take the stages of the parent.
+    if (shaders.empty()) return m_parentUsesMeshShader;
+    for (const Shader *shader : shaders)
+        if (shader->GetStage() == ShaderStage::Mesh) return true;
+    return false;
+}
+
 } // namespace vg
@@ -34,6 +34,14 @@ class GraphicsPipeline {
 
     operator const GraphicsPipelineHandle &() const;
 
+    /**
+     *@brief Whether the pipeline has a mesh shader stage, vertexInput and inputAssembly are ignored then
+     * Mesh pipelines take task and mesh shaders instead of vertex, tesselation and geometry shaders and are drawn with
+     * \ref cmd::DrawMeshTasks. Device has to support VK_EXT_mesh_shader. A pipeline without shaders answers for the
+     * parent it was created with.
+     */
+    bool UsesMeshShader() const;
+
     // private:
     const std::vector<Shader *> *GetShaders(const GraphicsPipeline *parent) const;
     uint32_t pipelineLayout;
@@ -52,6 +60,7 @@ class GraphicsPipeline {
     GraphicsPipelineHandle parent;
 
     GraphicsPipelineHandle m_handle;
+    bool m_parentUsesMeshShader;
     friend class RenderPass;
 };
 } // namespace vg
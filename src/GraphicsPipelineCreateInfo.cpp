@@ -0,0 +1,47 @@
+#include "GraphicsPipelineCreateInfo.h"
+#include "Device.h"
+#include "LayoutCache.h"
+
+namespace vg {
+GraphicsPipelineCreateInfo::GraphicsPipelineCreateInfo(
+    const GraphicsPipeline &pipeline, PipelineLayoutHandle layout, RenderPassHandle renderPass, uint32_t subpass,
+    vk::PipelineCreateFlags flags, const std::function<bool(ShaderStage)> &includeStage
+) {
+    for (const Shader *shader : pipeline.shaders)
+        if (!includeStage || includeStage(shader->GetStage())) m_shaderStages.push_back(*shader);
+
+    m_dynamicState = vk::PipelineDynamicStateCreateInfo(
+        {}, *(const std::vector<vk::DynamicState> *)&pipeline.dynamicState
+    );
+
+    // Mesh pipelines have no vertex input, the state must not be given then.
+    bool meshShader = pipeline.UsesMeshShader();
+    info = vk::GraphicsPipelineCreateInfo(
+        flags | GetLayoutFlags(layout), m_shaderStages,
+        meshShader ? nullptr : (const vk::PipelineVertexInputStateCreateInfo *)&pipeline.vertexInput,
+        meshShader ? nullptr : (const vk::PipelineInputAssemblyStateCreateInfo *)&pipeline.inputAssembly,
+        (const vk::PipelineTessellationStateCreateInfo *)&pipeline.tesselation,
+        (const vk::PipelineViewportStateCreateInfo *)&pipeline.viewportState,
+        (const vk::PipelineRasterizationStateCreateInfo *)&pipeline.rasterizer,
+        (const vk::PipelineMultisampleStateCreateInfo *)&pipeline.multisampling,
+        (const vk::PipelineDepthStencilStateCreateInfo *)&pipeline.depthStencil,
+        (const vk::PipelineColorBlendStateCreateInfo *)&pipeline.colorBlending, &m_dynamicState, layout,
+        (vk::RenderPass)renderPass, subpass, nullptr, -1
+    );
+}
+
+GraphicsPipelineCreateInfo &GraphicsPipelineCreateInfo::SetBase(GraphicsPipelineHandle handle, int32_t index) {
+    info.basePipelineHandle = handle;
+    info.basePipelineIndex = index;
+    if (handle || index != -1) info.flags |= vk::PipelineCreateFlagBits::eDerivative;
+    return *this;
+}
+
+vk::PipelineCreateFlags GraphicsPipelineCreateInfo::GetLayoutFlags(PipelineLayoutHandle layout) {
+    if (currentDevice->GetLayoutCache().IsDescriptorBufferLayout(layout))
+        return vk::PipelineCreateFlagBits::eDescriptorBufferEXT;
+    return {};
+}
+
+GraphicsPipelineCreateInfo::operator const vk::GraphicsPipelineCreateInfo &() const { return info; }
+} // namespace vg
@@ -0,0 +1,59 @@
+#pragma once
+#include <functional>
+#include <vector>
+#include <vulkan/vulkan.hpp>
+#include "GraphicsPipeline.h"
+
+namespace vg {
+/**
+ *@brief Create info of a graphics pipeline built from its \ref GraphicsPipeline description
+ * Every path creating graphics pipelines goes through it, so create flags and mesh shader handling stay consistent.
+ * Owns the arrays the create info points to, so it can't be copied or moved. Only meant to be included from source
+ * files.
+ */
+class GraphicsPipelineCreateInfo {
+  public:
+    /**
+     *@brief Construct a new Graphics Pipeline Create Info object
+     *
+     * @param pipeline Pipeline description, has to outlive the create info
+     * @param layout Pipeline layout
+     * @param renderPass Render pass the pipeline will be used with
+     * @param subpass Index of the subpass in renderPass
+     * @param flags Additional create flags, the descriptor buffer flag is added for layouts that need it
+     * @param includeStage Filter of shader stages, e.g. for pipeline library parts, all stages are included if null
+     */
+    GraphicsPipelineCreateInfo(
+        const GraphicsPipeline &pipeline, PipelineLayoutHandle layout, RenderPassHandle renderPass, uint32_t subpass,
+        vk::PipelineCreateFlags flags = {}, const std::function<bool(ShaderStage)> &includeStage = nullptr
+    );
+
+    GraphicsPipelineCreateInfo(GraphicsPipelineCreateInfo &&other) = delete;
+    GraphicsPipelineCreateInfo(const GraphicsPipelineCreateInfo &other) = delete;
+
+    GraphicsPipelineCreateInfo &operator=(GraphicsPipelineCreateInfo &&other) = delete;
+    GraphicsPipelineCreateInfo &operator=(const GraphicsPipelineCreateInfo &other) = delete;
+
+    /**
+     *@brief Make the pipeline a derivative, nothing changes if neither base is set
+     *
+     * @param handle Base pipeline
+     * @param index Index of the base pipeline in the same create call, -1 if none
+     */
+    GraphicsPipelineCreateInfo &SetBase(GraphicsPipelineHandle handle, int32_t index = -1);
+
+    /**
+     *@brief Create flags every pipeline using the layout needs, also compute pipelines and pipeline library links
+     */
+    static vk::PipelineCreateFlags GetLayoutFlags(PipelineLayoutHandle layout);
+
+    operator const vk::GraphicsPipelineCreateInfo &() const;
+
+  public:
+    vk::GraphicsPipelineCreateInfo info;
+
+  private:
+    std::vector<vk::PipelineShaderStageCreateInfo> m_shaderStages;
+    vk::PipelineDynamicStateCreateInfo m_dynamicState;
+};
+} // namespace vg
@@ -47,6 +47,7 @@ HANDLE(ShaderHandle, ShaderModule);
 HANDLE(PipelineCacheHandle, PipelineCache);
 HANDLE(GraphicsPipelineHandle, Pipeline);
 HANDLE(ComputePipelineHandle, Pipeline);
+HANDLE(PipelineHandle, Pipeline);
 HANDLE(PipelineLayoutHandle, PipelineLayout);
 HANDLE(RenderPassHandle, RenderPass);
 HANDLE(FramebufferHandle, Framebuffer);
@@ -55,10 +56,12 @@ HANDLE(FenceHandle, Fence);
 HANDLE(CmdPoolHandle, CommandPool);
 HANDLE(CmdBufferHandle, CommandBuffer);
 HANDLE(BufferHandle, Buffer);
+HANDLE(BufferViewHandle, BufferView);
 HANDLE(DeviceMemoryHandle, DeviceMemory);
 HANDLE(DescriptorSetLayoutHandle, DescriptorSetLayout);
 HANDLE(DescriptorPoolHandle, DescriptorPool);
 HANDLE(DescriptorSetHandle, DescriptorSet);
+HANDLE(DescriptorUpdateTemplateHandle, DescriptorUpdateTemplate);
 HANDLE(SamplerHandle, Sampler);
 HANDLE(QueryPoolHandle, QueryPool);
 } // namespace vg
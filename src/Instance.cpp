@@ -54,7 +54,7 @@ Instance::Instance(
     std::vector<const char *> extensions(requiredExtensions.begin(), requiredExtensions.end());
     if (enableValidationLayers) extensions.push_back(VK_EXT_DEBUG_UTILS_EXTENSION_NAME);
 
-    vk::ApplicationInfo appInfo("Hello Triangle", 1, "No Engine", 1, VK_API_VERSION_1_0);
+    vk::ApplicationInfo appInfo("Hello Triangle", 1, "No Engine", 1, VK_API_VERSION_1_3);
     vk::InstanceCreateInfo createInfo({}, &appInfo, nullptr, extensions);
 
     vk::DebugUtilsMessengerCreateInfoEXT debugCreateInfo;
@@ -0,0 +1,146 @@
+#include "InstanceBuffer.h"
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include "MemoryManager.h"
+
+namespace vg {
+InstanceBuffer::InstanceBuffer(
+    uint32_t instanceSize, uint32_t instanceCount, uint32_t frameCount, Flags<BufferUsage> usage,
+    Flags<PipelineStage> readStages
+)
+    : m_instanceSize(instanceSize), m_instanceCount(instanceCount), m_readStages(readStages),
+      m_buffer((uint64_t)instanceSize * instanceCount, usage | BufferUsage::TransferDst),
+      m_data((size_t)instanceSize * instanceCount), m_dirty((instanceCount + 63) / 64, ~0ULL), m_anyDirty(true),
+      m_frames(frameCount), m_currentFrame(0) {
+    assert(instanceSize > 0 && instanceCount > 0 && frameCount > 0);
+
+    if (readStages.IsSet(PipelineStage::VertexInput)) m_readAccess.Set(Access::VertexAttributeRead);
+    if (readStages.GetSetCount() > readStages.IsSet(PipelineStage::VertexInput)) m_readAccess.Set(Access::ShaderRead);
+
+    vg::Allocate({&m_buffer}, {MemoryProperty::DeviceLocal});
+}
+
+InstanceBuffer::InstanceBuffer()
+    : m_instanceSize(0), m_instanceCount(0), m_anyDirty(false), m_currentFrame(0) {}
+
+InstanceBuffer::InstanceBuffer(InstanceBuffer &&other) noexcept : InstanceBuffer() { *this = std::move(other); }
+
+InstanceBuffer &InstanceBuffer::operator=(InstanceBuffer &&other) noexcept {
+    if (&other == this) return *this;
+
+    std::swap(m_instanceSize, other.m_instanceSize);
+    std::swap(m_instanceCount, other.m_instanceCount);
+    std::swap(m_readStages, other.m_readStages);
+    std::swap(m_readAccess, other.m_readAccess);
+    std::swap(m_buffer, other.m_buffer);
+    std::swap(m_data, other.m_data);
+    std::swap(m_dirty, other.m_dirty);
+    std::swap(m_anyDirty, other.m_anyDirty);
+    std::swap(m_frames, other.m_frames);
+    std::swap(m_currentFrame, other.m_currentFrame);
+    std::swap(m_regions, other.m_regions);
+    std::swap(m_stats, other.m_stats);
+
+    return *this;
+}
+
+char *InstanceBuffer::Modify(uint32_t first, uint32_t count) {
+    assert(first + count <= m_instanceCount);
+    if (count == 0) return &m_data[(size_t)first * m_instanceSize];
+
+    uint32_t last = first + count - 1;
+    uint32_t firstWord = first / 64, lastWord = last / 64;
+    uint64_t firstMask = ~0ULL << (first % 64), lastMask = ~0ULL >> (63 - last % 64);
+    if (firstWord == lastWord) m_dirty[firstWord] |= firstMask & lastMask;
+    else {
+        m_dirty[firstWord] |= firstMask;
+        std::fill(m_dirty.begin() + firstWord + 1, m_dirty.begin() + lastWord, ~0ULL);
+        m_dirty[lastWord] |= lastMask;
+    }
+    m_anyDirty = true;
+
+    return &m_data[(size_t)first * m_instanceSize];
+}
+
+void InstanceBuffer::Write(uint32_t first, Span<const char> data) {
+    assert(data.size() % m_instanceSize == 0);
+    std::memcpy(Modify(first, data.size() / m_instanceSize), data.data(), data.size());
+}
+
+uint32_t InstanceBuffer::FindDirty(uint32_t first, bool dirty) const {
+    uint32_t word = first / 64;
+    if (word >= m_dirty.size()) return m_instanceCount;
+
+    uint64_t bits = (dirty ? m_dirty[word] : ~m_dirty[word]) & (~0ULL << (first % 64));
+    while (!bits) {
+        if (++word == m_dirty.size()) return m_instanceCount;
+        bits = dirty ? m_dirty[word] : ~m_dirty[word];
+    }
+    return std::min(word * 64 + (uint32_t)std::countr_zero(bits), m_instanceCount);
+}
+
+void InstanceBuffer::Upload(CmdBuffer &cmdBuffer) {
+    m_stats = Stats();
+    if (!m_anyDirty) return;
+
+    // Runs of dirty instances become copy regions, runs separated by small gaps share a region since a few extra
+    // bytes are cheaper than another region.
+    uint32_t mergeGap = std::max(mergeGapSize / m_instanceSize, 1U);
+    uint64_t stagingSize = 0;
+    m_regions.clear();
+    for (uint32_t begin = FindDirty(0, true); begin < m_instanceCount;) {
+        uint32_t end = FindDirty(begin, false);
+        m_stats.dirtyInstances += end - begin;
+
+        uint64_t offset = (uint64_t)begin * m_instanceSize, size = (uint64_t)(end - begin) * m_instanceSize;
+        BufferCopyRegion *last = m_regions.empty() ? nullptr : &m_regions.back();
+        if (last && offset - (last->dstOffset + last->size) <= (uint64_t)mergeGap * m_instanceSize) {
+            stagingSize += offset + size - (last->dstOffset + last->size);
+            last->size = offset + size - last->dstOffset;
+        } else {
+            m_regions.push_back(BufferCopyRegion(size, stagingSize, offset));
+            stagingSize += size;
+        }
+
+        begin = FindDirty(end, true);
+    }
+    std::fill(m_dirty.begin(), m_dirty.end(), 0);
+    m_anyDirty = false;
+
+    // Staging buffers grow to the largest upload seen, so steady state frames don't allocate.
+    Frame &frame = m_frames[m_currentFrame];
+    if (frame.staging.GetSize() < stagingSize) {
+        frame.staging = Buffer(std::min(std::max(stagingSize, frame.staging.GetSize() * 2), m_data.size()),
+                               {BufferUsage::TransferSrc});
+        vg::Allocate({&frame.staging}, {MemoryProperty::HostVisible, MemoryProperty::HostCoherent});
+        frame.data = frame.staging.MapMemory();
+    }
+    for (auto &&region : m_regions)
+        std::memcpy(frame.data + region.srcOffset, &m_data[region.dstOffset], region.size);
+
+    cmd::CopyBuffer copy;
+    copy.src = frame.staging;
+    copy.dst = m_buffer;
+    copy.regions = m_regions;
+    cmdBuffer.Append(
+        cmd::PipelineBarier(m_readStages, PipelineStage::Transfer, std::vector<MemoryBarrier>()), copy,
+        cmd::PipelineBarier(PipelineStage::Transfer, m_readStages, {MemoryBarrier(Access::TransferWrite, m_readAccess)})
+    );
+
+    m_stats.regionCount = m_regions.size();
+    m_stats.uploadedBytes = stagingSize;
+}
+
+void InstanceBuffer::NextFrame() { m_currentFrame = (m_currentFrame + 1) % m_frames.size(); }
+
+const Buffer &InstanceBuffer::GetBuffer() const { return m_buffer; }
+
+const char *InstanceBuffer::GetData() const { return m_data.data(); }
+
+uint32_t InstanceBuffer::GetInstanceSize() const { return m_instanceSize; }
+
+uint32_t InstanceBuffer::GetInstanceCount() const { return m_instanceCount; }
+
+const InstanceBuffer::Stats &InstanceBuffer::GetStats() const { return m_stats; }
+} // namespace vg
@@ -0,0 +1,125 @@
+#pragma once
+#include <cassert>
+#include <cstdint>
+#include <vector>
+#include "Buffer.h"
+#include "CmdBuffer.h"
+#include "Enums.h"
+#include "Flags.h"
+#include "Span.h"
+
+namespace vg {
+/**
+ *@brief Device local buffer of per instance data streamed from a CPU copy
+ * Instances are modified in the CPU copy, which marks them dirty. \ref InstanceBuffer::Upload() copies only dirty
+ * instances, with nearby dirty ranges merged into one copy region, through a staging buffer per frame in flight. So
+ * uploads cost in proportion to what changed and the CPU never writes memory a frame in flight still reads.
+ */
+class InstanceBuffer {
+  public:
+    struct Stats {
+        uint32_t dirtyInstances = 0;
+        uint32_t regionCount = 0;
+        uint64_t uploadedBytes = 0;
+    };
+
+  public:
+    /**
+     *@brief Construct a new Instance Buffer object, all instances start zeroed and dirty
+     *
+     * @param instanceSize Size of an instance in bytes
+     * @param instanceCount Count of instances
+     * @param frameCount Count of frames in flight, staging buffers are reused after that many \ref NextFrame() calls
+     * @param usage How the buffer is used besides being a transfer destination
+     * @param readStages Stages reading the buffer, uploads wait for and are made visible to them
+     */
+    InstanceBuffer(
+        uint32_t instanceSize, uint32_t instanceCount, uint32_t frameCount = 2,
+        Flags<BufferUsage> usage = BufferUsage::VertexBuffer,
+        Flags<PipelineStage> readStages = {PipelineStage::VertexInput, PipelineStage::VertexShader}
+    );
+
+    InstanceBuffer();
+    InstanceBuffer(InstanceBuffer &&other) noexcept;
+    InstanceBuffer(const InstanceBuffer &other) = delete;
+    ~InstanceBuffer() = default;
+
+    InstanceBuffer &operator=(InstanceBuffer &&other) noexcept;
+    InstanceBuffer &operator=(const InstanceBuffer &other) = delete;
+
+    /**
+     *@brief Mark instances dirty and get them for writing
+     *
+     * @param first Index of the first instance
+     * @param count Count of instances
+     * @return CPU copy of the instances, valid until the buffer is moved or destroyed
+     */
+    char *Modify(uint32_t first, uint32_t count = 1);
+    template <typename T> T *Modify(uint32_t first, uint32_t count = 1) {
+        assert(sizeof(T) == m_instanceSize);
+        return (T *)Modify(first, count);
+    }
+
+    /**
+     *@brief Overwrite instances starting at first, data has to be a multiple of the instance size
+     */
+    void Write(uint32_t first, Span<const char> data);
+    template <typename T> void Write(uint32_t first, Span<const T> instances) {
+        assert(sizeof(T) == m_instanceSize);
+        Write(first, Span<const char>((const char *)instances.data(), instances.size() * sizeof(T)));
+    }
+
+    /**
+     *@brief Record copies of dirty instances, has to be outside of a render pass
+     * The copy waits for reads of the previous frames and is made visible to the read stages.
+     */
+    void Upload(CmdBuffer &cmdBuffer);
+
+    /**
+     *@brief Move to the next frame's staging buffer, the frame it was used by last has to be finished
+     */
+    void NextFrame();
+
+    const Buffer &GetBuffer() const;
+    /**
+     *@brief CPU copy of all instances
+     */
+    const char *GetData() const;
+    uint32_t GetInstanceSize() const;
+    uint32_t GetInstanceCount() const;
+    /**
+     *@brief Statistics of the last upload
+     */
+    const Stats &GetStats() const;
+
+    /**
+     *@brief Dirty ranges at most this many bytes apart are copied as one region
+     */
+    static constexpr uint32_t mergeGapSize = 256;
+
+  private:
+    uint32_t FindDirty(uint32_t first, bool dirty) const;
+
+  private:
+    struct Frame {
+        Buffer staging;
+        char *data = nullptr;
+    };
+
+    uint32_t m_instanceSize;
+    uint32_t m_instanceCount;
+    Flags<PipelineStage> m_readStages;
+    Flags<Access> m_readAccess;
+
+    Buffer m_buffer;
+    std::vector<char> m_data;
+    std::vector<uint64_t> m_dirty;
+    bool m_anyDirty;
+
+    std::vector<Frame> m_frames;
+    uint32_t m_currentFrame;
+    std::vector<BufferCopyRegion> m_regions;
+
+    Stats m_stats;
+};
+} // namespace vg
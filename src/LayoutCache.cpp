@@ -0,0 +1,183 @@
+#include <vulkan/vulkan.hpp>
+#include "LayoutCache.h"
+#include "Device.h"
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+
+namespace vg {
+template <typename T> static uint64_t HandleKey(const T &handle) { return (uint64_t)(typename T::CType)handle; }
+
+LayoutCache::LayoutCache() {}
+
+LayoutCache::~LayoutCache() {
+    for (auto &&[key, entry] : m_pipelineLayouts) ((DeviceHandle)*currentDevice).destroyPipelineLayout(entry.handle);
+    for (auto &&[key, entry] : m_setLayouts) ((DeviceHandle)*currentDevice).destroyDescriptorSetLayout(entry.handle);
+}
+
+DescriptorSetLayoutHandle LayoutCache::AcquireSetLayout(
+    Span<const DescriptorSetLayoutBinding> bindings, Flags<DescriptorSetLayoutCreate> flags,
+    Span<const Flags<DescriptorBinding>> bindingFlags
+) {
+    assert(bindingFlags.empty() || bindingFlags.size() == bindings.size());
+
+    // Bindings have no padding, so their bytes are the key. Immutable sampler pointers are part of it on purpose.
+    // Binding flags are either absent or one per binding, so the binding count prefix keeps the arrays apart.
+    uint32_t bindingCount = bindings.size();
+    std::string key((const char *)&bindingCount, sizeof(bindingCount));
+    key.append((const char *)bindings.data(), bindings.size_bytes());
+    key.append((const char *)&flags, sizeof(flags));
+    key.append((const char *)bindingFlags.data(), bindingFlags.size_bytes());
+
+    std::lock_guard lock(m_mutex);
+    auto it = m_setLayouts.find(key);
+    if (it != m_setLayouts.end()) {
+        it->second.referenceCount++;
+        return it->second.handle;
+    }
+
+    vk::DescriptorSetLayoutBindingFlagsCreateInfo bindingFlagsInfo(
+        bindingFlags.size(), (const vk::DescriptorBindingFlags *)bindingFlags.data()
+    );
+    DescriptorSetLayoutHandle handle =
+        ((DeviceHandle)*currentDevice)
+            .createDescriptorSetLayout(vk::DescriptorSetLayoutCreateInfo(
+                (vk::DescriptorSetLayoutCreateFlags)flags, bindings.size(),
+                (const vk::DescriptorSetLayoutBinding *)bindings.data(),
+                bindingFlags.empty() ? nullptr : &bindingFlagsInfo
+            ));
+    m_setLayouts[key] = {handle, 1};
+    m_setLayoutKeys[HandleKey(handle)] = key;
+    if (flags.IsSet(DescriptorSetLayoutCreate::DescriptorBuffer))
+        m_descriptorBufferSetLayouts.insert(HandleKey(handle));
+    return handle;
+}
+
+PipelineLayoutHandle LayoutCache::AcquirePipelineLayout(
+    Span<const DescriptorSetLayoutHandle> setLayouts, Span<const PushConstantRange> pushConstantRanges
+) {
+    // Set layouts are deduplicated, so their handles identify them. Count prefix keeps the two arrays apart.
+    uint32_t setLayoutCount = setLayouts.size();
+    std::string key((const char *)&setLayoutCount, sizeof(setLayoutCount));
+    key.append((const char *)setLayouts.data(), setLayouts.size_bytes());
+    key.append((const char *)pushConstantRanges.data(), pushConstantRanges.size_bytes());
+
+    std::lock_guard lock(m_mutex);
+    auto it = m_pipelineLayouts.find(key);
+    if (it != m_pipelineLayouts.end()) {
+        it->second.referenceCount++;
+        return it->second.handle;
+    }
+
+    PipelineLayoutHandle handle = ((DeviceHandle)*currentDevice)
+                                      .createPipelineLayout(vk::PipelineLayoutCreateInfo(
+                                          {}, setLayouts.size(), (const vk::DescriptorSetLayout *)setLayouts.data(),
+                                          pushConstantRanges.size(),
+                                          (const vk::PushConstantRange *)pushConstantRanges.data()
+                                      ));
+    m_pipelineLayouts[key] = {handle, 1};
+    m_pipelineLayoutKeys[HandleKey(handle)] = key;
+    // The key holds set layout handles, they are kept alive so a destroyed layout's reused handle can't hit this entry.
+    for (auto &&setLayout : setLayouts) {
+        auto setLayoutKey = m_setLayoutKeys.find(HandleKey(setLayout));
+        assert(setLayoutKey != m_setLayoutKeys.end() && "Set layout wasn't acquired from this cache");
+        if (setLayoutKey == m_setLayoutKeys.end()) continue;
+        m_setLayouts.at(setLayoutKey->second).referenceCount++;
+        m_pipelineLayoutSets[HandleKey(handle)].push_back(setLayout);
+
+        if (m_descriptorBufferSetLayouts.contains(HandleKey(setLayout)))
+            m_descriptorBufferPipelineLayouts.insert(HandleKey(handle));
+    }
+    return handle;
+}
+
+void LayoutCache::AddReference(DescriptorSetLayoutHandle setLayout) {
+    std::lock_guard lock(m_mutex);
+    m_setLayouts.at(m_setLayoutKeys.at(HandleKey(setLayout))).referenceCount++;
+}
+
+void LayoutCache::AddReference(PipelineLayoutHandle pipelineLayout) {
+    std::lock_guard lock(m_mutex);
+    m_pipelineLayouts.at(m_pipelineLayoutKeys.at(HandleKey(pipelineLayout))).referenceCount++;
+}
+
+void LayoutCache::Release(DescriptorSetLayoutHandle setLayout) {
+    std::lock_guard lock(m_mutex);
+    ReleaseSetLayout(setLayout);
+}
+
+void LayoutCache::Release(PipelineLayoutHandle pipelineLayout) {
+    std::lock_guard lock(m_mutex);
+    auto key = m_pipelineLayoutKeys.find(HandleKey(pipelineLayout));
+    assert(key != m_pipelineLayoutKeys.end() && "Layout wasn't acquired from this cache");
+    if (key == m_pipelineLayoutKeys.end()) return;
+    auto it = m_pipelineLayouts.find(key->second);
+    if (--it->second.referenceCount != 0) return;
+
+    ((DeviceHandle)*currentDevice).destroyPipelineLayout(pipelineLayout);
+    m_pipelineLayouts.erase(it);
+    m_pipelineLayoutKeys.erase(key);
+    m_descriptorBufferPipelineLayouts.erase(HandleKey(pipelineLayout));
+
+    auto setLayouts = m_pipelineLayoutSets.find(HandleKey(pipelineLayout));
+    if (setLayouts == m_pipelineLayoutSets.end()) return;
+    for (auto &&setLayout : setLayouts->second) ReleaseSetLayout(setLayout);
+    m_pipelineLayoutSets.erase(setLayouts);
+}
+
+void LayoutCache::ReleaseSetLayout(DescriptorSetLayoutHandle setLayout) {
+    auto key = m_setLayoutKeys.find(HandleKey(setLayout));
+    assert(key != m_setLayoutKeys.end() && "Layout wasn't acquired from this cache");
+    if (key == m_setLayoutKeys.end()) return;
+    auto it = m_setLayouts.find(key->second);
+    if (--it->second.referenceCount != 0) return;
+
+    ((DeviceHandle)*currentDevice).destroyDescriptorSetLayout(setLayout);
+    m_setLayouts.erase(it);
+    m_setLayoutKeys.erase(key);
+    m_descriptorBufferSetLayouts.erase(HandleKey(setLayout));
+}
+
+bool LayoutCache::IsDescriptorBufferLayout(DescriptorSetLayoutHandle setLayout) const {
+    std::lock_guard lock(m_mutex);
+    return m_descriptorBufferSetLayouts.contains(HandleKey(setLayout));
+}
+
+bool LayoutCache::IsDescriptorBufferLayout(PipelineLayoutHandle pipelineLayout) const {
+    std::lock_guard lock(m_mutex);
+    return m_descriptorBufferPipelineLayouts.contains(HandleKey(pipelineLayout));
+}
+
+bool LayoutCache::AddDescriptorCounts(
+    DescriptorSetLayoutHandle setLayout, std::vector<DescriptorPoolSize> &counts
+) const {
+    std::lock_guard lock(m_mutex);
+    auto key = m_setLayoutKeys.find(HandleKey(setLayout));
+    if (key == m_setLayoutKeys.end()) return false;
+
+    // The key starts with the binding count followed by the bindings.
+    uint32_t bindingCount;
+    std::memcpy(&bindingCount, key->second.data(), sizeof(bindingCount));
+    for (uint32_t i = 0; i < bindingCount; i++) {
+        DescriptorSetLayoutBinding binding;
+        std::memcpy(&binding, key->second.data() + sizeof(bindingCount) + i * sizeof(binding), sizeof(binding));
+
+        auto count = std::find_if(counts.begin(), counts.end(), [&](const DescriptorPoolSize &size) {
+            return size.descriptorType == binding.descriptorType;
+        });
+        if (count == counts.end()) counts.emplace_back(binding.descriptorType, binding.descriptorCount);
+        else count->descriptorCount += binding.descriptorCount;
+    }
+    return true;
+}
+
+uint32_t LayoutCache::GetSetLayoutCount() const {
+    std::lock_guard lock(m_mutex);
+    return m_setLayouts.size();
+}
+
+uint32_t LayoutCache::GetPipelineLayoutCount() const {
+    std::lock_guard lock(m_mutex);
+    return m_pipelineLayouts.size();
+}
+} // namespace vg
@@ -0,0 +1,99 @@
+#pragma once
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include "Handle.h"
+#include "Structs.h"
+#include "Span.h"
+
+namespace vg {
+/**
+ *@brief Device wide cache of descriptor set layouts and pipeline layouts
+ * Layouts are keyed by their contents, identical layouts share one handle. Handles are reference counted and destroyed
+ * when the last reference is released. Every device owns one cache, \ref PipelineLayout uses it automatically.
+ * All methods are thread safe.
+ */
+class LayoutCache {
+  public:
+    LayoutCache();
+    LayoutCache(LayoutCache &&other) = delete;
+    LayoutCache(const LayoutCache &other) = delete;
+    ~LayoutCache();
+
+    LayoutCache &operator=(LayoutCache &&other) = delete;
+    LayoutCache &operator=(const LayoutCache &other) = delete;
+
+    /**
+     *@brief Get a reference to the layout with the bindings, creating it if needed
+     *
+     * @param bindings Bindings of the layout, order matters
+     * @param flags Create flags, DescriptorBuffer for use with \ref DescriptorBuffer, PushDescriptor for use with
+     * cmd::PushDescriptorSet
+     * @param bindingFlags Flags of each binding, e.g. for descriptor indexing, empty if no binding has any
+     * @return Handle, has to be released with \ref LayoutCache::Release()
+     */
+    DescriptorSetLayoutHandle AcquireSetLayout(
+        Span<const DescriptorSetLayoutBinding> bindings, Flags<DescriptorSetLayoutCreate> flags = {},
+        Span<const Flags<DescriptorBinding>> bindingFlags = {}
+    );
+
+    /**
+     *@brief Get a reference to the pipeline layout, creating it if needed
+     *
+     * @param setLayouts Descriptor set layouts acquired from this cache, the pipeline layout keeps them alive
+     * @param pushConstantRanges Push constant ranges
+     * @return Handle, has to be released with \ref LayoutCache::Release()
+     */
+    PipelineLayoutHandle
+    AcquirePipelineLayout(Span<const DescriptorSetLayoutHandle> setLayouts, Span<const PushConstantRange> pushConstantRanges);
+
+    void AddReference(DescriptorSetLayoutHandle setLayout);
+    void AddReference(PipelineLayoutHandle pipelineLayout);
+    /**
+     *@brief Drop a reference, the layout is destroyed with the last one. Layouts not acquired from the cache are
+     * ignored.
+     */
+    void Release(DescriptorSetLayoutHandle setLayout);
+    void Release(PipelineLayoutHandle pipelineLayout);
+
+    /**
+     *@brief Check if the layout was acquired for use with \ref DescriptorBuffer
+     */
+    bool IsDescriptorBufferLayout(DescriptorSetLayoutHandle setLayout) const;
+    /**
+     *@brief Check if any set of the layout was acquired for use with \ref DescriptorBuffer, pipelines using it have
+     * to be created with the descriptor buffer flag
+     */
+    bool IsDescriptorBufferLayout(PipelineLayoutHandle pipelineLayout) const;
+
+    /**
+     *@brief Add count of descriptors of each type in the layout to counts
+     *
+     * @return false if the layout wasn't acquired from the cache, nothing is added then
+     */
+    bool AddDescriptorCounts(DescriptorSetLayoutHandle setLayout, std::vector<DescriptorPoolSize> &counts) const;
+
+    uint32_t GetSetLayoutCount() const;
+    uint32_t GetPipelineLayoutCount() const;
+
+  private:
+    void ReleaseSetLayout(DescriptorSetLayoutHandle setLayout);
+
+  private:
+    template <typename T> struct Entry {
+        T handle;
+        uint32_t referenceCount;
+    };
+
+    mutable std::mutex m_mutex;
+    std::unordered_map<std::string, Entry<DescriptorSetLayoutHandle>> m_setLayouts;
+    std::unordered_map<std::string, Entry<PipelineLayoutHandle>> m_pipelineLayouts;
+    std::unordered_map<uint64_t, std::string> m_setLayoutKeys;
+    std::unordered_map<uint64_t, std::string> m_pipelineLayoutKeys;
+    std::unordered_map<uint64_t, std::vector<DescriptorSetLayoutHandle>> m_pipelineLayoutSets;
+    std::unordered_set<uint64_t> m_descriptorBufferSetLayouts;
+    std::unordered_set<uint64_t> m_descriptorBufferPipelineLayouts;
+};
+} // namespace vg
@@ -0,0 +1,97 @@
+#include "MappedFile.h"
+#include <stdexcept>
+#include <string>
+#include <utility>
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace vg {
+#ifdef _WIN32
+MappedFile::MappedFile(const char *path) : MappedFile() {
+    m_file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (m_file == INVALID_HANDLE_VALUE) {
+        m_file = nullptr;
+        throw std::runtime_error(std::string("Failed to open file: ") + path);
+    }
+
+    LARGE_INTEGER size;
+    GetFileSizeEx(m_file, &size);
+    m_size = size.QuadPart;
+    if (m_size == 0) return;
+
+    m_mapping = CreateFileMappingA(m_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (m_mapping) m_data = (const char *)MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0);
+    // Constructor delegates to the default one, so throwing runs the destructor and closes the handles.
+    if (m_data == nullptr) throw std::runtime_error(std::string("Failed to map file: ") + path);
+}
+
+MappedFile::MappedFile() : m_data(nullptr), m_size(0), m_file(nullptr), m_mapping(nullptr) {}
+
+MappedFile::~MappedFile() {
+    if (m_data) UnmapViewOfFile(m_data);
+    if (m_mapping) CloseHandle(m_mapping);
+    if (m_file) CloseHandle(m_file);
+
+    m_data = nullptr;
+    m_mapping = nullptr;
+    m_file = nullptr;
+}
+#else
+MappedFile::MappedFile(const char *path) : MappedFile() {
+    int file = open(path, O_RDONLY);
+    if (file == -1) throw std::runtime_error(std::string("Failed to open file: ") + path);
+
+    struct stat info;
+    if (fstat(file, &info) == -1) {
+        close(file);
+        throw std::runtime_error(std::string("Failed to read size of file: ") + path);
+    }
+
+    // The mapping stays valid after the descriptor is closed.
+    m_size = info.st_size;
+    if (m_size != 0) {
+        void *data = mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, file, 0);
+        if (data != MAP_FAILED) m_data = (const char *)data;
+    }
+    close(file);
+
+    if (m_size != 0 && m_data == nullptr) throw std::runtime_error(std::string("Failed to map file: ") + path);
+}
+
+MappedFile::MappedFile() : m_data(nullptr), m_size(0) {}
+
+MappedFile::~MappedFile() {
+    if (m_data == nullptr) return;
+
+    munmap((void *)m_data, m_size);
+    m_data = nullptr;
+}
+#endif
+
+MappedFile::MappedFile(MappedFile &&other) noexcept : MappedFile() { *this = std::move(other); }
+
+MappedFile &MappedFile::operator=(MappedFile &&other) noexcept {
+    if (&other == this) return *this;
+
+    std::swap(m_data, other.m_data);
+    std::swap(m_size, other.m_size);
+#ifdef _WIN32
+    std::swap(m_file, other.m_file);
+    std::swap(m_mapping, other.m_mapping);
+#endif
+
+    return *this;
+}
+
+const char *MappedFile::GetData() const { return m_data; }
+
+uint64_t MappedFile::GetSize() const { return m_size; }
+} // namespace vg
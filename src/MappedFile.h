@@ -0,0 +1,37 @@
+#pragma once
+#include <stdint.h>
+
+namespace vg {
+/**
+ *@brief Read only memory mapping of a whole file
+ * Contents are paged in on access by the OS, nothing is copied into user memory.
+ */
+class MappedFile {
+  public:
+    /**
+     *@brief Map file into memory
+     *
+     * @param path Path to the file, throws std::runtime_error if it can't be opened or mapped
+     */
+    MappedFile(const char *path);
+
+    MappedFile();
+    MappedFile(MappedFile &&other) noexcept;
+    MappedFile(const MappedFile &other) = delete;
+    ~MappedFile();
+
+    MappedFile &operator=(MappedFile &&other) noexcept;
+    MappedFile &operator=(const MappedFile &other) = delete;
+
+    const char *GetData() const;
+    uint64_t GetSize() const;
+
+  private:
+    const char *m_data;
+    uint64_t m_size;
+#ifdef _WIN32
+    void *m_file;
+    void *m_mapping;
+#endif
+};
+} // namespace vg
@@ -17,6 +17,17 @@ uint32_t FindMemoryType(vk::PhysicalDeviceMemoryProperties memProperties, uint32
 }
 namespace vg
 {
+    // Buffers may be used with device addresses whenever the device supports them.
+    static vk::MemoryAllocateInfo BufferAllocateInfo(uint64_t size, uint32_t memoryType)
+    {
+        static const vk::MemoryAllocateFlagsInfo flagsInfo(vk::MemoryAllocateFlagBits::eDeviceAddress);
+
+        vk::MemoryAllocateInfo info(size, memoryType);
+        if (currentDevice->IsExtensionEnabled(VK_KHR_BUFFER_DEVICE_ADDRESS_EXTENSION_NAME))
+            info.pNext = &flagsInfo;
+        return info;
+    }
+
     void Allocate(Span<Buffer* const> buffers, Flags<MemoryProperty> memoryProperty)
     {
         uint64_t currentSize = 0;
@@ -32,7 +43,7 @@ namespace vg
         }
 
         vk::PhysicalDeviceMemoryProperties memProperties = ((PhysicalDeviceHandle) *currentDevice).getMemoryProperties();
-        MemoryBlock* block = new MemoryBlock(((DeviceHandle) *currentDevice).allocateMemory({ currentSize, FindMemoryType(memProperties,memoryTypeBits, memoryProperty) }), currentSize);
+        MemoryBlock* block = new MemoryBlock(((DeviceHandle) *currentDevice).allocateMemory(BufferAllocateInfo(currentSize, FindMemoryType(memProperties, memoryTypeBits, memoryProperty))), currentSize);
 
         for (int i = 0; i < buffers.size(); i++)
             block->Bind(buffers.begin()[i]);
@@ -53,7 +64,7 @@ namespace vg
         }
 
         vk::PhysicalDeviceMemoryProperties memProperties = ((PhysicalDeviceHandle) *currentDevice).getMemoryProperties();
-        MemoryBlock* block = new MemoryBlock(((DeviceHandle) *currentDevice).allocateMemory({ currentSize, FindMemoryType(memProperties,memoryTypeBits, memoryProperty) }), currentSize);
+        MemoryBlock* block = new MemoryBlock(((DeviceHandle) *currentDevice).allocateMemory(BufferAllocateInfo(currentSize, FindMemoryType(memProperties, memoryTypeBits, memoryProperty))), currentSize);
 
         for (int i = 0; i < buffers.size(); i++)
             block->Bind(&buffers.begin()[i]);
@@ -151,4 +162,18 @@ namespace vg
         ((DeviceHandle) *currentDevice).unmapMemory(m_handle);
         m_mappedMemory = nullptr;
     }
+
+    void MemoryBlock::InvalidateMappedMemory()
+    {
+        if (m_mappedMemory == nullptr) return;
+
+        ((DeviceHandle) *currentDevice).invalidateMappedMemoryRanges({ vk::MappedMemoryRange(m_handle, 0, VK_WHOLE_SIZE) });
+    }
+
+    void MemoryBlock::FlushMappedMemory()
+    {
+        if (m_mappedMemory == nullptr) return;
+
+        ((DeviceHandle) *currentDevice).flushMappedMemoryRanges({ vk::MappedMemoryRange(m_handle, 0, VK_WHOLE_SIZE) });
+    }
 }
\ No newline at end of file
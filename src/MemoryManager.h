@@ -27,6 +27,8 @@ class MemoryBlock {
     void Dereferance();
     char *GetMappedMemory();
     void UnmapMemory();
+    void InvalidateMappedMemory();
+    void FlushMappedMemory();
     int m_referanceCount;
     DeviceMemoryHandle m_handle;
     uint64_t m_totalSize;
@@ -0,0 +1,337 @@
+#include "MeshOptimizer.h"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cassert>
+#include <cmath>
+#include <cstring>
+#include <tuple>
+
+namespace vg {
+namespace {
+constexpr uint32_t cacheSize = 32;
+constexpr float cacheDecayPower = 1.5f;
+constexpr float lastTriangleScore = 0.75f;
+constexpr float valenceBoostScale = 2.0f;
+constexpr float valenceBoostPower = 0.5f;
+
+// Scores are tabulated, pow is by far the most expensive part of the optimization otherwise.
+constexpr uint32_t maxTabulatedValence = 64;
+
+struct ScoreTables {
+    float cache[cacheSize];
+    float valence[maxTabulatedValence];
+
+    ScoreTables() {
+        for (uint32_t i = 0; i < cacheSize; i++)
+            // Vertices of the last triangle score the same so its orientation doesn't matter.
+            cache[i] = i < 3 ? lastTriangleScore : std::pow(1.0f - (i - 3) / float(cacheSize - 3), cacheDecayPower);
+        for (uint32_t i = 1; i < maxTabulatedValence; i++)
+            valence[i] = valenceBoostScale * std::pow((float)i, -valenceBoostPower);
+    }
+};
+const ScoreTables scoreTables;
+
+float VertexScore(int32_t cachePosition, uint32_t liveTriangles) {
+    if (liveTriangles == 0) return -1.0f;
+
+    float score = cachePosition >= 0 ? scoreTables.cache[cachePosition] : 0.0f;
+    return score + (liveTriangles < maxTabulatedValence
+                        ? scoreTables.valence[liveTriangles]
+                        : valenceBoostScale * std::pow((float)liveTriangles, -valenceBoostPower));
+}
+
+// Forsyth's algorithm on one chunk, vertices are renumbered locally so memory depends on the chunk size only.
+void OptimizeChunk(Span<uint32_t> indices) {
+    uint32_t triangleCount = indices.size() / 3;
+    if (triangleCount == 0) return;
+
+    std::vector<uint32_t> sortedVertices(indices.begin(), indices.end());
+    std::sort(sortedVertices.begin(), sortedVertices.end());
+    sortedVertices.erase(std::unique(sortedVertices.begin(), sortedVertices.end()), sortedVertices.end());
+    uint32_t vertexCount = sortedVertices.size();
+
+    std::vector<uint32_t> local(indices.size());
+    for (size_t i = 0; i < indices.size(); i++)
+        local[i] = std::lower_bound(sortedVertices.begin(), sortedVertices.end(), indices[i]) - sortedVertices.begin();
+
+    // Triangles using each vertex.
+    std::vector<uint32_t> liveTriangles(vertexCount, 0);
+    for (uint32_t vertex : local) liveTriangles[vertex]++;
+    std::vector<uint32_t> adjacencyOffsets(vertexCount + 1, 0);
+    for (uint32_t i = 0; i < vertexCount; i++) adjacencyOffsets[i + 1] = adjacencyOffsets[i] + liveTriangles[i];
+    std::vector<uint32_t> adjacency(local.size());
+    {
+        std::vector<uint32_t> fill(adjacencyOffsets.begin(), adjacencyOffsets.end() - 1);
+        for (uint32_t i = 0; i < local.size(); i++) adjacency[fill[local[i]]++] = i / 3;
+    }
+
+    std::vector<int32_t> cachePositions(vertexCount, -1);
+    std::vector<float> vertexScores(vertexCount);
+    for (uint32_t i = 0; i < vertexCount; i++) vertexScores[i] = VertexScore(-1, liveTriangles[i]);
+
+    std::vector<float> triangleScores(triangleCount);
+    std::vector<bool> emitted(triangleCount, false);
+    for (uint32_t i = 0; i < triangleCount; i++) {
+        const uint32_t *t = &local[i * 3];
+        triangleScores[i] = vertexScores[t[0]] + vertexScores[t[1]] + vertexScores[t[2]];
+    }
+
+    std::vector<uint32_t> result;
+    result.reserve(indices.size());
+    std::vector<uint32_t> cache, nextCache;
+    cache.reserve(cacheSize + 3);
+    nextCache.reserve(cacheSize + 3);
+
+    uint32_t bestTriangle = 0;
+    float bestScore = triangleScores[0];
+    for (uint32_t i = 1; i < triangleCount; i++)
+        if (triangleScores[i] > bestScore) bestTriangle = i, bestScore = triangleScores[i];
+
+    uint32_t scanStart = 0;
+    while (true) {
+        emitted[bestTriangle] = true;
+        const uint32_t *triangle = &local[bestTriangle * 3];
+        for (int i = 0; i < 3; i++) result.push_back(sortedVertices[triangle[i]]);
+
+        // Emitted triangle's vertices go to the front of the LRU cache.
+        nextCache.assign(triangle, triangle + 3);
+        for (uint32_t vertex : cache)
+            if (vertex != triangle[0] && vertex != triangle[1] && vertex != triangle[2]) nextCache.push_back(vertex);
+        for (int i = 0; i < 3; i++) {
+            uint32_t vertex = triangle[i];
+            uint32_t *begin = &adjacency[adjacencyOffsets[vertex]];
+            uint32_t *end = begin + liveTriangles[vertex];
+            std::swap(*std::find(begin, end, bestTriangle), *(end - 1));
+            liveTriangles[vertex]--;
+        }
+        std::swap(cache, nextCache);
+
+        // Rescore vertices in the cache, the ones pushed out of it lose their cache bonus.
+        for (uint32_t i = 0; i < cache.size(); i++) {
+            uint32_t vertex = cache[i];
+            cachePositions[vertex] = i < cacheSize ? i : -1;
+            vertexScores[vertex] = VertexScore(cachePositions[vertex], liveTriangles[vertex]);
+        }
+
+        bestScore = -1.0f;
+        for (uint32_t vertex : cache)
+            for (uint32_t j = 0; j < liveTriangles[vertex]; j++) {
+                uint32_t candidate = adjacency[adjacencyOffsets[vertex] + j];
+                const uint32_t *t = &local[candidate * 3];
+                float score = vertexScores[t[0]] + vertexScores[t[1]] + vertexScores[t[2]];
+                triangleScores[candidate] = score;
+                if (score > bestScore || (score == bestScore && candidate < bestTriangle))
+                    bestTriangle = candidate, bestScore = score;
+            }
+        if (cache.size() > cacheSize) cache.resize(cacheSize);
+
+        if (bestScore < 0.0f) {
+            // Nothing adjacent to the cache is left, continue with the next triangle in input order.
+            while (scanStart < triangleCount && emitted[scanStart]) scanStart++;
+            if (scanStart == triangleCount) break;
+            bestTriangle = scanStart;
+        }
+    }
+
+    std::copy(result.begin(), result.end(), indices.begin());
+}
+
+void RunChunks(uint32_t chunkCount, uint32_t threadCount, auto &&job) {
+    threadCount = std::min(threadCount, chunkCount);
+    if (threadCount <= 1) {
+        for (uint32_t i = 0; i < chunkCount; i++) job(i);
+        return;
+    }
+
+    std::atomic<uint32_t> next = 0;
+    std::vector<std::thread> threads;
+    threads.reserve(threadCount);
+    for (uint32_t t = 0; t < threadCount; t++)
+        threads.emplace_back([&]() {
+            for (uint32_t i = next++; i < chunkCount; i = next++) job(i);
+        });
+    for (auto &&thread : threads) thread.join();
+}
+} // namespace
+
+void MeshOptimizer::OptimizeVertexCache(Span<uint32_t> indices, uint32_t vertexCount, uint32_t threadCount) {
+    assert(indices.size() % 3 == 0);
+    assert(std::all_of(indices.begin(), indices.end(), [=](uint32_t index) { return index < vertexCount; }));
+
+    uint32_t triangleCount = indices.size() / 3;
+    uint32_t chunkCount = (triangleCount + chunkTriangleCount - 1) / chunkTriangleCount;
+    if (chunkCount <= 1) {
+        OptimizeChunk(indices);
+        return;
+    }
+
+    // Split by the smallest vertex of each triangle rather than by input order, vertex order of most meshes is
+    // spatially coherent even if triangle order is not, so chunks stay connected.
+    std::vector<uint32_t> chunkOffsets(chunkCount + 1, 0);
+    std::vector<uint32_t> chunkOfTriangle(triangleCount);
+    for (uint32_t i = 0; i < triangleCount; i++) {
+        uint32_t minVertex = std::min({indices[i * 3], indices[i * 3 + 1], indices[i * 3 + 2]});
+        chunkOfTriangle[i] = (uint64_t)minVertex * chunkCount / vertexCount;
+        chunkOffsets[chunkOfTriangle[i] + 1]++;
+    }
+    for (uint32_t i = 0; i < chunkCount; i++) chunkOffsets[i + 1] += chunkOffsets[i];
+
+    std::vector<uint32_t> partitioned(indices.size());
+    {
+        std::vector<uint32_t> fill(chunkOffsets.begin(), chunkOffsets.end() - 1);
+        for (uint32_t i = 0; i < triangleCount; i++)
+            std::copy_n(&indices[i * 3], 3, &partitioned[fill[chunkOfTriangle[i]]++ * 3]);
+    }
+
+    RunChunks(chunkCount, threadCount, [&](uint32_t chunk) {
+        uint32_t first = chunkOffsets[chunk], count = chunkOffsets[chunk + 1] - first;
+        OptimizeChunk(Span<uint32_t>(partitioned.data() + first * 3, count * 3));
+    });
+    std::copy(partitioned.begin(), partitioned.end(), indices.begin());
+}
+
+uint32_t MeshOptimizer::OptimizeVertexFetch(Span<uint32_t> indices, Span<char> vertices, uint32_t stride) {
+    assert(stride > 0 && vertices.size() % stride == 0);
+    uint32_t vertexCount = vertices.size() / stride;
+
+    std::vector<uint32_t> remap(vertexCount, ~0U);
+    uint32_t newVertexCount = 0;
+    for (auto &&index : indices) {
+        assert(index < vertexCount);
+        if (remap[index] == ~0U) remap[index] = newVertexCount++;
+        index = remap[index];
+    }
+
+    std::vector<char> reordered(newVertexCount * stride);
+    for (uint32_t i = 0; i < vertexCount; i++)
+        if (remap[i] != ~0U) std::memcpy(&reordered[remap[i] * stride], &vertices[i * stride], stride);
+    std::memcpy(vertices.data(), reordered.data(), reordered.size());
+
+    return newVertexCount;
+}
+
+void MeshOptimizer::Optimize(std::vector<uint32_t> &indices, std::vector<char> &vertices, uint32_t stride) {
+    OptimizeVertexCache(indices, vertices.size() / stride);
+    vertices.resize(OptimizeVertexFetch(indices, vertices, stride) * stride);
+}
+
+std::vector<uint32_t> MeshOptimizer::Simplify(
+    Span<const uint32_t> indices, Span<const char> vertices, uint32_t stride, uint32_t positionOffset,
+    uint32_t targetIndexCount
+) {
+    assert(indices.size() % 3 == 0 && stride > 0 && positionOffset + 3 * sizeof(float) <= stride);
+    if (indices.size() <= targetIndexCount) return std::vector<uint32_t>(indices.begin(), indices.end());
+
+    uint32_t vertexCount = vertices.size() / stride;
+    std::vector<float> positions(vertexCount * 3);
+    for (uint32_t i = 0; i < vertexCount; i++)
+        std::memcpy(&positions[i * 3], &vertices[i * stride + positionOffset], 3 * sizeof(float));
+
+    float min[3] = {INFINITY, INFINITY, INFINITY}, max[3] = {-INFINITY, -INFINITY, -INFINITY};
+    for (uint32_t index : indices)
+        for (int j = 0; j < 3; j++) {
+            min[j] = std::min(min[j], positions[index * 3 + j]);
+            max[j] = std::max(max[j], positions[index * 3 + j]);
+        }
+    float extent = std::max({max[0] - min[0], max[1] - min[1], max[2] - min[2], 1e-20f});
+
+    auto cluster = [&](uint32_t gridSize) {
+        auto cell = [&](uint32_t vertex) {
+            uint64_t key = 0;
+            for (int j = 0; j < 3; j++) {
+                float t = (positions[vertex * 3 + j] - min[j]) / extent * gridSize;
+                key = key * (gridSize + 1) + std::clamp<int64_t>((int64_t)t, 0, gridSize - 1);
+            }
+            return key;
+        };
+
+        // Cells are sorted so the choice of representatives doesn't depend on hashing.
+        std::vector<std::pair<uint64_t, uint32_t>> cells;
+        cells.reserve(vertexCount);
+        std::vector<bool> used(vertexCount, false);
+        for (uint32_t index : indices)
+            if (!used[index]) used[index] = true, cells.push_back({cell(index), index});
+        std::sort(cells.begin(), cells.end());
+
+        std::vector<uint32_t> representative(vertexCount, ~0U);
+        for (size_t begin = 0, end; begin < cells.size(); begin = end) {
+            double centroid[3] = {0, 0, 0};
+            for (end = begin; end < cells.size() && cells[end].first == cells[begin].first; end++)
+                for (int j = 0; j < 3; j++) centroid[j] += positions[cells[end].second * 3 + j];
+            for (int j = 0; j < 3; j++) centroid[j] /= end - begin;
+
+            uint32_t best = cells[begin].second;
+            double bestDistance = INFINITY;
+            for (size_t i = begin; i < end; i++) {
+                double distance = 0;
+                for (int j = 0; j < 3; j++) {
+                    double d = positions[cells[i].second * 3 + j] - centroid[j];
+                    distance += d * d;
+                }
+                if (distance < bestDistance) best = cells[i].second, bestDistance = distance;
+            }
+            for (size_t i = begin; i < end; i++) representative[cells[i].second] = best;
+        }
+
+        // Drop triangles collapsed to lines or points, then duplicates of earlier triangles.
+        std::vector<std::array<uint32_t, 4>> triangles;
+        for (size_t i = 0; i < indices.size(); i += 3) {
+            uint32_t a = representative[indices[i]], b = representative[indices[i + 1]];
+            uint32_t c = representative[indices[i + 2]];
+            if (a == b || b == c || a == c) continue;
+
+            // Rotate the smallest index first, winding stays the same.
+            while (a > b || a > c) std::tie(a, b, c) = std::make_tuple(b, c, a);
+            triangles.push_back({a, b, c, (uint32_t)i});
+        }
+        std::sort(triangles.begin(), triangles.end());
+        triangles.erase(
+            std::unique(
+                triangles.begin(), triangles.end(),
+                [](const auto &l, const auto &r) { return l[0] == r[0] && l[1] == r[1] && l[2] == r[2]; }
+            ),
+            triangles.end()
+        );
+        std::sort(triangles.begin(), triangles.end(), [](const auto &l, const auto &r) { return l[3] < r[3]; });
+
+        std::vector<uint32_t> result;
+        result.reserve(triangles.size() * 3);
+        for (auto &&triangle : triangles) result.insert(result.end(), {triangle[0], triangle[1], triangle[2]});
+        return result;
+    };
+
+    // Finest grid that meets the target, the index count grows with the grid size in practice.
+    uint32_t low = 1, high = 1024;
+    std::vector<uint32_t> best = cluster(low);
+    while (low < high) {
+        uint32_t middle = (low + high + 1) / 2;
+        std::vector<uint32_t> candidate = cluster(middle);
+        if (candidate.size() <= targetIndexCount) {
+            low = middle;
+            best = std::move(candidate);
+        } else {
+            high = middle - 1;
+        }
+    }
+    return best;
+}
+
+MeshOptimizer::VertexCacheStatistics MeshOptimizer::AnalyzeVertexCache(
+    Span<const uint32_t> indices, uint32_t vertexCount, uint32_t cacheSize
+) {
+    assert(cacheSize > 0);
+
+    // Timestamps instead of an explicit queue, a vertex is cached if it entered less than cacheSize misses ago.
+    std::vector<uint32_t> entered(vertexCount, 0);
+    uint32_t misses = 0;
+    for (uint32_t index : indices)
+        if (entered[index] == 0 || misses - entered[index] + 1 > cacheSize) entered[index] = ++misses;
+
+    VertexCacheStatistics statistics;
+    statistics.misses = misses;
+    statistics.acmr = indices.empty() ? 0.0f : misses / float(indices.size() / 3);
+    statistics.atvr = vertexCount == 0 ? 0.0f : misses / float(vertexCount);
+    return statistics;
+}
+} // namespace vg
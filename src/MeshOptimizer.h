@@ -0,0 +1,88 @@
+#pragma once
+#include <algorithm>
+#include <cstdint>
+#include <thread>
+#include <vector>
+#include "Span.h"
+
+namespace vg {
+/**
+ *@brief CPU side mesh optimizations run before meshes are uploaded, e.g. into a \ref MeshPool
+ * All functions are deterministic, results don't depend on the thread count.
+ */
+class MeshOptimizer {
+  public:
+    struct VertexCacheStatistics {
+        /**
+         *@brief Average cache miss ratio, transformed vertices per triangle, between 0.5 and 3
+         */
+        float acmr;
+        /**
+         *@brief Average transform to vertex ratio, transformed vertices per vertex, 1 is optimal
+         */
+        float atvr;
+        uint32_t misses;
+    };
+
+  public:
+    /**
+     *@brief Reorder triangles for post transform vertex cache locality in place
+     * Uses Forsyth's linear speed algorithm. Large meshes are split into chunks by vertex index ranges that are
+     * optimized on separate threads, the split doesn't depend on the thread count.
+     *
+     * @param indices Triangle list indices
+     * @param vertexCount Count of vertices indices refer to
+     * @param threadCount Count of threads used for large meshes
+     */
+    static void OptimizeVertexCache(
+        Span<uint32_t> indices, uint32_t vertexCount,
+        uint32_t threadCount = std::max(std::thread::hardware_concurrency(), 1U)
+    );
+
+    /**
+     *@brief Reorder vertices in order of first use by indices and drop unused ones, indices are remapped in place
+     *
+     * @param indices Triangle list indices, usually already optimized for the vertex cache
+     * @param vertices Vertex data, reordered in place
+     * @param stride Size of a vertex in bytes
+     * @return Count of vertices left at the start of vertices
+     */
+    static uint32_t OptimizeVertexFetch(Span<uint32_t> indices, Span<char> vertices, uint32_t stride);
+
+    /**
+     *@brief Optimize vertex cache then vertex fetch, vertices are resized to the vertices left
+     * The results can be uploaded with \ref MeshPool::Add(), which narrows indices for 16 bit pools.
+     */
+    static void Optimize(std::vector<uint32_t> &indices, std::vector<char> &vertices, uint32_t stride);
+
+    /**
+     *@brief Generate indices of a simplified mesh by vertex clustering
+     * Vertices are snapped to a uniform grid and every cell is represented by the vertex closest to the cell's
+     * centroid. The finest grid whose result fits into targetIndexCount is chosen. Returned indices refer to the
+     * original vertices, so LODs can share one vertex range.
+     *
+     * @param indices Triangle list indices
+     * @param vertices Vertex data
+     * @param stride Size of a vertex in bytes
+     * @param positionOffset Offset in bytes of three float position in a vertex
+     * @param targetIndexCount Maximal count of indices returned
+     */
+    static std::vector<uint32_t> Simplify(
+        Span<const uint32_t> indices, Span<const char> vertices, uint32_t stride, uint32_t positionOffset,
+        uint32_t targetIndexCount
+    );
+
+    /**
+     *@brief Simulate a FIFO post transform cache
+     */
+    static VertexCacheStatistics AnalyzeVertexCache(
+        Span<const uint32_t> indices, uint32_t vertexCount, uint32_t cacheSize = 16
+    );
+
+  public:
+    /**
+     *@brief Average count of triangles optimized together, larger meshes are split
+     */
+    static constexpr uint32_t chunkTriangleCount = 1 << 16;
+};
+} // namespace vg
@@ -0,0 +1,190 @@
+#include <vulkan/vulkan.hpp>
+#include "MeshPool.h"
+#include "MemoryManager.h"
+#include <cstring>
+
+namespace vg {
+MeshPool::Ranges::Ranges(uint32_t capacity) : m_freeCount(capacity) {
+    if (capacity > 0) m_free[0] = capacity;
+}
+
+uint32_t MeshPool::Ranges::Allocate(uint32_t count) {
+    if (count == 0) return 0;
+
+    auto best = m_free.end();
+    for (auto it = m_free.begin(); it != m_free.end(); it++)
+        if (it->second >= count && (best == m_free.end() || it->second < best->second)) best = it;
+    if (best == m_free.end()) return ~0U;
+
+    auto [offset, size] = *best;
+    m_free.erase(best);
+    if (size > count) m_free[offset + count] = size - count;
+    m_freeCount -= count;
+    return offset;
+}
+
+void MeshPool::Ranges::Free(uint32_t offset, uint32_t count) {
+    if (count == 0) return;
+    m_freeCount += count;
+
+    // Merge with the free ranges right after and right before.
+    auto next = m_free.lower_bound(offset);
+    if (next != m_free.end() && offset + count == next->first) {
+        count += next->second;
+        next = m_free.erase(next);
+    }
+    if (next != m_free.begin()) {
+        auto previous = std::prev(next);
+        if (previous->first + previous->second == offset) {
+            previous->second += count;
+            return;
+        }
+    }
+    m_free[offset] = count;
+}
+
+uint32_t MeshPool::Ranges::GetFreeCount() const { return m_freeCount; }
+
+MeshPool::MeshPool(
+    uint32_t vertexStride, uint32_t vertexCapacity, uint32_t indexCapacity, IndexType indexType,
+    Flags<BufferUsage> usage
+)
+    : m_vertexStride(vertexStride), m_indexType(indexType), m_vertexRanges(vertexCapacity),
+      m_indexRanges(indexCapacity), m_meshCount(0) {
+    assert(vertexStride > 0 && vertexCapacity > 0 && indexCapacity > 0);
+    assert(indexType == IndexType::Uint16 || indexType == IndexType::Uint32);
+
+    m_vertices = Buffer(
+        (uint64_t)vertexCapacity * vertexStride, usage | BufferUsage::VertexBuffer | BufferUsage::TransferDst
+    );
+    m_indices = Buffer(
+        (uint64_t)indexCapacity * GetIndexSize(), usage | BufferUsage::IndexBuffer | BufferUsage::TransferDst
+    );
+    vg::Allocate({&m_vertices, &m_indices}, {MemoryProperty::DeviceLocal});
+}
+
+MeshPool::MeshPool() : m_vertexStride(0), m_indexType(IndexType::Uint32), m_meshCount(0) {}
+
+MeshPool::MeshPool(MeshPool &&other) noexcept : MeshPool() { *this = std::move(other); }
+
+MeshPool &MeshPool::operator=(MeshPool &&other) noexcept {
+    if (&other == this) return *this;
+
+    std::swap(m_vertexStride, other.m_vertexStride);
+    std::swap(m_indexType, other.m_indexType);
+    std::swap(m_vertices, other.m_vertices);
+    std::swap(m_indices, other.m_indices);
+    std::swap(m_vertexRanges, other.m_vertexRanges);
+    std::swap(m_indexRanges, other.m_indexRanges);
+    std::swap(m_meshCount, other.m_meshCount);
+    std::swap(m_staging, other.m_staging);
+    std::swap(m_uploads, other.m_uploads);
+
+    return *this;
+}
+
+Mesh MeshPool::Allocate(uint32_t vertexCount, uint32_t indexCount) {
+    Mesh mesh;
+    mesh.vertexCount = vertexCount;
+    mesh.indexCount = indexCount;
+
+    mesh.vertexOffset = m_vertexRanges.Allocate(vertexCount);
+    if (mesh.vertexOffset == ~0U) throw std::runtime_error("Mesh pool is out of vertex space");
+
+    mesh.firstIndex = m_indexRanges.Allocate(indexCount);
+    if (mesh.firstIndex == ~0U) {
+        m_vertexRanges.Free(mesh.vertexOffset, vertexCount);
+        throw std::runtime_error("Mesh pool is out of index space");
+    }
+
+    m_meshCount++;
+    return mesh;
+}
+
+Mesh MeshPool::Add(Span<const char> vertices, Span<const char> indices) {
+    assert(vertices.size() % m_vertexStride == 0 && indices.size() % GetIndexSize() == 0);
+
+    Mesh mesh = Allocate(vertices.size() / m_vertexStride, indices.size() / GetIndexSize());
+
+    auto queue = [this](Span<const char> data, uint64_t dstOffset, bool index) {
+        if (data.empty()) return;
+
+        // Keep staging offsets 4 byte aligned, copies of 16 bit indices would otherwise be misaligned.
+        uint64_t stagingOffset = (m_staging.size() + 3) & ~3ULL;
+        m_staging.resize(stagingOffset + data.size());
+        std::memcpy(m_staging.data() + stagingOffset, data.data(), data.size());
+        m_uploads.push_back({stagingOffset, dstOffset, data.size(), index});
+    };
+    queue(vertices, (uint64_t)mesh.vertexOffset * m_vertexStride, false);
+    queue(indices, (uint64_t)mesh.firstIndex * GetIndexSize(), true);
+
+    return mesh;
+}
+
+Mesh MeshPool::Add(Span<const char> vertices, Span<const uint32_t> indices) {
+    if (m_indexType == IndexType::Uint32)
+        return Add(vertices, Span<const char>((const char *)indices.data(), indices.size_bytes()));
+
+    std::vector<uint16_t> narrowed(indices.size());
+    for (size_t i = 0; i < indices.size(); i++) {
+        if (indices[i] > UINT16_MAX) throw std::out_of_range("Index doesn't fit into 16 bit indices of the mesh pool");
+        narrowed[i] = indices[i];
+    }
+    return Add(vertices, Span<const char>((const char *)narrowed.data(), narrowed.size() * sizeof(uint16_t)));
+}
+
+void MeshPool::Free(const Mesh &mesh) {
+    assert(m_meshCount > 0);
+
+    m_vertexRanges.Free(mesh.vertexOffset, mesh.vertexCount);
+    m_indexRanges.Free(mesh.firstIndex, mesh.indexCount);
+    m_meshCount--;
+}
+
+void MeshPool::Flush(const Queue &queue) {
+    if (m_uploads.empty()) return;
+
+    Buffer staging(m_staging.size(), {BufferUsage::TransferSrc});
+    vg::Allocate({&staging}, {MemoryProperty::HostVisible, MemoryProperty::HostCoherent});
+    std::memcpy(staging.MapMemory(), m_staging.data(), m_staging.size());
+
+    cmd::CopyBuffer vertexCopy, indexCopy;
+    vertexCopy.src = indexCopy.src = staging;
+    vertexCopy.dst = m_vertices;
+    indexCopy.dst = m_indices;
+    for (auto &&upload : m_uploads)
+        (upload.index ? indexCopy : vertexCopy)
+            .regions.push_back(BufferCopyRegion(upload.size, upload.stagingOffset, upload.dstOffset));
+
+    CmdBuffer cmdBuffer(queue);
+    cmdBuffer.Begin();
+    if (!vertexCopy.regions.empty()) cmdBuffer.Append(vertexCopy);
+    if (!indexCopy.regions.empty()) cmdBuffer.Append(indexCopy);
+    cmdBuffer.End().Submit().Await();
+
+    m_staging.clear();
+    m_uploads.clear();
+}
+
+std::tuple<cmd::BindVertexBuffers, cmd::BindIndexBuffer> MeshPool::Bind(uint32_t binding) const {
+    return {
+        cmd::BindVertexBuffers((BufferHandle)m_vertices, 0, binding), cmd::BindIndexBuffer(m_indices, 0, m_indexType)
+    };
+}
+
+const Buffer &MeshPool::GetVertexBuffer() const { return m_vertices; }
+
+const Buffer &MeshPool::GetIndexBuffer() const { return m_indices; }
+
+IndexType MeshPool::GetIndexType() const { return m_indexType; }
+
+uint32_t MeshPool::GetIndexSize() const { return m_indexType == IndexType::Uint16 ? 2 : 4; }
+
+uint32_t MeshPool::GetVertexStride() const { return m_vertexStride; }
+
+uint32_t MeshPool::GetFreeVertexCount() const { return m_vertexRanges.GetFreeCount(); }
+
+uint32_t MeshPool::GetFreeIndexCount() const { return m_indexRanges.GetFreeCount(); }
+
+uint32_t MeshPool::GetMeshCount() const { return m_meshCount; }
+} // namespace vg
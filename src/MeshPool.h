@@ -0,0 +1,154 @@
+#pragma once
+#include <map>
+#include <tuple>
+#include <vector>
+#include "Handle.h"
+#include "Buffer.h"
+#include "CmdBuffer.h"
+#include "Queue.h"
+#include "Structs.h"
+#include "Span.h"
+
+namespace vg {
+/**
+ *@brief Range of a mesh inside a \ref MeshPool
+ */
+struct Mesh {
+    uint32_t vertexOffset = 0;
+    uint32_t vertexCount = 0;
+    uint32_t firstIndex = 0;
+    uint32_t indexCount = 0;
+
+    cmd::DrawIndexed Draw(uint32_t instanceCount = 1, uint32_t firstInstance = 0) const {
+        return cmd::DrawIndexed(indexCount, instanceCount, firstIndex, vertexOffset, firstInstance);
+    }
+    DrawIndexedIndirectCommand DrawCommand(uint32_t instanceCount = 1, uint32_t firstInstance = 0) const {
+        return DrawIndexedIndirectCommand(indexCount, instanceCount, firstIndex, vertexOffset, firstInstance);
+    }
+};
+
+/**
+ *@brief Suballocates meshes from one shared device local vertex buffer and one shared index buffer
+ * Meshes are ranges of the two buffers, so a whole scene is drawn after a single \ref MeshPool::Bind(), which also
+ * makes it ready for indirect and multi draws. Ranges are managed by a best fit free list that merges neighbouring
+ * free ranges. Uploads are batched and copied with one command per buffer on \ref MeshPool::Flush().
+ */
+class MeshPool {
+  public:
+    /**
+     *@brief Construct a new Mesh Pool object
+     *
+     * @param vertexStride Size in bytes of a vertex, all meshes in the pool share the vertex layout
+     * @param vertexCapacity Count of vertices the pool can hold
+     * @param indexCapacity Count of indices the pool can hold
+     * @param indexType Uint16 or Uint32
+     * @param usage Usage added to both buffers, e.g. BufferUsage::StorageBuffer to read them from shaders
+     */
+    MeshPool(
+        uint32_t vertexStride, uint32_t vertexCapacity, uint32_t indexCapacity, IndexType indexType = IndexType::Uint32,
+        Flags<BufferUsage> usage = {}
+    );
+
+    MeshPool();
+    MeshPool(MeshPool &&other) noexcept;
+    MeshPool(const MeshPool &other) = delete;
+    ~MeshPool() = default;
+
+    MeshPool &operator=(MeshPool &&other) noexcept;
+    MeshPool &operator=(const MeshPool &other) = delete;
+
+    /**
+     *@brief Reserve ranges for a mesh without uploading anything, throws std::runtime_error if the pool is full
+     */
+    Mesh Allocate(uint32_t vertexCount, uint32_t indexCount);
+
+    /**
+     *@brief Reserve ranges for a mesh and queue upload of its data, throws std::runtime_error if the pool is full
+     *
+     * @param vertices Vertex data, vertexStride bytes per vertex
+     * @param indices Index data, 2 or 4 bytes per index depending on index type
+     */
+    Mesh Add(Span<const char> vertices, Span<const char> indices);
+
+    /**
+     *@brief Reserve ranges for a mesh with 32 bit indices and queue upload of its data
+     * Takes the output of \ref MeshOptimizer::Optimize() as is, indices are narrowed for a Uint16 pool.
+     *
+     * @param vertices Vertex data, vertexStride bytes per vertex
+     * @param indices Index data, throws std::out_of_range if an index doesn't fit the index type of the pool
+     */
+    Mesh Add(Span<const char> vertices, Span<const uint32_t> indices);
+
+    template <typename V, typename I> Mesh Add(Span<const V> vertices, Span<const I> indices) {
+        assert(sizeof(V) == m_vertexStride && sizeof(I) == GetIndexSize());
+        return Add(
+            Span<const char>((const char *)vertices.data(), vertices.size_bytes()),
+            Span<const char>((const char *)indices.data(), indices.size_bytes())
+        );
+    }
+
+    /**
+     *@brief Return ranges of the mesh to the pool, the caller has to make sure the GPU no longer uses them
+     */
+    void Free(const Mesh &mesh);
+
+    /**
+     *@brief Upload all queued mesh data and block until it is copied
+     *
+     * @param queue Queue supporting transfer operations
+     */
+    void Flush(const Queue &queue);
+
+    /**
+     *@brief Commands binding the shared vertex and index buffers
+     *
+     * @param binding Vertex input binding of the vertex buffer
+     */
+    std::tuple<cmd::BindVertexBuffers, cmd::BindIndexBuffer> Bind(uint32_t binding = 0) const;
+
+    const Buffer &GetVertexBuffer() const;
+    const Buffer &GetIndexBuffer() const;
+    IndexType GetIndexType() const;
+    uint32_t GetIndexSize() const;
+    uint32_t GetVertexStride() const;
+    uint32_t GetFreeVertexCount() const;
+    uint32_t GetFreeIndexCount() const;
+    uint32_t GetMeshCount() const;
+
+  private:
+    class Ranges {
+      public:
+        Ranges(uint32_t capacity = 0);
+
+        /**
+         *@brief Take the smallest free range that fits, ~0U if none does
+         */
+        uint32_t Allocate(uint32_t count);
+        void Free(uint32_t offset, uint32_t count);
+        uint32_t GetFreeCount() const;
+
+      private:
+        std::map<uint32_t, uint32_t> m_free;
+        uint32_t m_freeCount;
+    };
+
+    struct Upload {
+        uint64_t stagingOffset;
+        uint64_t dstOffset;
+        uint64_t size;
+        bool index;
+    };
+
+  private:
+    uint32_t m_vertexStride;
+    IndexType m_indexType;
+    Buffer m_vertices;
+    Buffer m_indices;
+    Ranges m_vertexRanges;
+    Ranges m_indexRanges;
+    uint32_t m_meshCount;
+
+    std::vector<char> m_staging;
+    std::vector<Upload> m_uploads;
+};
+} // namespace vg
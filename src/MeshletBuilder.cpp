@@ -0,0 +1,177 @@
+#include "MeshletBuilder.h"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstring>
+
+namespace vg {
+namespace {
+// Triangles whose normals deviate from the cone axis by more than about 84 degrees make the cone useless.
+constexpr float minConeDot = 0.1f;
+
+struct Vec3 {
+    float x, y, z;
+
+    Vec3 operator+(const Vec3 &other) const { return {x + other.x, y + other.y, z + other.z}; }
+    Vec3 operator-(const Vec3 &other) const { return {x - other.x, y - other.y, z - other.z}; }
+    Vec3 operator*(float scale) const { return {x * scale, y * scale, z * scale}; }
+    float Dot(const Vec3 &other) const { return x * other.x + y * other.y + z * other.z; }
+    Vec3 Cross(const Vec3 &other) const {
+        return {y * other.z - z * other.y, z * other.x - x * other.z, x * other.y - y * other.x};
+    }
+    float Length() const { return std::sqrt(Dot(*this)); }
+    float operator[](uint32_t axis) const { return axis == 0 ? x : axis == 1 ? y : z; }
+};
+
+Vec3 Position(Span<const char> vertices, uint32_t stride, uint32_t positionOffset, uint32_t index) {
+    Vec3 position;
+    std::memcpy(&position, &vertices[(size_t)index * stride + positionOffset], sizeof(Vec3));
+    return position;
+}
+} // namespace
+
+bool MeshletBounds::IsBackfacing(const float cameraPosition[3]) const {
+    Vec3 view = {coneApex[0] - cameraPosition[0], coneApex[1] - cameraPosition[1], coneApex[2] - cameraPosition[2]};
+    float length = view.Length();
+    return view.Dot({coneAxis[0], coneAxis[1], coneAxis[2]}) >= coneCutoff * length;
+}
+
+MeshletBuilder::MeshletBuilder(uint32_t maxVertices, uint32_t maxTriangles)
+    : m_maxVertices(maxVertices), m_maxTriangles(maxTriangles) {
+    assert(maxVertices >= 3 && maxVertices <= 256 && maxTriangles >= 1);
+}
+
+Meshlets MeshletBuilder::Build(
+    Span<const uint32_t> indices, Span<const char> vertices, uint32_t stride, uint32_t positionOffset
+) const {
+    assert(indices.size() % 3 == 0 && stride > 0 && positionOffset + 3 * sizeof(float) <= stride);
+    uint32_t vertexCount = vertices.size() / stride;
+
+    Meshlets result;
+    size_t triangleCount = indices.size() / 3;
+    size_t meshletEstimate = triangleCount / m_maxTriangles + 1;
+    result.meshlets.reserve(meshletEstimate);
+    result.vertices.reserve(std::min(indices.size(), meshletEstimate * m_maxVertices));
+    result.triangles.reserve(indices.size() + meshletEstimate * 3);
+
+    // Local index of every vertex in the current meshlet, reset for the meshlet's vertices when it's finished.
+    std::vector<uint8_t> localIndices(vertexCount);
+    std::vector<bool> inMeshlet(vertexCount, false);
+    Meshlet current = {0, 0, 0, 0};
+
+    auto finish = [&]() {
+        if (current.triangleCount == 0) return;
+        for (uint32_t i = 0; i < current.vertexCount; i++) inMeshlet[result.vertices[current.vertexOffset + i]] = false;
+        result.triangles.resize((result.triangles.size() + 3) & ~size_t(3));
+        result.meshlets.push_back(current);
+        current = {(uint32_t)result.vertices.size(), (uint32_t)result.triangles.size(), 0, 0};
+    };
+
+    for (size_t triangle = 0; triangle < triangleCount; triangle++) {
+        const uint32_t *corners = &indices[triangle * 3];
+        assert(corners[0] < vertexCount && corners[1] < vertexCount && corners[2] < vertexCount);
+
+        uint32_t newVertices = 0;
+        for (uint32_t i = 0; i < 3; i++)
+            if (!inMeshlet[corners[i]] && (i < 1 || corners[i] != corners[0]) && (i < 2 || corners[i] != corners[1]))
+                newVertices++;
+        if (current.vertexCount + newVertices > m_maxVertices || current.triangleCount == m_maxTriangles) finish();
+
+        for (uint32_t i = 0; i < 3; i++) {
+            uint32_t vertex = corners[i];
+            if (!inMeshlet[vertex]) {
+                inMeshlet[vertex] = true;
+                localIndices[vertex] = current.vertexCount++;
+                result.vertices.push_back(vertex);
+            }
+            result.triangles.push_back(localIndices[vertex]);
+        }
+        current.triangleCount++;
+    }
+    finish();
+
+    result.bounds.resize(result.meshlets.size());
+    for (size_t i = 0; i < result.meshlets.size(); i++)
+        result.bounds[i] = ComputeBounds(result, result.meshlets[i], vertices, stride, positionOffset);
+
+    return result;
+}
+
+uint32_t MeshletBuilder::GetMaxVertices() const { return m_maxVertices; }
+uint32_t MeshletBuilder::GetMaxTriangles() const { return m_maxTriangles; }
+
+MeshletBounds MeshletBuilder::ComputeBounds(
+    const Meshlets &meshlets, const Meshlet &meshlet, Span<const char> vertices, uint32_t stride,
+    uint32_t positionOffset
+) {
+    std::vector<Vec3> points(meshlet.vertexCount);
+    for (uint32_t i = 0; i < meshlet.vertexCount; i++)
+        points[i] = Position(vertices, stride, positionOffset, meshlets.vertices[meshlet.vertexOffset + i]);
+
+    // Ritter's bounding sphere, starting from the most distant pair of axis extremes.
+    uint32_t extremes[3][2] = {};
+    for (uint32_t i = 0; i < meshlet.vertexCount; i++)
+        for (uint32_t axis = 0; axis < 3; axis++) {
+            if (points[i][axis] < points[extremes[axis][0]][axis]) extremes[axis][0] = i;
+            if (points[i][axis] > points[extremes[axis][1]][axis]) extremes[axis][1] = i;
+        }
+    uint32_t widestAxis = 0;
+    float widest = 0;
+    for (uint32_t axis = 0; axis < 3; axis++) {
+        float distance = (points[extremes[axis][1]] - points[extremes[axis][0]]).Length();
+        if (distance > widest) widest = distance, widestAxis = axis;
+    }
+    Vec3 center = (points[extremes[widestAxis][0]] + points[extremes[widestAxis][1]]) * 0.5f;
+    float radius = widest * 0.5f;
+    for (const Vec3 &point : points) {
+        Vec3 offset = point - center;
+        float distance = offset.Length();
+        if (distance <= radius) continue;
+        float grownRadius = (radius + distance) * 0.5f;
+        center = center + offset * ((grownRadius - radius) / distance);
+        radius = grownRadius;
+    }
+
+    MeshletBounds bounds = {};
+    bounds.center[0] = center.x, bounds.center[1] = center.y, bounds.center[2] = center.z;
+    bounds.radius = radius;
+    bounds.coneApex[0] = center.x, bounds.coneApex[1] = center.y, bounds.coneApex[2] = center.z;
+    bounds.coneCutoff = 2.0f;
+
+    // The cone axis is the average of triangle normals, the cutoff comes from the normal deviating the most.
+    std::vector<Vec3> normals(meshlet.triangleCount);
+    std::vector<Vec3> corners(meshlet.triangleCount);
+    Vec3 axis = {0, 0, 0};
+    for (uint32_t i = 0; i < meshlet.triangleCount; i++) {
+        const uint8_t *triangle = &meshlets.triangles[meshlet.triangleOffset + i * 3];
+        Vec3 a = points[triangle[0]], b = points[triangle[1]], c = points[triangle[2]];
+        Vec3 normal = (b - a).Cross(c - a);
+        float length = normal.Length();
+        normals[i] = length > 0 ? normal * (1.0f / length) : Vec3{0, 0, 0};
+        corners[i] = a;
+        axis = axis + normals[i];
+    }
+    float axisLength = axis.Length();
+    if (axisLength == 0) return bounds;
+    axis = axis * (1.0f / axisLength);
+
+    float minDot = 1.0f;
+    for (const Vec3 &normal : normals)
+        if (normal.Dot(normal) > 0) minDot = std::min(minDot, normal.Dot(axis));
+    if (minDot <= minConeDot) return bounds;
+
+    // Apex is moved back along the axis until it's behind every triangle's plane, so the test holds for all of them.
+    float maxDistance = 0;
+    for (uint32_t i = 0; i < meshlet.triangleCount; i++) {
+        if (normals[i].Dot(normals[i]) == 0) continue;
+        float distance = (center - corners[i]).Dot(normals[i]) / axis.Dot(normals[i]);
+        maxDistance = std::max(maxDistance, distance);
+    }
+    Vec3 apex = center - axis * maxDistance;
+
+    bounds.coneApex[0] = apex.x, bounds.coneApex[1] = apex.y, bounds.coneApex[2] = apex.z;
+    bounds.coneAxis[0] = axis.x, bounds.coneAxis[1] = axis.y, bounds.coneAxis[2] = axis.z;
+    bounds.coneCutoff = std::sqrt(1 - minDot * minDot);
+    return bounds;
+}
+} // namespace vg
@@ -0,0 +1,110 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "Span.h"
+
+namespace vg {
+/**
+ *@brief Range of a mesh forming one mesh shader workgroup, layout matches std430 so it can be read by shaders
+ */
+struct Meshlet {
+    /**
+     *@brief Offset into \ref Meshlets::vertices
+     */
+    uint32_t vertexOffset;
+    /**
+     *@brief Offset in bytes into \ref Meshlets::triangles, multiple of 4
+     */
+    uint32_t triangleOffset;
+    uint32_t vertexCount;
+    uint32_t triangleCount;
+};
+
+/**
+ *@brief Bounds used to cull a meshlet before its triangles are processed, layout matches std430
+ * A meshlet is outside the view if its sphere is outside the frustum and all its triangles face away from a camera at
+ * cameraPosition if dot(normalize(coneApex - cameraPosition), coneAxis) >= coneCutoff.
+ */
+struct MeshletBounds {
+    float center[3];
+    float radius;
+    float coneApex[3];
+    /**
+     *@brief Sine of the cone's half angle, greater than 1 if the triangles face too many directions to be culled
+     */
+    float coneCutoff;
+    float coneAxis[3];
+    float padding;
+
+    /**
+     *@brief Check on CPU if all triangles face away from a camera at cameraPosition
+     */
+    bool IsBackfacing(const float cameraPosition[3]) const;
+};
+
+/**
+ *@brief Meshlets of a mesh, meant to be uploaded to storage buffers as they are
+ */
+struct Meshlets {
+    std::vector<Meshlet> meshlets;
+    std::vector<MeshletBounds> bounds;
+    /**
+     *@brief Indices into the mesh's vertices, for each meshlet vertexCount of them starting at vertexOffset
+     */
+    std::vector<uint32_t> vertices;
+    /**
+     *@brief Three indices into the meshlet's vertices per triangle, each meshlet's triangles are padded to 4 bytes
+     */
+    std::vector<uint8_t> triangles;
+};
+
+/**
+ *@brief Splits triangle lists into meshlets for drawing with task and mesh shaders
+ * Triangles are added to a meshlet in order until its vertex or triangle limit is reached, so indices should be
+ * optimized for the vertex cache beforehand, e.g. by \ref MeshOptimizer::OptimizeVertexCache(). Meshlets are drawn
+ * with \ref cmd::DrawMeshTasks, usually one task shader invocation per meshlet culling it with \ref MeshletBounds.
+ */
+class MeshletBuilder {
+  public:
+    /**
+     *@brief Construct a new Meshlet Builder object
+     *
+     * @param maxVertices Maximal count of vertices of a meshlet, at most 256 and the device's maxMeshOutputVertices
+     * @param maxTriangles Maximal count of triangles of a meshlet, within the device's maxMeshOutputPrimitives
+     */
+    MeshletBuilder(uint32_t maxVertices = 64, uint32_t maxTriangles = 124);
+
+    /**
+     *@brief Split a mesh into meshlets and compute their bounds
+     *
+     * @param indices Triangle list indices
+     * @param vertices Vertex data
+     * @param stride Size of a vertex in bytes
+     * @param positionOffset Offset in bytes of three float position in a vertex
+     */
+    Meshlets Build(
+        Span<const uint32_t> indices, Span<const char> vertices, uint32_t stride, uint32_t positionOffset = 0
+    ) const;
+
+    uint32_t GetMaxVertices() const;
+    uint32_t GetMaxTriangles() const;
+
+    /**
+     *@brief Compute bounds of a meshlet
+     *
+     * @param meshlets Meshlets the meshlet is part of
+     * @param meshlet Meshlet the bounds are computed for
+     * @param vertices Vertex data
+     * @param stride Size of a vertex in bytes
+     * @param positionOffset Offset in bytes of three float position in a vertex
+     */
+    static MeshletBounds ComputeBounds(
+        const Meshlets &meshlets, const Meshlet &meshlet, Span<const char> vertices, uint32_t stride,
+        uint32_t positionOffset
+    );
+
+  private:
+    uint32_t m_maxVertices;
+    uint32_t m_maxTriangles;
+};
+} // namespace vg
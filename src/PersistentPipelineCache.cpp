@@ -0,0 +1,112 @@
+#include <vulkan/vulkan.hpp>
+#include "PersistentPipelineCache.h"
+#include "Device.h"
+#include <algorithm>
+#include <cassert>
+#include <filesystem>
+#include <iostream>
+
+namespace vg {
+PersistentPipelineCache::PersistentPipelineCache(const char *directory, std::chrono::seconds saveInterval)
+    : m_path(GetDevicePath(directory)), m_saveInterval(saveInterval), m_lastSave(std::chrono::steady_clock::now()) {
+    std::filesystem::create_directories(directory);
+    m_cache = PipelineCache(m_path.c_str());
+}
+
+PersistentPipelineCache::PersistentPipelineCache() : m_saveInterval(0) {}
+
+PersistentPipelineCache::PersistentPipelineCache(PersistentPipelineCache &&other) noexcept
+    : PersistentPipelineCache() {
+    *this = std::move(other);
+}
+
+PersistentPipelineCache::~PersistentPipelineCache() {
+    if ((PipelineCacheHandle)m_cache == nullptr) return;
+
+    // Handles of thread caches die with this object, so their threads have to be done with them by now.
+    for (auto &&threadCache : m_threadCaches) m_returnedCaches.push_back(std::move(threadCache));
+    m_threadCaches.clear();
+
+    // Destructor must not throw, a failed save only costs a slower next startup.
+    try {
+        Save();
+    } catch (const std::runtime_error &error) {
+        std::cerr << error.what() << '\n';
+    }
+}
+
+PersistentPipelineCache &PersistentPipelineCache::operator=(PersistentPipelineCache &&other) noexcept {
+    if (&other == this) return *this;
+
+    std::swap(m_cache, other.m_cache);
+    std::swap(m_threadCaches, other.m_threadCaches);
+    std::swap(m_returnedCaches, other.m_returnedCaches);
+    std::swap(m_path, other.m_path);
+    std::swap(m_saveInterval, other.m_saveInterval);
+    std::swap(m_lastSave, other.m_lastSave);
+
+    return *this;
+}
+
+PersistentPipelineCache::operator const PipelineCacheHandle &() const { return m_cache; }
+
+PipelineCacheHandle PersistentPipelineCache::CreateThreadCache() {
+    std::lock_guard lock(m_mutex);
+    return m_threadCaches.emplace_back(nullptr, 0, false);
+}
+
+void PersistentPipelineCache::ReturnThreadCache(PipelineCacheHandle threadCache) {
+    std::lock_guard lock(m_mutex);
+    auto it = std::find_if(m_threadCaches.begin(), m_threadCaches.end(), [&](const PipelineCache &cache) {
+        return (PipelineCacheHandle)cache == threadCache;
+    });
+    assert(it != m_threadCaches.end() && "Thread cache wasn't created by this cache");
+    if (it == m_threadCaches.end()) return;
+
+    m_returnedCaches.push_back(std::move(*it));
+    m_threadCaches.erase(it);
+}
+
+void PersistentPipelineCache::Save() {
+    std::vector<PipelineCache> returnedCaches;
+    {
+        std::lock_guard lock(m_mutex);
+        std::swap(returnedCaches, m_returnedCaches);
+    }
+    if (!returnedCaches.empty()) {
+        std::vector<PipelineCacheHandle> threadCaches(returnedCaches.begin(), returnedCaches.end());
+        m_cache.MergeCaches(threadCaches);
+    }
+
+    m_cache.Save(m_path.c_str());
+    m_lastSave = std::chrono::steady_clock::now();
+}
+
+bool PersistentPipelineCache::SaveIfDue() {
+    if (m_saveInterval.count() == 0 || std::chrono::steady_clock::now() - m_lastSave < m_saveInterval) return false;
+
+    Save();
+    return true;
+}
+
+const std::string &PersistentPipelineCache::GetPath() const { return m_path; }
+
+// Lowercase hex of the value, zero padded to at least digitCount digits.
+static std::string ToHex(uint32_t value, size_t digitCount) {
+    std::string hex;
+    for (; value != 0 || hex.size() < digitCount; value >>= 4) hex.insert(hex.begin(), "0123456789abcdef"[value & 0xF]);
+    return hex;
+}
+
+std::string PersistentPipelineCache::GetDevicePath(const char *directory) {
+    DeviceProperties properties = currentDevice->GetProperties();
+
+    std::string uuid;
+    for (uint8_t byte : properties.pipelineCacheUUID) uuid += ToHex(byte, 2);
+
+    std::filesystem::path path(directory);
+    path /= "pipelineCache_" + ToHex(properties.vendorID, 4) + "_" + ToHex(properties.deviceID, 4) + "_" + uuid +
+            ".bin";
+    return path.string();
+}
+} // namespace vg
@@ -0,0 +1,79 @@
+#pragma once
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "Handle.h"
+#include "PipelineCache.h"
+
+namespace vg {
+/**
+ *@brief Pipeline cache kept on disk between runs
+ * The cache file is keyed by vendor, device and pipeline cache UUID of the current device, so caches of different GPUs
+ * or drivers never collide. Each thread can get its own cache, so threads don't contend on the main one. Thread caches
+ * handed back are merged into the main cache on save. Data is saved on destruction and optionally periodically.
+ */
+class PersistentPipelineCache {
+  public:
+    /**
+     *@brief Construct a new Persistent Pipeline Cache object, loads existing cache of the current device if valid
+     *
+     * @param directory Directory holding cache files, created if missing
+     * @param saveInterval Minimal time between saves done by \ref PersistentPipelineCache::SaveIfDue(), zero disables
+     * periodic saving
+     */
+    PersistentPipelineCache(const char *directory, std::chrono::seconds saveInterval = std::chrono::seconds(0));
+
+    PersistentPipelineCache();
+    PersistentPipelineCache(PersistentPipelineCache &&other) noexcept;
+    PersistentPipelineCache(const PersistentPipelineCache &other) = delete;
+    ~PersistentPipelineCache();
+
+    PersistentPipelineCache &operator=(PersistentPipelineCache &&other) noexcept;
+    PersistentPipelineCache &operator=(const PersistentPipelineCache &other) = delete;
+    operator const PipelineCacheHandle &() const;
+
+    /**
+     *@brief Create a cache for use by a single thread, owned by this object
+     * It isn't merged until the thread hands it back with \ref PersistentPipelineCache::ReturnThreadCache(), merging a
+     * cache another thread is creating pipelines with is a race.
+     *
+     * @return Handle to the thread cache
+     */
+    PipelineCacheHandle CreateThreadCache();
+
+    /**
+     *@brief Hand back a thread cache, the owner thread must not use it anymore. It is merged and destroyed on the next
+     * save.
+     */
+    void ReturnThreadCache(PipelineCacheHandle threadCache);
+
+    /**
+     *@brief Merge returned thread caches and write the cache to disk atomically
+     */
+    void Save();
+
+    /**
+     *@brief Save if saveInterval elapsed since the last save, meant to be called once per frame
+     *
+     * @return true if the cache was saved
+     */
+    bool SaveIfDue();
+
+    const std::string &GetPath() const;
+
+    /**
+     *@brief Get path of the cache file of the current device
+     */
+    static std::string GetDevicePath(const char *directory);
+
+  private:
+    PipelineCache m_cache;
+    std::mutex m_mutex;
+    std::vector<PipelineCache> m_threadCaches;
+    std::vector<PipelineCache> m_returnedCaches;
+    std::string m_path;
+    std::chrono::seconds m_saveInterval;
+    std::chrono::steady_clock::time_point m_lastSave;
+};
+} // namespace vg
@@ -3,6 +3,7 @@
 #include "Device.h"
 #include <fstream>
 #include <filesystem>
+#include <cstring>
 
 namespace vg
 {
@@ -17,6 +18,10 @@ namespace vg
             cacheFile.read(cacheData.data(), cacheData.size());
         }
 
+        // Cache from a different driver or device is useless and could be corrupt, start empty instead.
+        if (!cacheData.empty() && !PipelineCache::IsCompatible(cacheData.data(), cacheData.size()))
+            cacheData.clear();
+
         return cacheData;
     }
     PipelineCache::PipelineCache(const void* initialData, uint32_t initialDataSize, bool isExternallySynchronized)
@@ -62,12 +67,25 @@ namespace vg
         return m_handle;
     }
 
-    void* PipelineCache::GetData(uint32_t* dataSize) const
+    std::vector<char> PipelineCache::GetData() const
     {
-        auto result = ((DeviceHandle) *currentDevice).getPipelineCacheData(m_handle, (size_t*) dataSize, nullptr);
-        void* data = new char[*dataSize];
-        auto result2 = ((DeviceHandle) *currentDevice).getPipelineCacheData(m_handle, (size_t*) dataSize, data);
+        DeviceHandle device = *currentDevice;
+        std::vector<char> data;
+        vk::Result result;
+        do
+        {
+            // Cache can grow between the calls while other threads create pipelines, then the query is repeated.
+            size_t size;
+            result = device.getPipelineCacheData(m_handle, &size, nullptr);
+            if (result != vk::Result::eSuccess)
+                break;
+            data.resize(size);
+            result = device.getPipelineCacheData(m_handle, &size, data.data());
+            data.resize(size);
+        } while (result == vk::Result::eIncomplete);
 
+        if (result != vk::Result::eSuccess)
+            throw std::runtime_error("Failed to get pipeline cache data");
         return data;
     }
 
@@ -75,4 +93,43 @@ namespace vg
     {
         ((DeviceHandle) *currentDevice).mergePipelineCaches(m_handle, *(Span<const vk::PipelineCache>*) & caches);
     }
+
+    void PipelineCache::Save(const char* filePath) const
+    {
+        std::vector<char> data = GetData();
+        std::filesystem::path path(filePath);
+        std::filesystem::path tempPath = path;
+        tempPath += ".tmp";
+
+        {
+            std::ofstream file(tempPath, std::ios_base::binary | std::ios_base::out | std::ios_base::trunc);
+            if (!file.write(data.data(), data.size()))
+                throw std::runtime_error("Failed to write pipeline cache: " + tempPath.string());
+        }
+
+        std::error_code error;
+        std::filesystem::rename(tempPath, path, error);
+        if (error)
+        {
+            std::filesystem::remove(tempPath, error);
+            throw std::runtime_error("Failed to replace pipeline cache: " + path.string());
+        }
+    }
+
+    bool PipelineCache::IsCompatible(const void* data, uint64_t dataSize)
+    {
+        if (data == nullptr || dataSize < sizeof(VkPipelineCacheHeaderVersionOne))
+            return false;
+
+        VkPipelineCacheHeaderVersionOne header;
+        std::memcpy(&header, data, sizeof(header));
+        if (header.headerSize < sizeof(header) || header.headerSize > dataSize)
+            return false;
+        if (header.headerVersion != VK_PIPELINE_CACHE_HEADER_VERSION_ONE)
+            return false;
+
+        DeviceProperties properties = currentDevice->GetProperties();
+        return header.vendorID == properties.vendorID && header.deviceID == properties.deviceID &&
+            std::memcmp(header.pipelineCacheUUID, properties.pipelineCacheUUID, VK_UUID_SIZE) == 0;
+    }
 }
\ No newline at end of file
@@ -3,7 +3,6 @@
 #include "Span.h"
 #include <stdint.h>
 #include <vector>
-#include <math.h>
 
 namespace vg
 {
@@ -32,24 +31,26 @@ namespace vg
         PipelineCache& operator=(const PipelineCache& other) = delete;
         operator const PipelineCacheHandle& () const;
 
-        void* GetData(uint32_t* dataSize) const;
-
-        template <typename T = char>
-        std::vector<T> GetData() const
-        {
-            std::vector<T> vec;
-            uint32_t size;
-
-            T* data = (T*) GetData(&size);
-            size = ceil(size / (float) sizeof(T));
-            vec.assign(data, data + size);
-
-            delete[] data;
-            return vec;
-
-        }
+        /**
+         *@brief Get serialized cache data, e.g. to store it for the next run
+         */
+        std::vector<char> GetData() const;
         void MergeCaches(Span<const PipelineCacheHandle> caches);
 
+        /**
+         *@brief Write cache data to a file atomically
+         * Data is written to a temporary file which then replaces filePath, so a crash never leaves a truncated cache.
+         *
+         * @param filePath Path of the cache file
+         */
+        void Save(const char* filePath) const;
+
+        /**
+         *@brief Check if cache data was created by the current device and driver
+         * Validates the VkPipelineCacheHeaderVersionOne header against vendor, device and pipeline cache UUID.
+         */
+        static bool IsCompatible(const void* data, uint64_t dataSize);
+
     private:
         PipelineCacheHandle m_handle;
     };
@@ -0,0 +1,138 @@
+#include <vulkan/vulkan.hpp>
+#include "PipelineCompiler.h"
+#include "Device.h"
+#include "GraphicsPipelineCreateInfo.h"
+#include <stdexcept>
+
+namespace vg {
+// Pipeline creation can succeed with codes like ePipelineCompileRequiredEXT and no pipeline.
+static vk::Pipeline CheckCreated(const vk::ResultValue<vk::Pipeline> &result) {
+    if (result.result != vk::Result::eSuccess)
+        throw std::runtime_error("Failed to create pipeline: " + vk::to_string(result.result));
+    return result.value;
+}
+
+PipelineCompiler::PipelineCompiler(uint32_t threadCount, PipelineCacheHandle cache)
+    : m_activeJobs(0), m_stop(false), m_cache(cache) {
+    assert(threadCount > 0);
+
+    m_workers.reserve(threadCount);
+    for (uint32_t i = 0; i < threadCount; i++) m_workers.emplace_back(&PipelineCompiler::WorkerLoop, this);
+}
+
+PipelineCompiler::~PipelineCompiler() {
+    {
+        std::lock_guard lock(m_mutex);
+        m_stop = true;
+    }
+    m_jobAvailable.notify_all();
+    for (auto &&worker : m_workers) worker.join();
+
+    for (auto &&pipeline : m_pipelines) ((DeviceHandle)*currentDevice).destroyPipeline(pipeline);
+}
+
+std::shared_future<ComputePipelineHandle> PipelineCompiler::Compile(const Shader &shader, PipelineLayoutHandle layout) {
+    DeviceHandle device = *currentDevice;
+    vk::PipelineShaderStageCreateInfo stage = shader;
+    return Enqueue<ComputePipelineHandle>([this, device, stage, layout]() {
+        return CheckCreated(device.createComputePipeline(
+            m_cache, vk::ComputePipelineCreateInfo(GraphicsPipelineCreateInfo::GetLayoutFlags(layout), stage, layout)
+        ));
+    });
+}
+
+std::shared_future<GraphicsPipelineHandle> PipelineCompiler::Compile(
+    GraphicsPipeline &&pipeline, PipelineLayoutHandle layout, RenderPassHandle renderPass, uint32_t subpass
+) {
+    DeviceHandle device = *currentDevice;
+    auto description = std::make_shared<GraphicsPipeline>(std::move(pipeline));
+    return Enqueue<GraphicsPipelineHandle>([this, device, description, layout, renderPass, subpass]() {
+        const GraphicsPipeline &pipeline = *description;
+        GraphicsPipelineCreateInfo createInfo(pipeline, layout, renderPass, subpass);
+        createInfo.SetBase(pipeline.parent);
+
+        return CheckCreated(device.createGraphicsPipeline(m_cache, createInfo));
+    });
+}
+
+std::shared_future<GraphicsPipelineHandle>
+PipelineCompiler::Link(std::vector<GraphicsPipelineHandle> &&libraries, PipelineLayoutHandle layout) {
+    DeviceHandle device = *currentDevice;
+    return Enqueue<GraphicsPipelineHandle>([this, device, libraries = std::move(libraries), layout]() {
+        std::vector<vk::Pipeline> handles(libraries.begin(), libraries.end());
+        vk::PipelineLibraryCreateInfoKHR libraryInfo(handles);
+        vk::GraphicsPipelineCreateInfo createInfo;
+        createInfo.pNext = &libraryInfo;
+        createInfo.flags =
+            vk::PipelineCreateFlagBits::eLinkTimeOptimizationEXT | GraphicsPipelineCreateInfo::GetLayoutFlags(layout);
+        createInfo.layout = layout;
+
+        return CheckCreated(device.createGraphicsPipeline(m_cache, createInfo));
+    });
+}
+
+void PipelineCompiler::WaitIdle() {
+    std::unique_lock lock(m_mutex);
+    m_idle.wait(lock, [this]() { return m_jobs.empty() && m_activeJobs == 0; });
+}
+
+uint32_t PipelineCompiler::GetThreadCount() const { return m_workers.size(); }
+
+uint32_t PipelineCompiler::GetPendingCount() const {
+    std::lock_guard lock(m_mutex);
+    return m_jobs.size() + m_activeJobs;
+}
+
+template <typename T>
+std::shared_future<T> PipelineCompiler::Enqueue(std::function<PipelineHandle()> &&create) {
+    auto promise = std::make_shared<std::promise<T>>();
+    std::shared_future<T> future = promise->get_future().share();
+
+    // Failures are handed to the future, an exception escaping a worker would terminate the program.
+    Enqueue([this, create = std::move(create), promise]() {
+        try {
+            PipelineHandle pipeline = create();
+            {
+                std::lock_guard lock(m_mutex);
+                m_pipelines.push_back(pipeline);
+            }
+            promise->set_value(T(pipeline));
+        } catch (...) {
+            promise->set_exception(std::current_exception());
+        }
+    });
+
+    return future;
+}
+
+void PipelineCompiler::Enqueue(std::function<void()> &&job) {
+    {
+        std::lock_guard lock(m_mutex);
+        m_jobs.push(std::move(job));
+    }
+    m_jobAvailable.notify_one();
+}
+
+void PipelineCompiler::WorkerLoop() {
+    while (true) {
+        std::function<void()> job;
+        {
+            std::unique_lock lock(m_mutex);
+            m_jobAvailable.wait(lock, [this]() { return m_stop || !m_jobs.empty(); });
+            if (m_jobs.empty()) return;
+
+            job = std::move(m_jobs.front());
+            m_jobs.pop();
+            m_activeJobs++;
+        }
+
+        job();
+
+        {
+            std::lock_guard lock(m_mutex);
+            m_activeJobs--;
+        }
+        m_idle.notify_all();
+    }
+}
+} // namespace vg
@@ -0,0 +1,121 @@
+#pragma once
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+#include "Handle.h"
+#include "GraphicsPipeline.h"
+#include "Shader.h"
+
+namespace vg {
+/**
+ *@brief Compiles pipelines on worker threads
+ * Pipelines are created asynchronously and returned as futures, the render thread can keep drawing with fallback
+ * pipelines until they are ready. All pipelines created by the compiler are owned by it and destroyed with it.
+ */
+class PipelineCompiler {
+  public:
+    /**
+     *@brief Construct a new Pipeline Compiler object
+     *
+     * @param threadCount Count of worker threads
+     * @param cache Pipeline cache shared by all workers, must not be externally synchronized
+     */
+    PipelineCompiler(
+        uint32_t threadCount = std::max(std::thread::hardware_concurrency(), 1U),
+        PipelineCacheHandle cache = PipelineCacheHandle()
+    );
+
+    PipelineCompiler(PipelineCompiler &&other) = delete;
+    PipelineCompiler(const PipelineCompiler &other) = delete;
+    ~PipelineCompiler();
+
+    PipelineCompiler &operator=(PipelineCompiler &&other) = delete;
+    PipelineCompiler &operator=(const PipelineCompiler &other) = delete;
+
+    /**
+     *@brief Queue compilation of a compute pipeline
+     *
+     * @param shader Compute shader, has to outlive the compilation
+     * @param layout Pipeline layout, has to outlive the compilation
+     * @return future handle of the pipeline
+     */
+    std::shared_future<ComputePipelineHandle> Compile(const Shader &shader, PipelineLayoutHandle layout);
+
+    /**
+     *@brief Queue compilation of a graphics pipeline
+     *
+     * @param pipeline Pipeline description, shaders it points to have to outlive the compilation
+     * @param layout Pipeline layout, has to outlive the compilation
+     * @param renderPass Render pass the pipeline will be used with
+     * @param subpass Index of the subpass in renderPass
+     * @return future handle of the pipeline
+     */
+    std::shared_future<GraphicsPipelineHandle> Compile(
+        GraphicsPipeline &&pipeline, PipelineLayoutHandle layout, RenderPassHandle renderPass, uint32_t subpass
+    );
+
+    /**
+     *@brief Queue link time optimized linking of graphics pipeline libraries
+     *
+     * @param libraries Pipeline libraries, have to outlive the compilation
+     * @param layout Pipeline layout, has to outlive the compilation
+     * @return future handle of the linked pipeline
+     */
+    std::shared_future<GraphicsPipelineHandle>
+    Link(std::vector<GraphicsPipelineHandle> &&libraries, PipelineLayoutHandle layout);
+
+    /**
+     *@brief Block until every queued pipeline is compiled
+     */
+    void WaitIdle();
+
+    uint32_t GetThreadCount() const;
+    uint32_t GetPendingCount() const;
+
+    /**
+     *@brief Get the pipeline if it is ready or the fallback otherwise, never blocks or throws
+     * A failed compilation is caught once and the future is reset, later calls return the fallback straight away.
+     *
+     * @param pipeline Future returned by the compiler
+     * @param fallback Pipeline used until the compiled one is ready, or if its compilation failed
+     * @param error Set to the exception of a failed compilation by the call that catches it, optional
+     */
+    template <typename T>
+    static T GetOr(std::shared_future<T> &pipeline, T fallback, std::exception_ptr *error = nullptr) {
+        if (!pipeline.valid() || pipeline.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+            return fallback;
+
+        try {
+            return pipeline.get();
+        } catch (...) {
+            if (error) *error = std::current_exception();
+            pipeline = std::shared_future<T>();
+            return fallback;
+        }
+    }
+
+  private:
+    /**
+     *@brief Queue creation of a pipeline, its handle or the exception it throws is passed to the future
+     */
+    template <typename T> std::shared_future<T> Enqueue(std::function<PipelineHandle()> &&create);
+    void Enqueue(std::function<void()> &&job);
+    void WorkerLoop();
+
+  private:
+    std::vector<std::thread> m_workers;
+    std::queue<std::function<void()>> m_jobs;
+    mutable std::mutex m_mutex;
+    std::condition_variable m_jobAvailable;
+    std::condition_variable m_idle;
+    uint32_t m_activeJobs;
+    bool m_stop;
+
+    PipelineCacheHandle m_cache;
+    std::vector<PipelineHandle> m_pipelines;
+};
+} // namespace vg
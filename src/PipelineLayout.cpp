@@ -2,48 +2,86 @@
 #include <vulkan/vulkan.hpp>
 #include "PipelineLayout.h"
 #include "Device.h"
+#include "LayoutCache.h"
 
 namespace vg {
-PipelineLayout::PipelineLayout() {}
+PipelineLayout::PipelineLayout() : m_ownsDescriptorSetLayouts(true), m_descriptorBuffer(false) {}
 
 PipelineLayout::PipelineLayout(
     const std::vector<std::vector<DescriptorSetLayoutBinding>> &setLayoutBindings,
-    const std::vector<PushConstantRange> &pushConstantRanges
-) {
-    std::vector<DescriptorSetLayoutHandle> descriptorSetLayouts(setLayoutBindings.size());
-    for (int i = 0; i < descriptorSetLayouts.size(); i++)
-        descriptorSetLayouts[i] =
-            (((DeviceHandle)*currentDevice)
-                 .createDescriptorSetLayout({{}, *(std::vector<vk::DescriptorSetLayoutBinding> *)&setLayoutBindings[i]})
-            );
-
-    PipelineLayoutHandle layout =
-        ((DeviceHandle)*currentDevice)
-            .createPipelineLayout(vk::PipelineLayoutCreateInfo(
-                {}, descriptorSetLayouts, *(std::vector<vk::PushConstantRange> *)&pushConstantRanges
-            ));
-    m_handle = layout;
-    m_descriptorSetLayouts = descriptorSetLayouts;
+    const std::vector<PushConstantRange> &pushConstantRanges,
+    Span<const Flags<DescriptorSetLayoutCreate>> setLayoutFlags
+)
+    : m_ownsDescriptorSetLayouts(true), m_descriptorBuffer(false) {
+    assert(setLayoutFlags.size() <= setLayoutBindings.size());
+    LayoutCache &cache = currentDevice->GetLayoutCache();
+
+    m_descriptorSetLayouts.resize(setLayoutBindings.size());
+    for (int i = 0; i < m_descriptorSetLayouts.size(); i++) {
+        Flags<DescriptorSetLayoutCreate> flags;
+        if (i < setLayoutFlags.size()) flags = setLayoutFlags[i];
+        m_descriptorSetLayouts[i] = cache.AcquireSetLayout(setLayoutBindings[i], flags);
+        m_descriptorBuffer |= flags.IsSet(DescriptorSetLayoutCreate::DescriptorBuffer);
+    }
+    m_handle = cache.AcquirePipelineLayout(m_descriptorSetLayouts, pushConstantRanges);
 }
+
+PipelineLayout::PipelineLayout(
+    Span<const DescriptorSetLayoutHandle> setLayouts, const std::vector<PushConstantRange> &pushConstantRanges
+)
+    : m_descriptorSetLayouts(setLayouts.begin(), setLayouts.end()), m_ownsDescriptorSetLayouts(false),
+      m_descriptorBuffer(false) {
+    LayoutCache &cache = currentDevice->GetLayoutCache();
+
+    m_handle = cache.AcquirePipelineLayout(m_descriptorSetLayouts, pushConstantRanges);
+    for (auto &&setLayout : m_descriptorSetLayouts) m_descriptorBuffer |= cache.IsDescriptorBufferLayout(setLayout);
+}
+
 PipelineLayout::PipelineLayout(PipelineLayout &&other) noexcept : PipelineLayout() { *this = std::move(other); }
 
+PipelineLayout::PipelineLayout(const PipelineLayout &other) : PipelineLayout() { *this = other; }
+
 PipelineLayout &PipelineLayout::operator=(PipelineLayout &&other) noexcept {
     if (&other == this) return *this;
 
     std::swap(m_handle, other.m_handle);
     std::swap(m_descriptorSetLayouts, other.m_descriptorSetLayouts);
+    std::swap(m_ownsDescriptorSetLayouts, other.m_ownsDescriptorSetLayouts);
+    std::swap(m_descriptorBuffer, other.m_descriptorBuffer);
 
     return *this;
 }
+
+PipelineLayout &PipelineLayout::operator=(const PipelineLayout &other) {
+    if (&other == this) return *this;
+
+    PipelineLayout copy;
+    copy.m_handle = other.m_handle;
+    copy.m_descriptorSetLayouts = other.m_descriptorSetLayouts;
+    copy.m_ownsDescriptorSetLayouts = other.m_ownsDescriptorSetLayouts;
+    copy.m_descriptorBuffer = other.m_descriptorBuffer;
+    if (copy.m_handle) {
+        LayoutCache &cache = currentDevice->GetLayoutCache();
+        cache.AddReference(copy.m_handle);
+        if (copy.m_ownsDescriptorSetLayouts)
+            for (auto &&setLayout : copy.m_descriptorSetLayouts) cache.AddReference(setLayout);
+    }
+
+    return *this = std::move(copy);
+}
+
 PipelineLayout::~PipelineLayout() {
     if (!m_handle) return;
 
-    for (int i = 0; i < m_descriptorSetLayouts.size(); i++)
-        ((DeviceHandle)*currentDevice).destroyDescriptorSetLayout(m_descriptorSetLayouts[i]);
-    ((DeviceHandle)*currentDevice).destroyPipelineLayout(m_handle);
+    LayoutCache &cache = currentDevice->GetLayoutCache();
+    cache.Release(m_handle);
+    if (m_ownsDescriptorSetLayouts)
+        for (auto &&setLayout : m_descriptorSetLayouts) cache.Release(setLayout);
     m_handle = nullptr;
 }
+
 PipelineLayout::operator const PipelineLayoutHandle &() const { return m_handle; }
 Span<DescriptorSetLayoutHandle> PipelineLayout::GetDescriptorSets() { return m_descriptorSetLayouts; }
 Span<const DescriptorSetLayoutHandle> PipelineLayout::GetDescriptorSets() const { return m_descriptorSetLayouts; }
+bool PipelineLayout::UsesDescriptorBuffer() const { return m_descriptorBuffer; }
 } // namespace vg
@@ -5,29 +5,61 @@
 #include "Span.h"
 
 namespace vg {
+/**
+ *@brief Pipeline layout
+ * Descriptor set layouts and pipeline layouts are taken from the device \ref LayoutCache, identical layouts share
+ * one handle. Copies share the handle too.
+ */
 class PipelineLayout {
   public:
     PipelineLayout();
 
+    /**
+     *@brief Construct a new Pipeline Layout object
+     *
+     * @param setLayoutBindings Bindings of each descriptor set layout
+     * @param pushConstantRanges Push constant ranges
+     * @param setLayoutFlags Create flags of each descriptor set layout, missing entries have no flags. Mark sets
+     * written with cmd::PushDescriptorSet as PushDescriptor, and all sets as DescriptorBuffer to bind them from a
+     * \ref DescriptorBuffer.
+     */
     PipelineLayout(
         const std::vector<std::vector<DescriptorSetLayoutBinding>> &setLayoutBindings,
-        const std::vector<PushConstantRange> &pushConstantRanges
+        const std::vector<PushConstantRange> &pushConstantRanges,
+        Span<const Flags<DescriptorSetLayoutCreate>> setLayoutFlags = {}
+    );
+
+    /**
+     *@brief Construct a new Pipeline Layout object from existing descriptor set layouts
+     *
+     * @param setLayouts Descriptor set layouts acquired from the device's \ref LayoutCache, the cache keeps them alive
+     * while the pipeline layout exists
+     * @param pushConstantRanges Push constant ranges
+     */
+    PipelineLayout(
+        Span<const DescriptorSetLayoutHandle> setLayouts, const std::vector<PushConstantRange> &pushConstantRanges
     );
 
     PipelineLayout(PipelineLayout &&other) noexcept;
-    PipelineLayout(const PipelineLayout &other) = delete;
+    PipelineLayout(const PipelineLayout &other);
 
     PipelineLayout &operator=(PipelineLayout &&other) noexcept;
-    PipelineLayout &operator=(const PipelineLayout &other) = delete;
+    PipelineLayout &operator=(const PipelineLayout &other);
     ~PipelineLayout();
     operator const PipelineLayoutHandle &() const;
 
     Span<DescriptorSetLayoutHandle> GetDescriptorSets();
     Span<const DescriptorSetLayoutHandle> GetDescriptorSets() const;
+    /**
+     *@brief Check if pipelines with this layout have to be created for descriptor buffers
+     */
+    bool UsesDescriptorBuffer() const;
 
   private:
     PipelineLayoutHandle m_handle;
     std::vector<DescriptorSetLayoutHandle> m_descriptorSetLayouts;
+    bool m_ownsDescriptorSetLayouts;
+    bool m_descriptorBuffer;
     friend class RenderPass;
     friend class ComputePipeline;
 };
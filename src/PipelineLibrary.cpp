@@ -0,0 +1,221 @@
+#include <vulkan/vulkan.hpp>
+#include "PipelineLibrary.h"
+#include "Device.h"
+#include "GraphicsPipelineCreateInfo.h"
+
+namespace vg {
+template <typename T> static void AppendKey(std::string &key, const T &value) {
+    key.append((const char *)&value, sizeof(value));
+}
+
+template <typename T> static void AppendKey(std::string &key, const T *values, uint32_t count) {
+    key.append((const char *)values, sizeof(T) * count);
+}
+
+static void AppendSpecializationKey(std::string &key, const Shader &shader) {
+    std::string specialization = shader.GetSpecialization().GetKey();
+    AppendKey(key, (uint32_t)specialization.size());
+    key += specialization;
+}
+
+static GraphicsPipelineHandle CreatePipeline(
+    PipelineCacheHandle cache, const GraphicsPipeline &pipeline, PipelineLayoutHandle layout,
+    RenderPassHandle renderPass, uint32_t subpass, vk::PipelineCreateFlags flags, const void *pNext,
+    std::function<bool(ShaderStage)> includeStage
+) {
+    // State not belonging to the built library part is ignored by the driver.
+    GraphicsPipelineCreateInfo createInfo(pipeline, layout, renderPass, subpass, flags, includeStage);
+    createInfo.info.pNext = pNext;
+
+    return ((DeviceHandle)*currentDevice).createGraphicsPipeline(cache, createInfo).value;
+}
+
+PipelineLibrary::PipelineLibrary(PipelineCacheHandle cache, PipelineCompiler *optimizer)
+    : m_cache(cache), m_optimizer(optimizer),
+      m_useLibraries(
+          currentDevice->IsExtensionEnabled(VK_KHR_PIPELINE_LIBRARY_EXTENSION_NAME) &&
+          currentDevice->IsExtensionEnabled(VK_EXT_GRAPHICS_PIPELINE_LIBRARY_EXTENSION_NAME)
+      ) {}
+
+PipelineLibrary::~PipelineLibrary() {
+    // Optimized links still in flight reference the parts.
+    if (m_optimizer) m_optimizer->WaitIdle();
+
+    for (auto &&[key, pipeline] : m_pipelines) ((DeviceHandle)*currentDevice).destroyPipeline(pipeline.fast);
+    for (auto &&[key, part] : m_parts) ((DeviceHandle)*currentDevice).destroyPipeline(part);
+}
+
+GraphicsPipelineHandle PipelineLibrary::Get(
+    const GraphicsPipeline &pipeline, PipelineLayoutHandle layout, RenderPassHandle renderPass, uint32_t subpass
+) {
+    // Mesh shading pipelines have no vertex input state, there is no such part to key or link.
+    bool meshShader = pipeline.UsesMeshShader();
+    if (!m_useLibraries) {
+        std::string key;
+        for (Part part : {Part::VertexInput, Part::PreRasterization, Part::FragmentShader, Part::FragmentOutput}) {
+            if (part == Part::VertexInput && meshShader) continue;
+            key += GetPartKey(part, pipeline, layout, renderPass, subpass);
+        }
+
+        auto it = m_pipelines.find(key);
+        if (it != m_pipelines.end()) return it->second.fast;
+
+        GraphicsPipelineHandle handle = CreatePipeline(
+            m_cache, pipeline, layout, renderPass, subpass, {}, nullptr, nullptr
+        );
+        m_pipelines[key].fast = handle;
+        return handle;
+    }
+
+    std::vector<GraphicsPipelineHandle> parts;
+    parts.reserve(4);
+    if (!meshShader) parts.push_back(GetPart(Part::VertexInput, pipeline, layout, renderPass, subpass));
+    parts.push_back(GetPart(Part::PreRasterization, pipeline, layout, renderPass, subpass));
+    parts.push_back(GetPart(Part::FragmentShader, pipeline, layout, renderPass, subpass));
+    parts.push_back(GetPart(Part::FragmentOutput, pipeline, layout, renderPass, subpass));
+
+    std::string key;
+    AppendKey(key, parts.data(), parts.size());
+    AppendKey(key, layout);
+
+    auto it = m_pipelines.find(key);
+    if (it != m_pipelines.end()) return PipelineCompiler::GetOr(it->second.optimized, it->second.fast);
+
+    // Fast link without optimization, it is cheap enough to do on a miss without a hitch.
+    std::vector<vk::Pipeline> libraries(parts.begin(), parts.end());
+    vk::PipelineLibraryCreateInfoKHR libraryInfo(libraries);
+    vk::GraphicsPipelineCreateInfo createInfo;
+    createInfo.pNext = &libraryInfo;
+    createInfo.flags = GraphicsPipelineCreateInfo::GetLayoutFlags(layout);
+    createInfo.layout = layout;
+
+    Linked &linked = m_pipelines[key];
+    linked.fast = ((DeviceHandle)*currentDevice).createGraphicsPipeline(m_cache, createInfo).value;
+    if (m_optimizer) linked.optimized = m_optimizer->Link(std::move(parts), layout);
+
+    return linked.fast;
+}
+
+bool PipelineLibrary::IsUsingLibraries() const { return m_useLibraries; }
+
+uint32_t PipelineLibrary::GetPartCount() const { return m_parts.size(); }
+
+uint32_t PipelineLibrary::GetPipelineCount() const { return m_pipelines.size(); }
+
+GraphicsPipelineHandle PipelineLibrary::GetPart(
+    Part part, const GraphicsPipeline &pipeline, PipelineLayoutHandle layout, RenderPassHandle renderPass,
+    uint32_t subpass
+) {
+    std::string key = GetPartKey(part, pipeline, layout, renderPass, subpass);
+    auto it = m_parts.find(key);
+    if (it != m_parts.end()) return it->second;
+
+    static const vk::GraphicsPipelineLibraryFlagBitsEXT partFlags[] = {
+        vk::GraphicsPipelineLibraryFlagBitsEXT::eVertexInputInterface,
+        vk::GraphicsPipelineLibraryFlagBitsEXT::ePreRasterizationShaders,
+        vk::GraphicsPipelineLibraryFlagBitsEXT::eFragmentShader,
+        vk::GraphicsPipelineLibraryFlagBitsEXT::eFragmentOutputInterface,
+    };
+    vk::GraphicsPipelineLibraryCreateInfoEXT libraryInfo(partFlags[(int)part]);
+
+    GraphicsPipelineHandle handle = CreatePipeline(
+        m_cache, pipeline, layout, renderPass, subpass,
+        vk::PipelineCreateFlagBits::eLibraryKHR | vk::PipelineCreateFlagBits::eRetainLinkTimeOptimizationInfoEXT,
+        &libraryInfo,
+        [part](ShaderStage stage) {
+            if (part == Part::PreRasterization) return stage != ShaderStage::Fragment;
+            if (part == Part::FragmentShader) return stage == ShaderStage::Fragment;
+            return false;
+        }
+    );
+    m_parts[key] = handle;
+    return handle;
+}
+
+std::string PipelineLibrary::GetPartKey(
+    Part part, const GraphicsPipeline &pipeline, PipelineLayoutHandle layout, RenderPassHandle renderPass,
+    uint32_t subpass
+) {
+    std::string key;
+    AppendKey(key, part);
+
+    // Only public fields are written, reserved fields hold sType and pointers that differ between equal states.
+    switch (part) {
+    case Part::VertexInput:
+        AppendKey(key, pipeline.vertexInput.vertexDescriptionCount);
+        AppendKey(key, pipeline.vertexInput.vertexDescritpions, pipeline.vertexInput.vertexDescriptionCount);
+        AppendKey(key, pipeline.vertexInput.vertexAttributesCount);
+        AppendKey(key, pipeline.vertexInput.vertexAttributes, pipeline.vertexInput.vertexAttributesCount);
+        AppendKey(key, pipeline.inputAssembly.primitive);
+        AppendKey(key, pipeline.inputAssembly.primitiveRestart);
+        break;
+
+    case Part::PreRasterization:
+        for (auto &&shader : pipeline.shaders) {
+            if (shader->GetStage() == ShaderStage::Fragment) continue;
+            AppendKey(key, (ShaderHandle)*shader);
+            AppendKey(key, shader->GetStage());
+            AppendSpecializationKey(key, *shader);
+        }
+        AppendKey(key, pipeline.viewportState.viewportCount);
+        AppendKey(key, pipeline.viewportState.viewports, pipeline.viewportState.viewportCount);
+        AppendKey(key, pipeline.viewportState.scissorCount);
+        AppendKey(key, pipeline.viewportState.scissors, pipeline.viewportState.scissorCount);
+        AppendKey(key, pipeline.rasterizer.depthClamp);
+        AppendKey(key, pipeline.rasterizer.discard);
+        AppendKey(key, pipeline.rasterizer.polygonMode);
+        AppendKey(key, pipeline.rasterizer.cullMode);
+        AppendKey(key, pipeline.rasterizer.frontFace);
+        AppendKey(key, pipeline.rasterizer.depthBias);
+        AppendKey(key, pipeline.rasterizer.lineWidth);
+        AppendKey(key, layout);
+        AppendKey(key, renderPass);
+        AppendKey(key, subpass);
+        break;
+
+    case Part::FragmentShader:
+        for (auto &&shader : pipeline.shaders) {
+            if (shader->GetStage() != ShaderStage::Fragment) continue;
+            AppendKey(key, (ShaderHandle)*shader);
+            AppendSpecializationKey(key, *shader);
+        }
+        AppendKey(key, pipeline.multisampling.rasterizationSamples);
+        AppendKey(key, pipeline.multisampling.sampleShadingEnable);
+        AppendKey(key, pipeline.multisampling.minSampleShading);
+        AppendKey(key, pipeline.depthStencil.depthTestEnable);
+        AppendKey(key, pipeline.depthStencil.depthWriteEnable);
+        AppendKey(key, pipeline.depthStencil.depthCompareOp);
+        AppendKey(key, pipeline.depthStencil.depthBoundsTestEnable);
+        AppendKey(key, pipeline.depthStencil.stencilTestEnable);
+        AppendKey(key, pipeline.depthStencil.front);
+        AppendKey(key, pipeline.depthStencil.back);
+        AppendKey(key, pipeline.depthStencil.minDepthBounds);
+        AppendKey(key, pipeline.depthStencil.maxDepthBounds);
+        AppendKey(key, layout);
+        AppendKey(key, renderPass);
+        AppendKey(key, subpass);
+        break;
+
+    case Part::FragmentOutput:
+        AppendKey(key, pipeline.colorBlending.enableLogicOp);
+        AppendKey(key, pipeline.colorBlending.logicOp);
+        AppendKey(key, pipeline.colorBlending.attachmentCount);
+        AppendKey(key, pipeline.colorBlending.attachments, pipeline.colorBlending.attachmentCount);
+        AppendKey(key, pipeline.colorBlending.blendConsts);
+        AppendKey(key, pipeline.multisampling.rasterizationSamples);
+        AppendKey(key, pipeline.multisampling.alphaToCoverageEnable);
+        AppendKey(key, pipeline.multisampling.alphaToOneEnable);
+        if (pipeline.multisampling.sampleMask)
+            AppendKey(
+                key, (const uint32_t *)pipeline.multisampling.sampleMask,
+                (pipeline.multisampling.rasterizationSamples + 31) / 32
+            );
+        AppendKey(key, renderPass);
+        AppendKey(key, subpass);
+        break;
+    }
+
+    AppendKey(key, pipeline.dynamicState.data(), pipeline.dynamicState.size());
+    return key;
+}
+} // namespace vg
@@ -0,0 +1,80 @@
+#pragma once
+#include <future>
+#include <string>
+#include <unordered_map>
+#include "Handle.h"
+#include "GraphicsPipeline.h"
+#include "PipelineCompiler.h"
+
+namespace vg {
+/**
+ *@brief Builds graphics pipelines from separately cached parts using VK_EXT_graphics_pipeline_library
+ * A pipeline is split into vertex input, pre-rasterization, fragment shader and fragment output libraries. Each part is
+ * compiled once and shared by every pipeline using the same state, new permutations only need a cheap link. When a
+ * compiler is given, link time optimized pipelines are built in the background and replace the fast linked ones once
+ * ready. Requires VK_KHR_pipeline_library and VK_EXT_graphics_pipeline_library to be enabled on the device, otherwise
+ * complete pipelines are created. Not thread safe.
+ */
+class PipelineLibrary {
+  public:
+    /**
+     *@brief Construct a new Pipeline Library object
+     *
+     * @param cache Pipeline cache used when building parts
+     * @param optimizer Compiler building optimized pipelines in the background, has to outlive the library, nullptr
+     * disables optimized linking
+     */
+    PipelineLibrary(PipelineCacheHandle cache = PipelineCacheHandle(), PipelineCompiler *optimizer = nullptr);
+
+    PipelineLibrary(PipelineLibrary &&other) = delete;
+    PipelineLibrary(const PipelineLibrary &other) = delete;
+    ~PipelineLibrary();
+
+    PipelineLibrary &operator=(PipelineLibrary &&other) = delete;
+    PipelineLibrary &operator=(const PipelineLibrary &other) = delete;
+
+    /**
+     *@brief Get a pipeline for the description, building missing parts and linking them
+     * Returns the optimized pipeline if it is ready and the fast linked one otherwise, so handles can change between
+     * calls. Call it when binding rather than storing the result.
+     *
+     * @param pipeline Pipeline description, parent and parentIndex are ignored
+     * @param layout Pipeline layout
+     * @param renderPass Render pass the pipeline will be used with
+     * @param subpass Index of the subpass in renderPass
+     * @return Handle of the pipeline
+     */
+    GraphicsPipelineHandle Get(
+        const GraphicsPipeline &pipeline, PipelineLayoutHandle layout, RenderPassHandle renderPass, uint32_t subpass
+    );
+
+    bool IsUsingLibraries() const;
+    uint32_t GetPartCount() const;
+    uint32_t GetPipelineCount() const;
+
+  private:
+    enum class Part { VertexInput, PreRasterization, FragmentShader, FragmentOutput };
+
+    struct Linked {
+        GraphicsPipelineHandle fast;
+        std::shared_future<GraphicsPipelineHandle> optimized;
+    };
+
+    GraphicsPipelineHandle GetPart(
+        Part part, const GraphicsPipeline &pipeline, PipelineLayoutHandle layout, RenderPassHandle renderPass,
+        uint32_t subpass
+    );
+    static std::string GetPartKey(
+        Part part, const GraphicsPipeline &pipeline, PipelineLayoutHandle layout, RenderPassHandle renderPass,
+        uint32_t subpass
+    );
+
+  private:
+    PipelineCacheHandle m_cache;
+    PipelineCompiler *m_optimizer;
+    bool m_useLibraries;
+
+    std::unordered_map<std::string, GraphicsPipelineHandle> m_parts;
+    std::unordered_map<std::string, Linked> m_pipelines;
+};
+} // namespace vg
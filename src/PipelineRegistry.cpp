@@ -0,0 +1,170 @@
+#include <vulkan/vulkan.hpp>
+#include "PipelineRegistry.h"
+#include "Device.h"
+#include "GraphicsPipelineCreateInfo.h"
+#include <cstring>
+
+namespace vg {
+PipelineRegistry::PipelineRegistry(PipelineCacheHandle cache, uint32_t bucketCount)
+    : m_cache(cache), m_buckets(bucketCount), m_hitCount(0), m_missCount(0), m_pipelineCount(0) {
+    assert(bucketCount > 0);
+    for (auto &&bucket : m_buckets) bucket.store(nullptr, std::memory_order_relaxed);
+}
+
+PipelineRegistry::~PipelineRegistry() {
+    for (auto &&bucket : m_buckets) {
+        Entry *entry = bucket.load(std::memory_order_acquire);
+        while (entry) {
+            Entry *next = entry->next;
+            ((DeviceHandle)*currentDevice).destroyPipeline(entry->handle);
+            delete entry;
+            entry = next;
+        }
+    }
+}
+
+GraphicsPipelineHandle PipelineRegistry::Get(
+    const GraphicsPipeline &pipeline, PipelineLayoutHandle layout, RenderPassHandle renderPass, uint32_t subpass
+) {
+    std::vector<char> key = Serialize(pipeline, layout, renderPass, subpass);
+    uint64_t hash = Hash(key);
+    std::atomic<Entry *> &bucket = m_buckets[hash % m_buckets.size()];
+
+    if (const Entry *entry = Find(bucket, hash, key)) {
+        m_hitCount.fetch_add(1, std::memory_order_relaxed);
+        return entry->handle;
+    }
+
+    // Another thread could have built the same pipeline while we waited for the lock.
+    std::lock_guard lock(m_buildMutex);
+    if (const Entry *entry = Find(bucket, hash, key)) {
+        m_hitCount.fetch_add(1, std::memory_order_relaxed);
+        return entry->handle;
+    }
+
+    m_missCount.fetch_add(1, std::memory_order_relaxed);
+    Entry *entry = new Entry{hash, std::move(key), Build(pipeline, layout, renderPass, subpass), nullptr};
+
+    // Entries are only ever pushed to the front, so readers walking the list are never invalidated.
+    entry->next = bucket.load(std::memory_order_relaxed);
+    bucket.store(entry, std::memory_order_release);
+    m_pipelineCount.fetch_add(1, std::memory_order_relaxed);
+
+    return entry->handle;
+}
+
+uint64_t PipelineRegistry::GetHitCount() const { return m_hitCount.load(std::memory_order_relaxed); }
+
+uint64_t PipelineRegistry::GetMissCount() const { return m_missCount.load(std::memory_order_relaxed); }
+
+uint32_t PipelineRegistry::GetPipelineCount() const { return m_pipelineCount.load(std::memory_order_relaxed); }
+
+std::vector<char> PipelineRegistry::Serialize(
+    const GraphicsPipeline &pipeline, PipelineLayoutHandle layout, RenderPassHandle renderPass, uint32_t subpass
+) {
+    std::vector<char> key;
+    key.reserve(512);
+    auto append = [&key](const auto &value) {
+        key.insert(key.end(), (const char *)&value, (const char *)&value + sizeof(value));
+    };
+    auto appendArray = [&key](const auto *values, uint32_t count) {
+        key.insert(key.end(), (const char *)values, (const char *)(values + count));
+    };
+
+    // Only public fields are written, reserved fields hold sType and pointers that differ between equal states.
+    append(pipeline.shaders.size());
+    for (auto &&shader : pipeline.shaders) {
+        append((ShaderHandle)*shader);
+        append(shader->GetStage());
+
+        std::string specialization = shader->GetSpecialization().GetKey();
+        append(specialization.size());
+        appendArray(specialization.data(), specialization.size());
+    }
+
+    const VertexLayout &vertexInput = pipeline.vertexInput;
+    append(vertexInput.vertexDescriptionCount);
+    appendArray(vertexInput.vertexDescritpions, vertexInput.vertexDescriptionCount);
+    append(vertexInput.vertexAttributesCount);
+    appendArray(vertexInput.vertexAttributes, vertexInput.vertexAttributesCount);
+
+    append(pipeline.inputAssembly.primitive);
+    append(pipeline.inputAssembly.primitiveRestart);
+
+    const ViewportState &viewportState = pipeline.viewportState;
+    append(viewportState.viewportCount);
+    appendArray(viewportState.viewports, viewportState.viewportCount);
+    append(viewportState.scissorCount);
+    appendArray(viewportState.scissors, viewportState.scissorCount);
+
+    const Rasterizer &rasterizer = pipeline.rasterizer;
+    append(rasterizer.depthClamp);
+    append(rasterizer.discard);
+    append(rasterizer.polygonMode);
+    append(rasterizer.cullMode);
+    append(rasterizer.frontFace);
+    append(rasterizer.depthBias);
+    append(rasterizer.lineWidth);
+
+    const Multisampling &multisampling = pipeline.multisampling;
+    append(multisampling.rasterizationSamples);
+    append(multisampling.sampleShadingEnable);
+    append(multisampling.minSampleShading);
+    if (multisampling.sampleMask)
+        appendArray((const uint32_t *)multisampling.sampleMask, (multisampling.rasterizationSamples + 31) / 32);
+    append(multisampling.alphaToCoverageEnable);
+    append(multisampling.alphaToOneEnable);
+
+    const DepthStencil &depthStencil = pipeline.depthStencil;
+    append(depthStencil.depthTestEnable);
+    append(depthStencil.depthWriteEnable);
+    append(depthStencil.depthCompareOp);
+    append(depthStencil.depthBoundsTestEnable);
+    append(depthStencil.stencilTestEnable);
+    append(depthStencil.front);
+    append(depthStencil.back);
+    append(depthStencil.minDepthBounds);
+    append(depthStencil.maxDepthBounds);
+
+    const ColorBlending &colorBlending = pipeline.colorBlending;
+    append(colorBlending.enableLogicOp);
+    append(colorBlending.logicOp);
+    append(colorBlending.attachmentCount);
+    appendArray(colorBlending.attachments, colorBlending.attachmentCount);
+    append(colorBlending.blendConsts);
+
+    append(pipeline.dynamicState.size());
+    appendArray(pipeline.dynamicState.data(), pipeline.dynamicState.size());
+
+    append(layout);
+    append(renderPass);
+    append(subpass);
+
+    return key;
+}
+
+uint64_t PipelineRegistry::Hash(const std::vector<char> &key) {
+    // FNV-1a.
+    uint64_t hash = 14695981039346656037ULL;
+    for (char byte : key) {
+        hash ^= (uint8_t)byte;
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+const PipelineRegistry::Entry *
+PipelineRegistry::Find(const std::atomic<Entry *> &bucket, uint64_t hash, const std::vector<char> &key) const {
+    for (const Entry *entry = bucket.load(std::memory_order_acquire); entry; entry = entry->next)
+        if (entry->hash == hash && entry->key == key) return entry;
+
+    return nullptr;
+}
+
+GraphicsPipelineHandle PipelineRegistry::Build(
+    const GraphicsPipeline &pipeline, PipelineLayoutHandle layout, RenderPassHandle renderPass, uint32_t subpass
+) {
+    GraphicsPipelineCreateInfo createInfo(pipeline, layout, renderPass, subpass);
+    return ((DeviceHandle)*currentDevice).createGraphicsPipeline(m_cache, createInfo).value;
+}
+} // namespace vg
@@ -0,0 +1,80 @@
+#pragma once
+#include <atomic>
+#include <mutex>
+#include <vector>
+#include "Handle.h"
+#include "GraphicsPipeline.h"
+
+namespace vg {
+/**
+ *@brief Deduplicates graphics pipelines by their full description
+ * The description (shaders, fixed function state, dynamic state, layout, render pass and subpass) is serialized and
+ * hashed, identical descriptions share one pipeline. Lookups never lock, only building a missing pipeline does.
+ * All pipelines are owned by the registry and destroyed with it.
+ *
+ * Shaders, layout and render pass are keyed by their handles, not by contents. Pipelines are only shared between
+ * lookups passing the exact same render pass handle, a compatible render pass builds its own pipeline. Create render
+ * passes once and reuse them, e.g. per frame render pass recreation would miss every time.
+ */
+class PipelineRegistry {
+  public:
+    /**
+     *@brief Construct a new Pipeline Registry object
+     *
+     * @param cache Pipeline cache used when building pipelines
+     * @param bucketCount Count of hash buckets, should be close to the expected count of permutations
+     */
+    PipelineRegistry(PipelineCacheHandle cache = PipelineCacheHandle(), uint32_t bucketCount = 1 << 16);
+
+    PipelineRegistry(PipelineRegistry &&other) = delete;
+    PipelineRegistry(const PipelineRegistry &other) = delete;
+    ~PipelineRegistry();
+
+    PipelineRegistry &operator=(PipelineRegistry &&other) = delete;
+    PipelineRegistry &operator=(const PipelineRegistry &other) = delete;
+
+    /**
+     *@brief Get the pipeline matching the description, building it on a miss
+     *
+     * @param pipeline Pipeline description, parent and parentIndex are ignored
+     * @param layout Pipeline layout
+     * @param renderPass Render pass the pipeline will be used with, has to be the exact handle pipelines were built
+     * with to share them, compatible render passes don't match
+     * @param subpass Index of the subpass in renderPass
+     * @return Handle of the pipeline
+     */
+    GraphicsPipelineHandle Get(
+        const GraphicsPipeline &pipeline, PipelineLayoutHandle layout, RenderPassHandle renderPass, uint32_t subpass
+    );
+
+    uint64_t GetHitCount() const;
+    uint64_t GetMissCount() const;
+    uint32_t GetPipelineCount() const;
+
+  private:
+    struct Entry {
+        uint64_t hash;
+        std::vector<char> key;
+        GraphicsPipelineHandle handle;
+        Entry *next;
+    };
+
+    static std::vector<char> Serialize(
+        const GraphicsPipeline &pipeline, PipelineLayoutHandle layout, RenderPassHandle renderPass, uint32_t subpass
+    );
+    static uint64_t Hash(const std::vector<char> &key);
+    const Entry *Find(const std::atomic<Entry *> &bucket, uint64_t hash, const std::vector<char> &key) const;
+    GraphicsPipelineHandle Build(
+        const GraphicsPipeline &pipeline, PipelineLayoutHandle layout, RenderPassHandle renderPass, uint32_t subpass
+    );
+
+  private:
+    PipelineCacheHandle m_cache;
+    std::vector<std::atomic<Entry *>> m_buckets;
+    std::mutex m_buildMutex;
+
+    std::atomic<uint64_t> m_hitCount;
+    std::atomic<uint64_t> m_missCount;
+    std::atomic<uint32_t> m_pipelineCount;
+};
+} // namespace vg
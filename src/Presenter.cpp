@@ -0,0 +1,272 @@
+#include <vulkan/vulkan.hpp>
+#include "Presenter.h"
+#include <algorithm>
+#include <cassert>
+#include "DeviceFunction.h"
+
+VkResult vkWaitForPresentKHR(VkDevice device, VkSwapchainKHR swapchain, uint64_t presentId, uint64_t timeout) {
+    return vg::GetDeviceFunction<PFN_vkWaitForPresentKHR, "vkWaitForPresentKHR">()(
+        device, swapchain, presentId, timeout
+    );
+}
+
+namespace vg {
+Presenter::Presenter(
+    const Surface &surface, Queue &queue, uint32_t width, uint32_t height, uint32_t frameCount, uint32_t imageCount,
+    PresentMode presentMode, Flags<Usage> usage
+)
+    : m_surface(&surface), m_queue(&queue), m_width(width), m_height(height), m_imageCount(imageCount),
+      m_presentMode(presentMode), m_usage(usage), m_frames(frameCount), m_frameIndex(0), m_imageIndex(0),
+      m_recreate(false), m_maxFramesAhead(0), m_presentId(0), m_displayedPresentId(0), m_timedPresentId(0),
+      m_displayedInterval(0), m_displayedCount(0), m_waitTime(0), m_samples(statsFrameCount), m_sampleCount(0) {
+    assert(frameCount > 0);
+
+    m_presentWait = currentDevice->IsPresentWaitEnabled();
+
+    for (auto &&frame : m_frames) frame.inFlight = Fence(true);
+    m_swapchain = Swapchain(surface, imageCount, width, height, usage, presentMode);
+    m_images.resize(m_swapchain.GetImageCount());
+}
+
+Presenter::Presenter()
+    : m_surface(nullptr), m_queue(nullptr), m_width(0), m_height(0), m_imageCount(0),
+      m_presentMode(PresentMode::Fifo), m_frameIndex(0), m_imageIndex(0), m_recreate(false), m_presentWait(false),
+      m_maxFramesAhead(0), m_presentId(0), m_displayedPresentId(0), m_timedPresentId(0), m_displayedInterval(0),
+      m_displayedCount(0), m_waitTime(0), m_sampleCount(0) {}
+
+Presenter::Presenter(Presenter &&other) noexcept : Presenter() { *this = std::move(other); }
+
+Presenter::~Presenter() {
+    // Presentation isn't covered by fences, so semaphores and the swapchain are released only once the device idles.
+    if (m_queue) currentDevice->WaitUntilIdle();
+}
+
+Presenter &Presenter::operator=(Presenter &&other) noexcept {
+    if (&other == this) return *this;
+
+    std::swap(m_surface, other.m_surface);
+    std::swap(m_queue, other.m_queue);
+    std::swap(m_swapchain, other.m_swapchain);
+    std::swap(m_width, other.m_width);
+    std::swap(m_height, other.m_height);
+    std::swap(m_imageCount, other.m_imageCount);
+    std::swap(m_presentMode, other.m_presentMode);
+    std::swap(m_usage, other.m_usage);
+    std::swap(m_frames, other.m_frames);
+    std::swap(m_images, other.m_images);
+    std::swap(m_frameIndex, other.m_frameIndex);
+    std::swap(m_imageIndex, other.m_imageIndex);
+    std::swap(m_recreate, other.m_recreate);
+    std::swap(m_recreateCallback, other.m_recreateCallback);
+    std::swap(m_presentWait, other.m_presentWait);
+    std::swap(m_maxFramesAhead, other.m_maxFramesAhead);
+    std::swap(m_presentId, other.m_presentId);
+    std::swap(m_displayedPresentId, other.m_displayedPresentId);
+    std::swap(m_timedPresentId, other.m_timedPresentId);
+    std::swap(m_timedPresentTime, other.m_timedPresentTime);
+    std::swap(m_displayedInterval, other.m_displayedInterval);
+    std::swap(m_displayedCount, other.m_displayedCount);
+    std::swap(m_acquireTime, other.m_acquireTime);
+    std::swap(m_presentTime, other.m_presentTime);
+    std::swap(m_waitTime, other.m_waitTime);
+    std::swap(m_samples, other.m_samples);
+    std::swap(m_sampleCount, other.m_sampleCount);
+
+    return *this;
+}
+
+bool Presenter::Acquire(uint64_t timeout) {
+    Clock::time_point waitStart = Clock::now();
+    FrameSlot &frame = m_frames[m_frameIndex];
+    frame.inFlight.Await();
+
+    if ((m_recreate || (SwapchainHandle)m_swapchain == nullptr) && !Recreate()) return false;
+    LimitFramesAhead();
+
+    auto [imageIndex, result] = m_swapchain.GetNextImageIndex(frame.imageAvailable, Fence(nullptr), timeout);
+    if (result == Result::ErrorOutOfDate) {
+        if (!Recreate()) return false;
+        std::tie(imageIndex, result) = m_swapchain.GetNextImageIndex(frame.imageAvailable, Fence(nullptr), timeout);
+    }
+    if (result != Result::Success && result != Result::Suboptimal) return false;
+    // A suboptimal image can still be presented, the swapchain is recreated once it was.
+    if (result == Result::Suboptimal) m_recreate = true;
+
+    // With more images than frames in flight images are acquired out of order, the image may still be rendered to by
+    // another frame slot.
+    m_imageIndex = imageIndex;
+    ImageSlot &image = m_images[imageIndex];
+    if (image.inFlight && image.inFlight != &frame.inFlight) image.inFlight->Await();
+    image.inFlight = &frame.inFlight;
+
+    frame.inFlight.Reset();
+    m_acquireTime = Clock::now();
+    m_waitTime = m_acquireTime - waitStart;
+    return true;
+}
+
+void Presenter::Submit(CmdBuffer &cmdBuffer, Flags<PipelineStage> waitStage) {
+    FrameSlot &frame = m_frames[m_frameIndex];
+    std::tuple<Flags<PipelineStage>, SemaphoreHandle> wait = {waitStage, frame.imageAvailable};
+    SemaphoreHandle signal = m_images[m_imageIndex].renderFinished;
+
+    cmdBuffer.Submit(
+        Span<const std::tuple<Flags<PipelineStage>, SemaphoreHandle>>(&wait, 1),
+        Span<const SemaphoreHandle>(&signal, 1), frame.inFlight
+    );
+}
+
+Result Presenter::Present() {
+    Clock::time_point presentTime = Clock::now();
+    SemaphoreHandle wait = m_images[m_imageIndex].renderFinished;
+    SwapchainHandle swapchain = m_swapchain;
+    uint64_t presentId = m_presentId + 1;
+
+    Result result = m_queue->Present(
+        Span<const SemaphoreHandle>(&wait, 1), Span<const SwapchainHandle>(&swapchain, 1),
+        Span<const uint32_t>(&m_imageIndex, 1), Span<const uint64_t>(&presentId, m_presentWait ? 1 : 0)
+    );
+    if (result == Result::ErrorOutOfDate || result == Result::Suboptimal) m_recreate = true;
+    m_presentId = presentId;
+
+    Sample &sample = m_samples[m_sampleCount % m_samples.size()];
+    sample.cpuTime = std::chrono::duration<float, std::milli>(presentTime - m_acquireTime).count();
+    sample.waitTime = std::chrono::duration<float, std::milli>(m_waitTime).count();
+    sample.presentInterval = -1;
+    if (m_presentWait && m_maxFramesAhead != 0) {
+        if (m_displayedCount != 0)
+            sample.presentInterval =
+                std::chrono::duration<float, std::milli>(m_displayedInterval).count() / m_displayedCount;
+    } else if (m_sampleCount != 0) {
+        sample.presentInterval = std::chrono::duration<float, std::milli>(presentTime - m_presentTime).count();
+    }
+    m_displayedInterval = Clock::duration(0);
+    m_displayedCount = 0;
+    m_presentTime = presentTime;
+    m_sampleCount++;
+
+    m_frameIndex = (m_frameIndex + 1) % m_frames.size();
+    return result;
+}
+
+void Presenter::Resize(uint32_t width, uint32_t height) {
+    m_width = width;
+    m_height = height;
+    m_recreate = true;
+}
+
+void Presenter::SetMaxFramesAhead(uint32_t maxFramesAhead) { m_maxFramesAhead = maxFramesAhead; }
+
+bool Presenter::WaitForPresent(uint64_t presentId, uint64_t timeout) {
+    assert(m_presentWait && presentId <= m_presentId);
+    if (presentId <= m_displayedPresentId) return true;
+
+    Result result = (Result)vkWaitForPresentKHR(
+        (DeviceHandle)*currentDevice, (SwapchainHandle)m_swapchain, presentId, timeout
+    );
+    if (result == Result::Timeout) return false;
+    if (result != Result::Success && result != Result::Suboptimal) {
+        // Presents to an out of date swapchain may never be displayed, they're treated as done.
+        m_recreate = true;
+        m_displayedPresentId = m_presentId;
+        m_timedPresentId = 0;
+        return false;
+    }
+
+    // Presents displayed since the last observed one share the interval evenly.
+    Clock::time_point now = Clock::now();
+    if (m_timedPresentId != 0) {
+        m_displayedInterval += now - m_timedPresentTime;
+        m_displayedCount += presentId - m_timedPresentId;
+    }
+    m_timedPresentId = presentId;
+    m_timedPresentTime = now;
+    m_displayedPresentId = presentId;
+    return true;
+}
+
+void Presenter::SetRecreateCallback(std::function<void(const Swapchain &)> callback) {
+    m_recreateCallback = std::move(callback);
+}
+
+void Presenter::WaitIdle() {
+    for (auto &&frame : m_frames) frame.inFlight.Await();
+}
+
+bool Presenter::Recreate() {
+    // The old swapchain may still be presenting and its images be in use, it's retired into the new one and destroyed
+    // once the device idles. Recreation is rare enough for the stall not to matter.
+    currentDevice->WaitUntilIdle();
+    Swapchain oldSwapchain = std::move(m_swapchain);
+    m_swapchain = Swapchain(
+        *m_surface, m_imageCount, m_width, m_height, (SwapchainHandle)oldSwapchain, m_usage, m_presentMode
+    );
+    m_recreate = false;
+    // Present ids are per swapchain, the old swapchain's presents are done once the device idles.
+    m_displayedPresentId = m_presentId;
+    m_timedPresentId = 0;
+
+    // Zero sized surfaces, e.g. minimized windows, get no swapchain until they're resized.
+    if ((SwapchainHandle)m_swapchain == nullptr) return false;
+
+    if (m_images.size() != m_swapchain.GetImageCount()) m_images.resize(m_swapchain.GetImageCount());
+    for (auto &&image : m_images) image.inFlight = nullptr;
+
+    if (m_recreateCallback) m_recreateCallback(m_swapchain);
+    return true;
+}
+
+void Presenter::LimitFramesAhead() {
+    if (m_maxFramesAhead == 0) return;
+
+    if (m_presentWait) {
+        if (m_presentId >= m_maxFramesAhead) WaitForPresent(m_presentId + 1 - m_maxFramesAhead);
+    } else if (m_maxFramesAhead < m_frames.size()) {
+        // Without present wait the end of rendering is the closest to display the CPU can observe.
+        m_frames[(m_frameIndex + m_frames.size() - m_maxFramesAhead) % m_frames.size()].inFlight.Await();
+    }
+}
+
+const Swapchain &Presenter::GetSwapchain() const { return m_swapchain; }
+
+const Surface &Presenter::GetSurface() const { return *m_surface; }
+
+uint32_t Presenter::GetFrameCount() const { return m_frames.size(); }
+
+uint32_t Presenter::GetFrameIndex() const { return m_frameIndex; }
+
+uint32_t Presenter::GetImageIndex() const { return m_imageIndex; }
+
+const Semaphore &Presenter::GetImageAvailable() const { return m_frames[m_frameIndex].imageAvailable; }
+
+const Semaphore &Presenter::GetRenderFinished() const { return m_images[m_imageIndex].renderFinished; }
+
+const Fence &Presenter::GetInFlightFence() const { return m_frames[m_frameIndex].inFlight; }
+
+uint64_t Presenter::GetPresentId() const { return m_presentId; }
+
+bool Presenter::IsPresentWaitSupported() const { return m_presentWait; }
+
+Presenter::Stats Presenter::GetStats() const {
+    Stats stats;
+    stats.frameCount = std::min<uint64_t>(m_sampleCount, m_samples.size());
+    if (stats.frameCount == 0) return stats;
+
+    uint32_t intervalCount = 0;
+    for (uint32_t i = 0; i < stats.frameCount; i++) {
+        const Sample &sample = m_samples[i];
+        stats.averageCpuTime += sample.cpuTime;
+        stats.maxCpuTime = std::max(stats.maxCpuTime, sample.cpuTime);
+        stats.averageWaitTime += sample.waitTime;
+        if (sample.presentInterval < 0) continue;
+        stats.averagePresentInterval += sample.presentInterval;
+        stats.maxPresentInterval = std::max(stats.maxPresentInterval, sample.presentInterval);
+        intervalCount++;
+    }
+    stats.averageCpuTime /= stats.frameCount;
+    stats.averageWaitTime /= stats.frameCount;
+    if (intervalCount != 0) stats.averagePresentInterval /= intervalCount;
+
+    return stats;
+}
+} // namespace vg
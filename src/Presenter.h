@@ -0,0 +1,246 @@
+#pragma once
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <utility>
+#include <vector>
+#include "CmdBuffer.h"
+#include "Enums.h"
+#include "Flags.h"
+#include "Queue.h"
+#include "Surface.h"
+#include "Swapchain.h"
+#include "Synchronization.h"
+
+namespace vg {
+/**
+ *@brief Drives a \ref Swapchain with several frames in flight
+ * Each frame slot owns an image available semaphore and an in flight fence, each swapchain image a render finished
+ * semaphore and the fence of the frame last rendering to it. \ref Presenter::Acquire() waits until the slot and the
+ * acquired image are free, so resources indexed by \ref Presenter::GetFrameIndex() can be reused safely. Out of date
+ * and suboptimal swapchains are recreated from the old swapchain. Nothing is allocated per frame.
+ *
+ * A frame is Acquire(), record, Submit(), Present(). Every successful Acquire() has to be followed by Submit().
+ *
+ * With VK_KHR_present_id and VK_KHR_present_wait enabled on the device and their features supported, see
+ * \ref Device::IsPresentWaitEnabled(), every present gets an id the CPU can wait for, which lets
+ * \ref Presenter::SetMaxFramesAhead() bound latency by displayed rather than rendered frames.
+ */
+class Presenter {
+  public:
+    /**
+     *@brief Frame pacing statistics over the last \ref Presenter::statsFrameCount frames, times in milliseconds
+     */
+    struct Stats {
+        /**
+         *@brief Time from Acquire() returning to Present(), i.e. spent recording the frame
+         */
+        float averageCpuTime = 0;
+        float maxCpuTime = 0;
+        /**
+         *@brief Time Acquire() blocked on frames in flight, the frames ahead limit and the swapchain
+         */
+        float averageWaitTime = 0;
+        /**
+         *@brief Time between presents, measured when they're displayed if present wait limits frames ahead, otherwise
+         * between Present() calls
+         */
+        float averagePresentInterval = 0;
+        float maxPresentInterval = 0;
+        uint32_t frameCount = 0;
+    };
+
+  public:
+    /**
+     *@brief Construct a new Presenter object
+     *
+     * @param surface Surface presented to, has to outlive the presenter
+     * @param queue Queue frames are submitted and presented on
+     * @param width Width used if the surface doesn't dictate it
+     * @param height Height used if the surface doesn't dictate it
+     * @param frameCount Count of frames recorded ahead of the GPU
+     * @param imageCount Count of swapchain images requested
+     * @param presentMode Present mode used if available
+     * @param usage Usage of swapchain images
+     */
+    Presenter(
+        const Surface &surface, Queue &queue, uint32_t width, uint32_t height, uint32_t frameCount = 2,
+        uint32_t imageCount = 3, PresentMode presentMode = PresentMode::Fifo,
+        Flags<Usage> usage = Usage::ColorAttachment
+    );
+
+    Presenter();
+    Presenter(Presenter &&other) noexcept;
+    Presenter(const Presenter &other) = delete;
+    ~Presenter();
+
+    Presenter &operator=(Presenter &&other) noexcept;
+    Presenter &operator=(const Presenter &other) = delete;
+
+    /**
+     *@brief Wait for the next frame slot and acquire a swapchain image
+     *
+     * @param timeout Timeout in nanoseconds of the acquire
+     * @return false if no image can be acquired, e.g. while the window is minimized, the frame should be skipped then
+     */
+    bool Acquire(uint64_t timeout = UINT64_MAX);
+
+    /**
+     *@brief Submit the frame's command buffer, it waits for the image and signals its fence and semaphore
+     *
+     * @param cmdBuffer Command buffer rendering to the acquired image
+     * @param waitStage Stage waiting for the image to be available
+     */
+    void Submit(CmdBuffer &cmdBuffer, Flags<PipelineStage> waitStage = PipelineStage::ColorAttachmentOutput);
+
+    /**
+     *@brief Present the acquired image and move to the next frame slot
+     *
+     * @return Result of the present, out of date and suboptimal swapchains are recreated by the next Acquire()
+     */
+    Result Present();
+
+    /**
+     *@brief Recreate the swapchain with a new size on the next Acquire()
+     */
+    void Resize(uint32_t width, uint32_t height);
+
+    /**
+     *@brief Limit how many frames the CPU may run ahead of presentation, fewer frames ahead means lower latency
+     * With present wait Acquire() waits until the present maxFramesAhead frames back is displayed, otherwise until that
+     * frame finished rendering, which can't limit below the frames queued by the presentation engine.
+     *
+     * @param maxFramesAhead Count of frames, 0 to be limited only by the frame count
+     */
+    void SetMaxFramesAhead(uint32_t maxFramesAhead);
+
+    /**
+     *@brief Wait until a present is displayed, requires present wait, see \ref Presenter::IsPresentWaitSupported()
+     *
+     * @param presentId Id of the present, at most \ref Presenter::GetPresentId()
+     * @param timeout Timeout in nanoseconds
+     * @return false on timeout or if the swapchain went out of date
+     */
+    bool WaitForPresent(uint64_t presentId, uint64_t timeout = UINT64_MAX);
+
+    /**
+     *@brief Set the function called after the swapchain was recreated, e.g. to rebuild framebuffers
+     */
+    void SetRecreateCallback(std::function<void(const Swapchain &)> callback);
+
+    /**
+     *@brief Wait for all frames in flight
+     */
+    void WaitIdle();
+
+    const Swapchain &GetSwapchain() const;
+    const Surface &GetSurface() const;
+    uint32_t GetFrameCount() const;
+    /**
+     *@brief Index of the current frame slot, less than \ref Presenter::GetFrameCount()
+     */
+    uint32_t GetFrameIndex() const;
+    uint32_t GetImageIndex() const;
+    const Semaphore &GetImageAvailable() const;
+    const Semaphore &GetRenderFinished() const;
+    const Fence &GetInFlightFence() const;
+    /**
+     *@brief Id of the last present, presents are numbered from 1
+     */
+    uint64_t GetPresentId() const;
+    bool IsPresentWaitSupported() const;
+    Stats GetStats() const;
+
+    /**
+     *@brief Count of frames \ref Presenter::GetStats() covers
+     */
+    static constexpr uint32_t statsFrameCount = 120;
+
+  private:
+    using Clock = std::chrono::steady_clock;
+
+    bool Recreate();
+    void LimitFramesAhead();
+
+  private:
+    struct FrameSlot {
+        Semaphore imageAvailable;
+        Fence inFlight;
+    };
+    struct ImageSlot {
+        Semaphore renderFinished;
+        /**
+         *@brief Fence of the frame that rendered to the image last
+         */
+        Fence *inFlight = nullptr;
+    };
+    struct Sample {
+        float cpuTime;
+        float waitTime;
+        /**
+         *@brief Negative if no present was measured
+         */
+        float presentInterval;
+    };
+
+    const Surface *m_surface;
+    Queue *m_queue;
+    Swapchain m_swapchain;
+    uint32_t m_width, m_height;
+    uint32_t m_imageCount;
+    PresentMode m_presentMode;
+    Flags<Usage> m_usage;
+
+    std::vector<FrameSlot> m_frames;
+    std::vector<ImageSlot> m_images;
+    uint32_t m_frameIndex;
+    uint32_t m_imageIndex;
+    bool m_recreate;
+
+    std::function<void(const Swapchain &)> m_recreateCallback;
+
+    bool m_presentWait;
+    uint32_t m_maxFramesAhead;
+    uint64_t m_presentId;
+    uint64_t m_displayedPresentId;
+    /**
+     *@brief Last present whose display was observed and when, 0 if none since the swapchain was created
+     */
+    uint64_t m_timedPresentId;
+    Clock::time_point m_timedPresentTime;
+    Clock::duration m_displayedInterval;
+    uint64_t m_displayedCount;
+
+    Clock::time_point m_acquireTime;
+    Clock::time_point m_presentTime;
+    Clock::duration m_waitTime;
+    std::vector<Sample> m_samples;
+    uint64_t m_sampleCount;
+};
+
+/**
+ *@brief One instance of a resource per frame slot of a \ref Presenter, e.g. command buffers or uniform buffers
+ */
+template <typename T> class PerFrame {
+  public:
+    /**
+     *@brief Construct every slot from the same arguments
+     */
+    template <typename... Args> PerFrame(const Presenter &presenter, const Args &...args) : m_presenter(&presenter) {
+        m_slots.reserve(presenter.GetFrameCount());
+        for (uint32_t i = 0; i < presenter.GetFrameCount(); i++) m_slots.emplace_back(args...);
+    }
+
+    /**
+     *@brief Slot of the current frame
+     */
+    T &operator*() { return m_slots[m_presenter->GetFrameIndex()]; }
+    T *operator->() { return &m_slots[m_presenter->GetFrameIndex()]; }
+    T &operator[](uint32_t frameIndex) { return m_slots[frameIndex]; }
+    uint32_t size() const { return m_slots.size(); }
+
+  private:
+    const Presenter *m_presenter;
+    std::vector<T> m_slots;
+};
+} // namespace vg
@@ -1,4 +1,5 @@
 #include <vulkan/vulkan.hpp>
+#include <cassert>
 #include <iostream>
 #include "Queue.h"
 #include "Structs.h"
@@ -51,9 +52,15 @@ namespace vg
         return m_commandPool;
     }
 
-    Result Queue::Present(Span<const SemaphoreHandle> waitSemaphores, Span<const SwapchainHandle> swapchains, Span<const uint32_t> imageIndices)
+    Result Queue::Present(Span<const SemaphoreHandle> waitSemaphores, Span<const SwapchainHandle> swapchains, Span<const uint32_t> imageIndices, Span<const uint64_t> presentIds)
     {
         vk::PresentInfoKHR info(*(Span<const vk::Semaphore>*) & waitSemaphores, *(Span<const vk::SwapchainKHR>*) & swapchains, imageIndices);
+        vk::PresentIdKHR presentIdInfo(presentIds.size(), presentIds.data());
+        if (presentIds.size() != 0)
+        {
+            assert(presentIds.size() == swapchains.size());
+            info.pNext = &presentIdInfo;
+        }
         return (Result) vkQueuePresentKHR(m_handle, (VkPresentInfoKHR*) &info);
     }
 
@@ -44,9 +44,10 @@ namespace vg
          * @param waitSemaphores Semaphores to await before presenting
          * @param swapchains array of Swapchains used for rendering
          * @param imageIndices indices of images from Swapchains
+         * @param presentIds optional ids of presents, one per Swapchain, requires VK_KHR_present_id
          * @return Result
          */
-        Result Present(Span<const SemaphoreHandle> waitSemaphores, Span<const SwapchainHandle> swapchains, Span<const uint32_t> imageIndices);
+        Result Present(Span<const SemaphoreHandle> waitSemaphores, Span<const SwapchainHandle> swapchains, Span<const uint32_t> imageIndices, Span<const uint64_t> presentIds = {});
 
         void Submit(Span<const class SubmitInfo> submits, const class Fence& fence);
 
@@ -0,0 +1,151 @@
+#include <vulkan/vulkan.hpp>
+#include "Readback.h"
+#include "MemoryManager.h"
+#include <map>
+
+namespace vg {
+Readback::Readback(const Queue &queue, uint64_t stagingSize, uint32_t frameCount)
+    : m_currentFrame(0), m_stagingSize(stagingSize) {
+    assert(frameCount > 0);
+
+    m_frames.resize(frameCount);
+    std::vector<Buffer *> stagingBuffers(frameCount);
+    for (uint32_t i = 0; i < frameCount; i++) {
+        m_frames[i].staging = Buffer(stagingSize, {BufferUsage::TransferDst});
+        m_frames[i].cmdBuffer = CmdBuffer(queue, false);
+        stagingBuffers[i] = &m_frames[i].staging;
+    }
+
+    // Host cached memory makes CPU reads fast, fall back to coherent memory if device has none.
+    try {
+        Allocate(stagingBuffers, {MemoryProperty::HostVisible, MemoryProperty::HostCached});
+    } catch (const std::runtime_error &) {
+        Allocate(stagingBuffers, {MemoryProperty::HostVisible, MemoryProperty::HostCoherent});
+    }
+
+    for (auto &&frame : m_frames) frame.staging.MapMemory();
+}
+
+Readback::Readback() : m_currentFrame(0), m_stagingSize(0) {}
+
+Readback::Readback(Readback &&other) noexcept : Readback() { *this = std::move(other); }
+
+Readback::~Readback() {
+    // Deliver every queued read, otherwise callbacks are never called and futures are left with broken promises.
+    Flush();
+}
+
+Readback &Readback::operator=(Readback &&other) noexcept {
+    if (&other == this) return *this;
+
+    std::swap(m_frames, other.m_frames);
+    std::swap(m_currentFrame, other.m_currentFrame);
+    std::swap(m_stagingSize, other.m_stagingSize);
+
+    return *this;
+}
+
+void Readback::Read(const Buffer &src, uint64_t size, uint64_t srcOffset, Callback callback) {
+    assert(size <= m_stagingSize);
+    if (!CanRead(size)) throw std::runtime_error("Readback frame is full, Submit() has to be called first");
+
+    uint64_t dstOffset = GetNextOffset();
+    Frame &frame = m_frames[m_currentFrame];
+    frame.requests.push_back({src, srcOffset, dstOffset, size, std::move(callback)});
+    frame.usedSize = dstOffset + size;
+}
+
+std::future<std::vector<char>> Readback::Read(const Buffer &src, uint64_t size, uint64_t srcOffset) {
+    return Read<char>(src, size, srcOffset);
+}
+
+bool Readback::CanRead(uint64_t size) const { return GetNextOffset() + size <= m_stagingSize; }
+
+void Readback::Submit(
+    Span<const std::tuple<Flags<PipelineStage>, SemaphoreHandle>> waitStages, Flags<PipelineStage> srcStages
+) {
+    Frame &frame = m_frames[m_currentFrame];
+    if (frame.requests.empty() && waitStages.empty()) return;
+
+    // Merge copies from the same source buffer into one command.
+    std::map<VkBuffer, cmd::CopyBuffer> copies;
+    for (auto &&request : frame.requests) {
+        cmd::CopyBuffer &copy = copies[(VkBuffer)request.src];
+        copy.src = request.src;
+        copy.dst = frame.staging;
+        copy.regions.push_back(BufferCopyRegion(request.size, request.srcOffset, request.dstOffset));
+    }
+
+    frame.cmdBuffer.Clear().Begin().Append(cmd::PipelineBarier(
+        srcStages, PipelineStage::Transfer,
+        std::vector<MemoryBarrier>{MemoryBarrier(Access::MemoryWrite, Access::TransferRead)}
+    ));
+    for (auto &&[src, copy] : copies) frame.cmdBuffer.Append(copy);
+    frame.cmdBuffer
+        .Append(cmd::PipelineBarier(
+            PipelineStage::Transfer, PipelineStage::Host,
+            std::vector<MemoryBarrier>{MemoryBarrier(Access::TransferWrite, Access::HostRead)}
+        ))
+        .End()
+        .Submit(waitStages, {}, frame.fence);
+    frame.inFlight = true;
+
+    // Reuse the oldest frame, this is the only place that waits on the GPU.
+    m_currentFrame = (m_currentFrame + 1) % m_frames.size();
+    Frame &next = m_frames[m_currentFrame];
+    if (next.inFlight) {
+        next.fence.Await();
+        Deliver(next);
+    }
+}
+
+uint32_t Readback::Poll() {
+    uint32_t delivered = 0;
+
+    // Deliver from the oldest frame so reads complete in submission order.
+    for (uint32_t i = 1; i <= m_frames.size(); i++) {
+        Frame &frame = m_frames[(m_currentFrame + i) % m_frames.size()];
+        if (!frame.inFlight) continue;
+        if (!frame.fence.IsSignaled()) break;
+        delivered += Deliver(frame);
+    }
+
+    return delivered;
+}
+
+void Readback::Flush() {
+    if (m_frames.empty()) return;
+
+    Submit();
+    for (uint32_t i = 0; i < m_frames.size(); i++) {
+        Frame &frame = m_frames[(m_currentFrame + i) % m_frames.size()];
+        if (!frame.inFlight) continue;
+        frame.fence.Await();
+        Deliver(frame);
+    }
+}
+
+uint32_t Readback::GetFrameCount() const { return m_frames.size(); }
+
+uint64_t Readback::GetStagingSize() const { return m_stagingSize; }
+
+uint32_t Readback::Deliver(Frame &frame) {
+    frame.fence.Reset();
+    frame.inFlight = false;
+    frame.staging.InvalidateMemory();
+
+    const char *data = frame.staging.MapMemory();
+    for (auto &&request : frame.requests)
+        request.callback(Span<const char>(data + request.dstOffset, request.size));
+
+    uint32_t delivered = frame.requests.size();
+    frame.requests.clear();
+    frame.usedSize = 0;
+    return delivered;
+}
+
+uint64_t Readback::GetNextOffset() const {
+    // Keep copies 16 byte aligned so the data can be reinterpreted as any vector type.
+    return (m_frames[m_currentFrame].usedSize + 15) & ~15ULL;
+}
+} // namespace vg
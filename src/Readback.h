@@ -0,0 +1,131 @@
+#pragma once
+#include <functional>
+#include <future>
+#include <vector>
+#include "Handle.h"
+#include "Buffer.h"
+#include "CmdBuffer.h"
+#include "Synchronization.h"
+#include "Span.h"
+
+namespace vg {
+/**
+ *@brief Reads device local buffers back to the CPU without stalling
+ * Copies are batched into a ring of host cached staging buffers, one per frame. Results are handed back when the
+ * frame's fence signals, so the CPU runs at most frameCount frames behind the GPU and only waits when the ring is full.
+ */
+class Readback {
+  public:
+    typedef std::function<void(Span<const char> data)> Callback;
+
+  public:
+    /**
+     *@brief Construct a new Readback object
+     *
+     * @param queue Queue used to submit copies, must support transfer operations
+     * @param stagingSize Size in bytes of the staging buffer of each frame, limits how much can be read in one frame
+     * @param frameCount Count of frames that can be in flight at once
+     */
+    Readback(const Queue &queue, uint64_t stagingSize, uint32_t frameCount = 2);
+
+    Readback();
+    Readback(Readback &&other) noexcept;
+    Readback(const Readback &other) = delete;
+    /**
+     *@brief Flushes, so every queued read is delivered, source buffers of queued reads have to be still alive
+     */
+    ~Readback();
+
+    Readback &operator=(Readback &&other) noexcept;
+    Readback &operator=(const Readback &other) = delete;
+
+    /**
+     *@brief Queue a read of the buffer region
+     * The copy is recorded on the next \ref Readback::Submit(), callback is called from \ref Readback::Poll() or
+     * \ref Readback::Flush() once the data arrives. The span is only valid for the duration of the callback.
+     * Reads never submit on their own, as only the caller knows what the copies have to wait for. Once the frame's
+     * staging buffer is full, the caller has to \ref Readback::Submit() before reading more.
+     *
+     * @param src Buffer to read from, must have BufferUsage::TransferSrc
+     * @param size Size in bytes, throws std::runtime_error if it doesn't fit into the current frame, see
+     * \ref Readback::CanRead()
+     * @param srcOffset Offset in bytes into src
+     * @param callback Function receiving the data
+     */
+    void Read(const Buffer &src, uint64_t size, uint64_t srcOffset, Callback callback);
+
+    /**
+     *@brief Queue a read of the buffer region
+     *
+     * @return future that becomes ready once the data arrives, \ref Readback::Poll() or \ref Readback::Flush() has to
+     * be called for that to happen
+     */
+    std::future<std::vector<char>> Read(const Buffer &src, uint64_t size, uint64_t srcOffset = 0);
+
+    template <typename T> std::future<std::vector<T>> Read(const Buffer &src, uint64_t count, uint64_t srcOffset = 0) {
+        auto promise = std::make_shared<std::promise<std::vector<T>>>();
+        Read(src, count * sizeof(T), srcOffset, [promise](Span<const char> data) {
+            promise->set_value(std::vector<T>((const T *)data.data(), (const T *)(data.data() + data.size())));
+        });
+        return promise->get_future();
+    }
+
+    /**
+     *@brief Check if a read of size bytes fits into the current frame
+     */
+    bool CanRead(uint64_t size) const;
+
+    /**
+     *@brief Record and submit copies queued in the current frame, then move to the next frame
+     * Blocks only if the next frame is still in flight.
+     *
+     * @param waitStages Semaphores to await before copying
+     * @param srcStages Stages that write the buffers being read
+     */
+    void Submit(
+        Span<const std::tuple<Flags<PipelineStage>, SemaphoreHandle>> waitStages = {},
+        Flags<PipelineStage> srcStages = PipelineStage::AllCommands
+    );
+
+    /**
+     *@brief Hand back data of all finished frames, never blocks
+     *
+     * @return Count of delivered reads
+     */
+    uint32_t Poll();
+
+    /**
+     *@brief Submit pending copies and block until all reads are delivered
+     */
+    void Flush();
+
+    uint32_t GetFrameCount() const;
+    uint64_t GetStagingSize() const;
+
+  private:
+    struct Request {
+        BufferHandle src;
+        uint64_t srcOffset;
+        uint64_t dstOffset;
+        uint64_t size;
+        Callback callback;
+    };
+
+    struct Frame {
+        Buffer staging;
+        CmdBuffer cmdBuffer;
+        Fence fence;
+        std::vector<Request> requests;
+        uint64_t usedSize = 0;
+        bool inFlight = false;
+    };
+
+    uint32_t Deliver(Frame &frame);
+    uint64_t GetNextOffset() const;
+
+  private:
+    std::vector<Frame> m_frames;
+    uint32_t m_currentFrame;
+    uint64_t m_stagingSize;
+};
+} // namespace vg
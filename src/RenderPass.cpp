@@ -1,7 +1,9 @@
 #include <vulkan/vulkan.hpp>
 #include "RenderPass.h"
 #include "Device.h"
+#include "GraphicsPipelineCreateInfo.h"
 
+#include <deque>
 #include <iostream>
 namespace vg {
 RenderPass::RenderPass(
@@ -40,44 +42,18 @@ RenderPass::RenderPass(
     m_handle = ((DeviceHandle)*currentDevice).createRenderPass(renderPassInfo);
 
     // Graphics pipelines.
-    std::vector<vk::GraphicsPipelineCreateInfo> graphicPipelineCreateInfos;
-    std::vector<std::vector<vk::PipelineShaderStageCreateInfo>> shaderStages;
-    std::vector<vk::PipelineDynamicStateCreateInfo> dynamicStates;
-    graphicPipelineCreateInfos.resize(subpasses.size());
-    shaderStages.resize(subpasses.size());
-    dynamicStates.resize(subpasses.size());
+    std::deque<GraphicsPipelineCreateInfo> createInfos;
+    std::vector<vk::GraphicsPipelineCreateInfo> graphicPipelineCreateInfos(subpasses.size());
     m_graphicsPipelines.resize(subpasses.size());
     for (unsigned int i = 0; i < subpasses.size(); i++) {
-        const Subpass &subpass = subpasses.begin()[i];
         const GraphicsPipeline &pipeline = subpasses.begin()[i].graphicsPipeline;
 
-        shaderStages[i].resize(pipeline.shaders.size());
-        for (int j = 0; j < pipeline.shaders.size(); j++) shaderStages[i][j] = *pipeline.shaders[j];
-
-        auto *vertexInput = (vk::PipelineVertexInputStateCreateInfo *)&pipeline.vertexInput;
-        auto *inputAssembly = (vk::PipelineInputAssemblyStateCreateInfo *)&pipeline.inputAssembly;
-        auto *tesselation = (vk::PipelineTessellationStateCreateInfo *)&pipeline.tesselation;
-        auto *viewportState = (vk::PipelineViewportStateCreateInfo *)&pipeline.viewportState;
-        auto *rasterizer = (vk::PipelineRasterizationStateCreateInfo *)&pipeline.rasterizer;
-        auto *multisampling = (vk::PipelineMultisampleStateCreateInfo *)&pipeline.multisampling;
-        auto *depthStencil = (vk::PipelineDepthStencilStateCreateInfo *)&pipeline.depthStencil;
-        auto *colorBlending = (vk::PipelineColorBlendStateCreateInfo *)&pipeline.colorBlending;
-
-        dynamicStates[i] =
-            vk::PipelineDynamicStateCreateInfo({}, *(std::vector<vk::DynamicState> *)&pipeline.dynamicState);
-
-        vk::PipelineCreateFlags flags = {};
-        flags |= vk::PipelineCreateFlagBits::eAllowDerivatives;
-
-        if (pipeline.parent || pipeline.parentIndex) flags |= vk::PipelineCreateFlagBits::eDerivative;
-
-        graphicPipelineCreateInfos[i] = vk::GraphicsPipelineCreateInfo(
-            flags, shaderStages[i], vertexInput, inputAssembly, tesselation, viewportState, rasterizer, multisampling,
-            depthStencil, colorBlending, &dynamicStates[i], m_pipelineLayouts[pipeline.pipelineLayout],
-            (vk::RenderPass)m_handle, i, pipeline.parent, pipeline.parentIndex
+        GraphicsPipelineCreateInfo &createInfo = createInfos.emplace_back(
+            pipeline, m_pipelineLayouts[pipeline.pipelineLayout], m_handle, i,
+            vk::PipelineCreateFlagBits::eAllowDerivatives
         );
+        graphicPipelineCreateInfos[i] = createInfo.SetBase(pipeline.parent, pipeline.parentIndex);
     }
-
     vkCreateGraphicsPipelines(
         (DeviceHandle)*currentDevice, (PipelineCacheHandle)cache, graphicPipelineCreateInfos.size(),
         (VkGraphicsPipelineCreateInfo *)graphicPipelineCreateInfos.data(), nullptr,
@@ -124,42 +100,17 @@ RenderPass::RenderPass(
     m_handle = ((DeviceHandle)*currentDevice).createRenderPass(renderPassInfo);
 
     // Graphics pipelines.
-    std::vector<vk::GraphicsPipelineCreateInfo> graphicPipelineCreateInfos;
-    std::vector<std::vector<vk::PipelineShaderStageCreateInfo>> shaderStages;
-    std::vector<vk::PipelineDynamicStateCreateInfo> dynamicStates;
-    graphicPipelineCreateInfos.resize(subpasses.size());
-    shaderStages.resize(subpasses.size());
-    dynamicStates.resize(subpasses.size());
+    std::deque<GraphicsPipelineCreateInfo> createInfos;
+    std::vector<vk::GraphicsPipelineCreateInfo> graphicPipelineCreateInfos(subpasses.size());
     m_graphicsPipelines.resize(subpasses.size());
     for (unsigned int i = 0; i < subpasses.size(); i++) {
-        const Subpass &subpass = subpasses.begin()[i];
         const GraphicsPipeline &pipeline = subpasses.begin()[i].graphicsPipeline;
 
-        shaderStages[i].resize(pipeline.shaders.size());
-        for (int j = 0; j < pipeline.shaders.size(); j++) shaderStages[i][j] = *pipeline.shaders[j];
-
-        auto *vertexInput = (vk::PipelineVertexInputStateCreateInfo *)&pipeline.vertexInput;
-        auto *inputAssembly = (vk::PipelineInputAssemblyStateCreateInfo *)&pipeline.inputAssembly;
-        auto *tesselation = (vk::PipelineTessellationStateCreateInfo *)&pipeline.tesselation;
-        auto *viewportState = (vk::PipelineViewportStateCreateInfo *)&pipeline.viewportState;
-        auto *rasterizer = (vk::PipelineRasterizationStateCreateInfo *)&pipeline.rasterizer;
-        auto *multisampling = (vk::PipelineMultisampleStateCreateInfo *)&pipeline.multisampling;
-        auto *depthStencil = (vk::PipelineDepthStencilStateCreateInfo *)&pipeline.depthStencil;
-        auto *colorBlending = (vk::PipelineColorBlendStateCreateInfo *)&pipeline.colorBlending;
-
-        dynamicStates[i] =
-            vk::PipelineDynamicStateCreateInfo({}, *(std::vector<vk::DynamicState> *)&pipeline.dynamicState);
-
-        vk::PipelineCreateFlags flags = {};
-        flags |= vk::PipelineCreateFlagBits::eAllowDerivatives;
-
-        if (pipeline.parent || pipeline.parentIndex != -1) flags |= vk::PipelineCreateFlagBits::eDerivative;
-
-        graphicPipelineCreateInfos[i] = vk::GraphicsPipelineCreateInfo(
-            flags, shaderStages[i], vertexInput, inputAssembly, tesselation, viewportState, rasterizer, multisampling,
-            depthStencil, colorBlending, &dynamicStates[i], m_pipelineLayouts[pipeline.pipelineLayout],
-            (vk::RenderPass)m_handle, i, pipeline.parent, pipeline.parentIndex
+        GraphicsPipelineCreateInfo &createInfo = createInfos.emplace_back(
+            pipeline, m_pipelineLayouts[pipeline.pipelineLayout], m_handle, i,
+            vk::PipelineCreateFlagBits::eAllowDerivatives
         );
+        graphicPipelineCreateInfos[i] = createInfo.SetBase(pipeline.parent, pipeline.parentIndex);
     }
     vkCreateGraphicsPipelines(
         (DeviceHandle)*currentDevice, (PipelineCacheHandle)cache, graphicPipelineCreateInfos.size(),
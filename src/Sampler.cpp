@@ -1,9 +1,13 @@
 #include <vulkan/vulkan.hpp>
 #include "Sampler.h"
+#include "SamplerCache.h"
 #include "Device.h"
 namespace vg
 {
-    Sampler::Sampler(
+    static SamplerDescription Describe(
+        float maxAnisotropy,
+        bool compareEnable,
+        vg::CompareOp compareOp,
         Filter magFilter,
         Filter minFilter,
         SamplerMipmapMode mipmapMode,
@@ -17,34 +21,27 @@ namespace vg
         BorderColor borderColor,
         bool unnormalizedCoordinates)
     {
-        void* pNext = nullptr;
-        vk::SamplerReductionModeCreateInfo reductionModeCreateInfo((vk::SamplerReductionMode) samplerReduction);
-        if (samplerReduction != SamplerReduction::WeightedAverage)
-            pNext = &reductionModeCreateInfo;
-
-        m_handle = ((DeviceHandle) *currentDevice).createSampler({
-            {},
-            (vk::Filter) magFilter,
-            (vk::Filter) minFilter,
-            (vk::SamplerMipmapMode) mipmapMode,
-            (vk::SamplerAddressMode) uAddressMode,
-            (vk::SamplerAddressMode) vAddressMode,
-            (vk::SamplerAddressMode) wAddressMode,
-            mipLodBias,
-            false,
-            0,
-            false,
-            (vk::CompareOp) CompareOp::Never,
-            minLod,
-            maxLod,
-            (vk::BorderColor) borderColor,
-            unnormalizedCoordinates,
-            pNext
-            });
+        SamplerDescription description;
+        description.magFilter = magFilter;
+        description.minFilter = minFilter;
+        description.mipmapMode = mipmapMode;
+        description.uAddressMode = uAddressMode;
+        description.vAddressMode = vAddressMode;
+        description.wAddressMode = wAddressMode;
+        description.mipLodBias = mipLodBias;
+        description.anisotropyEnable = maxAnisotropy != 0;
+        description.maxAnisotropy = maxAnisotropy;
+        description.compareEnable = compareEnable;
+        description.compareOp = compareEnable ? compareOp : CompareOp::Never;
+        description.minLod = minLod;
+        description.maxLod = maxLod;
+        description.borderColor = borderColor;
+        description.unnormalizedCoordinates = unnormalizedCoordinates;
+        description.samplerReduction = samplerReduction;
+        return description;
     }
 
     Sampler::Sampler(
-        float maxAnisotropy,
         Filter magFilter,
         Filter minFilter,
         SamplerMipmapMode mipmapMode,
@@ -57,32 +54,25 @@ namespace vg
         SamplerReduction samplerReduction,
         BorderColor borderColor,
         bool unnormalizedCoordinates)
-    {
-        void* pNext = nullptr;
-        vk::SamplerReductionModeCreateInfo reductionModeCreateInfo((vk::SamplerReductionMode) samplerReduction);
-        if (samplerReduction != SamplerReduction::WeightedAverage)
-            pNext = &reductionModeCreateInfo;
+        :Sampler(Describe(0, false, CompareOp::Never, magFilter, minFilter, mipmapMode, uAddressMode, vAddressMode, wAddressMode, mipLodBias, minLod, maxLod, samplerReduction, borderColor, unnormalizedCoordinates))
+    {}
 
-        m_handle = ((DeviceHandle) *currentDevice).createSampler({
-            {},
-            (vk::Filter) magFilter,
-            (vk::Filter) minFilter,
-            (vk::SamplerMipmapMode) mipmapMode,
-            (vk::SamplerAddressMode) uAddressMode,
-            (vk::SamplerAddressMode) vAddressMode,
-            (vk::SamplerAddressMode) wAddressMode,
-            mipLodBias,
-            true,
-            maxAnisotropy,
-            false,
-            (vk::CompareOp) CompareOp::Never,
-            minLod,
-            maxLod,
-            (vk::BorderColor) borderColor,
-            unnormalizedCoordinates,
-            pNext
-            });
-    }
+    Sampler::Sampler(
+        float maxAnisotropy,
+        Filter magFilter,
+        Filter minFilter,
+        SamplerMipmapMode mipmapMode,
+        SamplerAddressMode uAddressMode,
+        SamplerAddressMode vAddressMode,
+        SamplerAddressMode wAddressMode,
+        float mipLodBias,
+        float minLod,
+        float maxLod,
+        SamplerReduction samplerReduction,
+        BorderColor borderColor,
+        bool unnormalizedCoordinates)
+        :Sampler(Describe(maxAnisotropy, false, CompareOp::Never, magFilter, minFilter, mipmapMode, uAddressMode, vAddressMode, wAddressMode, mipLodBias, minLod, maxLod, samplerReduction, borderColor, unnormalizedCoordinates))
+    {}
 
     Sampler::Sampler(
         vg::CompareOp compareOp,
@@ -98,32 +88,8 @@ namespace vg
         SamplerReduction samplerReduction,
         BorderColor borderColor,
         bool unnormalizedCoordinates)
-    {
-        void* pNext = nullptr;
-        vk::SamplerReductionModeCreateInfo reductionModeCreateInfo((vk::SamplerReductionMode) samplerReduction);
-        if (samplerReduction != SamplerReduction::WeightedAverage)
-            pNext = &reductionModeCreateInfo;
-
-        m_handle = ((DeviceHandle) *currentDevice).createSampler({
-            {},
-            (vk::Filter) magFilter,
-            (vk::Filter) minFilter,
-            (vk::SamplerMipmapMode) mipmapMode,
-            (vk::SamplerAddressMode) uAddressMode,
-            (vk::SamplerAddressMode) vAddressMode,
-            (vk::SamplerAddressMode) wAddressMode,
-            mipLodBias,
-            false,
-            0,
-            true,
-            (vk::CompareOp) compareOp,
-            minLod,
-            maxLod,
-            (vk::BorderColor) borderColor,
-            unnormalizedCoordinates,
-            pNext
-            });
-    }
+        :Sampler(Describe(0, true, compareOp, magFilter, minFilter, mipmapMode, uAddressMode, vAddressMode, wAddressMode, mipLodBias, minLod, maxLod, samplerReduction, borderColor, unnormalizedCoordinates))
+    {}
 
     Sampler::Sampler(
         float maxAnisotropy,
@@ -140,31 +106,12 @@ namespace vg
         SamplerReduction samplerReduction,
         BorderColor borderColor,
         bool unnormalizedCoordinates)
-    {
-        void* pNext = nullptr;
-        vk::SamplerReductionModeCreateInfo reductionModeCreateInfo((vk::SamplerReductionMode) samplerReduction);
-        if (samplerReduction != SamplerReduction::WeightedAverage)
-            pNext = &reductionModeCreateInfo;
+        :Sampler(Describe(maxAnisotropy, true, compareOp, magFilter, minFilter, mipmapMode, uAddressMode, vAddressMode, wAddressMode, mipLodBias, minLod, maxLod, samplerReduction, borderColor, unnormalizedCoordinates))
+    {}
 
-        m_handle = ((DeviceHandle) *currentDevice).createSampler({
-            {},
-            (vk::Filter) magFilter,
-            (vk::Filter) minFilter,
-            (vk::SamplerMipmapMode) mipmapMode,
-            (vk::SamplerAddressMode) uAddressMode,
-            (vk::SamplerAddressMode) vAddressMode,
-            (vk::SamplerAddressMode) wAddressMode,
-            mipLodBias,
-            true,
-            maxAnisotropy,
-            true,
-            (vk::CompareOp) compareOp,
-            minLod,
-            maxLod,
-            (vk::BorderColor) borderColor,
-            unnormalizedCoordinates,
-            pNext
-            });
+    Sampler::Sampler(const SamplerDescription& description)
+    {
+        m_handle = currentDevice->GetSamplerCache().Acquire(description);
     }
 
     Sampler::Sampler() : m_handle(nullptr) {}
@@ -174,10 +121,15 @@ namespace vg
     {
         *this = std::move(other);
     }
+    Sampler::Sampler(const Sampler& other)
+        :Sampler()
+    {
+        *this = other;
+    }
     Sampler::~Sampler()
     {
         if (!m_handle)return;
-        ((DeviceHandle) *currentDevice).destroySampler(m_handle);
+        currentDevice->GetSamplerCache().Release(m_handle);
         m_handle = nullptr;
     }
 
@@ -189,9 +141,19 @@ namespace vg
 
         return *this;
     }
+    Sampler& Sampler::operator=(const Sampler& other)
+    {
+        if (this == &other) return *this;
+
+        Sampler copy;
+        copy.m_handle = other.m_handle;
+        if (copy.m_handle) currentDevice->GetSamplerCache().AddReference(copy.m_handle);
+
+        return *this = std::move(copy);
+    }
     Sampler::operator const SamplerHandle& () const
     {
         return m_handle;
     }
 
-}
\ No newline at end of file
+}
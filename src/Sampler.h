@@ -4,6 +4,12 @@
 
 namespace vg
 {
+    struct SamplerDescription;
+
+    /**
+     *@brief Sampler shared through the device \ref SamplerCache
+     * Samplers with identical state share one handle, copies share it too.
+     */
     class Sampler
     {
     public:
@@ -67,13 +73,15 @@ namespace vg
             BorderColor borderColor = BorderColor::FloatTransparentBlack,
             bool unnormalizedCoordinates = false);
 
+        Sampler(const SamplerDescription& description);
+
         Sampler();
         Sampler(Sampler&& other) noexcept;
-        Sampler(const Sampler& other) = delete;
+        Sampler(const Sampler& other);
         ~Sampler();
 
         Sampler& operator=(Sampler&& other) noexcept;
-        Sampler& operator=(const Sampler& other) = delete;
+        Sampler& operator=(const Sampler& other);
         operator const SamplerHandle& () const;
 
     private:
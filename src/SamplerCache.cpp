@@ -0,0 +1,84 @@
+#include <vulkan/vulkan.hpp>
+#include <cstring>
+#include "SamplerCache.h"
+#include "Device.h"
+
+namespace vg {
+static uint64_t HandleKey(const SamplerHandle &handle) { return *(const uint64_t *)&handle; }
+
+SamplerCache::SamplerCache(uint32_t limit) : m_limit(limit) {}
+
+SamplerCache::~SamplerCache() {
+    for (auto &&[description, entry] : m_samplers) ((DeviceHandle)*currentDevice).destroySampler(entry.handle);
+}
+
+SamplerHandle SamplerCache::Acquire(const SamplerDescription &description) {
+    std::lock_guard lock(m_mutex);
+    auto it = m_samplers.find(description);
+    if (it != m_samplers.end()) {
+        it->second.referenceCount++;
+        return it->second.handle;
+    }
+
+    if (m_samplers.size() >= m_limit)
+        throw std::runtime_error("Sampler limit of " + std::to_string(m_limit) + " unique samplers reached");
+
+    vk::SamplerReductionModeCreateInfo reductionModeCreateInfo(
+        (vk::SamplerReductionMode)description.samplerReduction
+    );
+    vk::SamplerCreateInfo createInfo(
+        {}, (vk::Filter)description.magFilter, (vk::Filter)description.minFilter,
+        (vk::SamplerMipmapMode)description.mipmapMode, (vk::SamplerAddressMode)description.uAddressMode,
+        (vk::SamplerAddressMode)description.vAddressMode, (vk::SamplerAddressMode)description.wAddressMode,
+        description.mipLodBias, description.anisotropyEnable, description.maxAnisotropy, description.compareEnable,
+        (vk::CompareOp)description.compareOp, description.minLod, description.maxLod,
+        (vk::BorderColor)description.borderColor, description.unnormalizedCoordinates
+    );
+    if (description.samplerReduction != SamplerReduction::WeightedAverage) createInfo.pNext = &reductionModeCreateInfo;
+
+    SamplerHandle handle = ((DeviceHandle)*currentDevice).createSampler(createInfo);
+    m_samplers[description] = {handle, 1};
+    m_descriptions[HandleKey(handle)] = description;
+    return handle;
+}
+
+void SamplerCache::AddReference(SamplerHandle sampler) {
+    std::lock_guard lock(m_mutex);
+    m_samplers.at(m_descriptions.at(HandleKey(sampler))).referenceCount++;
+}
+
+void SamplerCache::Release(SamplerHandle sampler) {
+    std::lock_guard lock(m_mutex);
+    auto description = m_descriptions.find(HandleKey(sampler));
+    auto it = m_samplers.find(description->second);
+    if (--it->second.referenceCount != 0) return;
+
+    ((DeviceHandle)*currentDevice).destroySampler(sampler);
+    m_samplers.erase(it);
+    m_descriptions.erase(description);
+}
+
+uint32_t SamplerCache::GetSamplerCount() const {
+    std::lock_guard lock(m_mutex);
+    return m_samplers.size();
+}
+
+uint32_t SamplerCache::GetLimit() const { return m_limit; }
+
+size_t SamplerCache::Hash::operator()(const SamplerDescription &description) const {
+    // Every field is 4 bytes, so the struct has no padding and its bytes can be hashed directly.
+    static_assert(sizeof(SamplerDescription) == 16 * 4);
+
+    uint64_t hash = 14695981039346656037ULL;
+    const unsigned char *bytes = (const unsigned char *)&description;
+    for (size_t i = 0; i < sizeof(description); i++) {
+        hash ^= bytes[i];
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+bool SamplerCache::Equal::operator()(const SamplerDescription &a, const SamplerDescription &b) const {
+    return std::memcmp(&a, &b, sizeof(SamplerDescription)) == 0;
+}
+} // namespace vg
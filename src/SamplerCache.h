@@ -0,0 +1,83 @@
+#pragma once
+#include <mutex>
+#include <unordered_map>
+#include "Handle.h"
+#include "Enums.h"
+
+namespace vg {
+/**
+ *@brief Full state of a sampler, every field takes part in deduplication
+ */
+struct SamplerDescription {
+    Filter magFilter = Filter::Nearest;
+    Filter minFilter = Filter::Nearest;
+    SamplerMipmapMode mipmapMode = SamplerMipmapMode::Nearest;
+    SamplerAddressMode uAddressMode = SamplerAddressMode::Repeat;
+    SamplerAddressMode vAddressMode = SamplerAddressMode::Repeat;
+    SamplerAddressMode wAddressMode = SamplerAddressMode::Repeat;
+    float mipLodBias = 0;
+    uint32_t anisotropyEnable = false;
+    float maxAnisotropy = 0;
+    uint32_t compareEnable = false;
+    CompareOp compareOp = CompareOp::Never;
+    float minLod = 0;
+    float maxLod = 1000;
+    BorderColor borderColor = BorderColor::FloatTransparentBlack;
+    uint32_t unnormalizedCoordinates = false;
+    SamplerReduction samplerReduction = SamplerReduction::WeightedAverage;
+};
+
+/**
+ *@brief Device wide cache of samplers
+ * Identical descriptions share one handle, handles are reference counted and destroyed with the last reference. Every
+ * device owns one cache, \ref Sampler uses it automatically. All methods are thread safe.
+ */
+class SamplerCache {
+  public:
+    /**
+     *@brief Construct a new Sampler Cache object
+     *
+     * @param limit Maximum count of unique samplers, usually maxSamplerAllocationCount of the device
+     */
+    SamplerCache(uint32_t limit);
+
+    SamplerCache(SamplerCache &&other) = delete;
+    SamplerCache(const SamplerCache &other) = delete;
+    ~SamplerCache();
+
+    SamplerCache &operator=(SamplerCache &&other) = delete;
+    SamplerCache &operator=(const SamplerCache &other) = delete;
+
+    /**
+     *@brief Get a reference to the sampler with the description, creating it if needed
+     * Throws if a new sampler would exceed the limit, existing samplers can still be acquired.
+     *
+     * @return Handle, has to be released with \ref SamplerCache::Release()
+     */
+    SamplerHandle Acquire(const SamplerDescription &description);
+    void AddReference(SamplerHandle sampler);
+    void Release(SamplerHandle sampler);
+
+    uint32_t GetSamplerCount() const;
+    uint32_t GetLimit() const;
+
+  private:
+    struct Hash {
+        size_t operator()(const SamplerDescription &description) const;
+    };
+
+    struct Equal {
+        bool operator()(const SamplerDescription &a, const SamplerDescription &b) const;
+    };
+
+    struct Entry {
+        SamplerHandle handle;
+        uint32_t referenceCount;
+    };
+
+    mutable std::mutex m_mutex;
+    std::unordered_map<SamplerDescription, Entry, Hash, Equal> m_samplers;
+    std::unordered_map<uint64_t, SamplerDescription> m_descriptions;
+    uint32_t m_limit;
+};
+} // namespace vg
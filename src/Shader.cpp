@@ -1,22 +1,23 @@
 #include <vulkan/vulkan.hpp>
 #include "Shader.h"
-#include <fstream>
-#include <iostream>
-#include <math.h>
+#include "MappedFile.h"
+#include <stdexcept>
+#include <string>
 
 namespace vg {
 Shader::Shader(ShaderStage stage, const char *path) : m_stage(stage) {
-    std::ifstream file(path, std::ios::ate | std::ios::binary);
+    MappedFile file(path);
+    if (!IsValidCode(file.GetData(), file.GetSize()))
+        throw std::runtime_error(std::string("Invalid SPIR-V in shader file: ") + path);
 
-    if (!file.is_open()) { std::cout << "Failed to open shader file at path: " << path << '\n'; }
+    m_handle =
+        ((DeviceHandle)*currentDevice).createShaderModule({{}, file.GetSize(), (const uint32_t *)file.GetData()});
+}
 
-    unsigned int fileSize = file.tellg();
-    std::vector<char> code(fileSize);
-    file.seekg(0);
-    file.read(code.data(), fileSize);
-    file.close();
+Shader::Shader(ShaderStage stage, Span<const uint32_t> code) : m_stage(stage) {
+    if (!IsValidCode(code.data(), code.size_bytes())) throw std::runtime_error("Invalid SPIR-V shader code");
 
-    m_handle = ((DeviceHandle)*currentDevice).createShaderModule({{}, code.size(), (const uint32_t *)code.data()});
+    m_handle = ((DeviceHandle)*currentDevice).createShaderModule({{}, code.size_bytes(), code.data()});
 }
 
 Shader::Shader() : m_handle(nullptr), m_stage(ShaderStage::Vertex) {}
@@ -34,6 +35,7 @@ Shader &Shader::operator=(Shader &&other) noexcept {
 
     std::swap(m_handle, other.m_handle);
     std::swap(m_stage, other.m_stage);
+    std::swap(m_specialization, other.m_specialization);
 
     return *this;
 }
@@ -42,10 +44,23 @@ ShaderStage Shader::GetStage() const { return m_stage; }
 
 Shader::operator const ShaderHandle &() const { return m_handle; }
 
+void Shader::SetSpecialization(const SpecializationConstants &specialization) { m_specialization = specialization; }
+
+const SpecializationConstants &Shader::GetSpecialization() const { return m_specialization; }
+
+bool Shader::IsValidCode(const void *code, uint64_t size) {
+    // Header is magic, version, generator, bound and schema.
+    const uint32_t magic = 0x07230203;
+    if (code == nullptr || size < 5 * sizeof(uint32_t) || size % sizeof(uint32_t) != 0) return false;
+
+    return *(const uint32_t *)code == magic;
+}
+
 #ifdef VULKAN_HPP
 Shader::operator vk::PipelineShaderStageCreateInfo() const {
     return vk::PipelineShaderStageCreateInfo(
-        {}, (vk::ShaderStageFlagBits)GetStage(), (vg::ShaderHandle)m_handle, "main"
+        {}, (vk::ShaderStageFlagBits)GetStage(), (vg::ShaderHandle)m_handle, "main",
+        m_specialization.IsEmpty() ? nullptr : (const vk::SpecializationInfo *)m_specialization.GetInfo()
     );
 }
 #endif
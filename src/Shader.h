@@ -2,6 +2,8 @@
 #include "Handle.h"
 #include "Device.h"
 #include "Enums.h"
+#include "Span.h"
+#include "SpecializationConstants.h"
 namespace vg
 {
     /**
@@ -16,9 +18,16 @@ namespace vg
          *
          * @param ((DeviceHandle)currentDevice).Device
          * @param shaderStage Shader stage
-         * @param path path to source file in GLSL
+         * @param path path to compiled SPIR-V file, throws std::runtime_error if it can't be read or is not valid SPIR-V
          */
         Shader(ShaderStage shaderStage, const char* path);
+        /**
+         *@brief Construct a new Shader object from SPIR-V already in memory
+         *
+         * @param shaderStage Shader stage
+         * @param code SPIR-V words, throws std::runtime_error if they are not valid SPIR-V
+         */
+        Shader(ShaderStage shaderStage, Span<const uint32_t> code);
 
         Shader();
         Shader(Shader&& other) noexcept;
@@ -36,6 +45,19 @@ namespace vg
          */
         ShaderStage GetStage() const;
 
+        /**
+         *@brief Set specialization constants used by every pipeline created with this shader from now on
+         * Pipelines keep pointers to the constants until they are created, don't change them while a pipeline using
+         * the shader is being compiled.
+         */
+        void SetSpecialization(const SpecializationConstants& specialization);
+        const SpecializationConstants& GetSpecialization() const;
+
+        /**
+         *@brief Check SPIR-V magic number and that size is a whole number of words holding at least the header
+         */
+        static bool IsValidCode(const void* code, uint64_t size);
+
 #ifdef VULKAN_HPP
         operator vk::PipelineShaderStageCreateInfo() const;
 #endif
@@ -43,5 +65,6 @@ namespace vg
     private:
         ShaderHandle m_handle;
         ShaderStage m_stage;
+        SpecializationConstants m_specialization;
     };
 }
\ No newline at end of file
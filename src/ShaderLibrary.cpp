@@ -0,0 +1,184 @@
+#include <vulkan/vulkan.hpp>
+#include "ShaderLibrary.h"
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+namespace vg {
+// Archive layout: header, records, name strings, then 4 byte aligned SPIR-V blobs. Offsets are from file start.
+struct ShaderArchiveHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t entryCount;
+    uint32_t reserved;
+};
+
+struct ShaderArchiveRecord {
+    uint32_t nameOffset;
+    uint32_t nameSize;
+    ShaderStage stage;
+    uint32_t codeOffset;
+    uint32_t codeSize;
+};
+
+static const uint32_t shaderArchiveMagic = 0x41534756; // "VGSA"
+static const uint32_t shaderArchiveVersion = 1;
+
+ShaderLibrary::ShaderLibrary() {}
+
+ShaderLibrary::ShaderLibrary(ShaderLibrary &&other) noexcept : ShaderLibrary() { *this = std::move(other); }
+
+ShaderLibrary &ShaderLibrary::operator=(ShaderLibrary &&other) noexcept {
+    if (&other == this) return *this;
+
+    std::swap(m_modules, other.m_modules);
+    std::swap(m_files, other.m_files);
+    std::swap(m_copies, other.m_copies);
+    std::swap(m_paths, other.m_paths);
+    std::swap(m_names, other.m_names);
+
+    return *this;
+}
+
+const Shader &ShaderLibrary::Load(ShaderStage stage, const char *path) {
+    auto it = m_paths.find(path);
+    if (it != m_paths.end() && it->second->GetStage() == stage) return *it->second;
+
+    MappedFile file(path);
+    if (!Shader::IsValidCode(file.GetData(), file.GetSize()))
+        throw std::runtime_error(std::string("Invalid SPIR-V in shader file: ") + path);
+
+    Span<const uint32_t> code((const uint32_t *)file.GetData(), file.GetSize() / sizeof(uint32_t));
+    uint64_t hash = Hash(stage, code);
+    const Shader *shader = Find(stage, code, hash);
+    if (!shader) {
+        shader = &Add(stage, code, hash);
+        m_files.push_back(std::move(file));
+    }
+
+    m_paths[path] = shader;
+    return *shader;
+}
+
+const Shader &ShaderLibrary::Load(ShaderStage stage, Span<const uint32_t> code) {
+    if (!Shader::IsValidCode(code.data(), code.size_bytes())) throw std::runtime_error("Invalid SPIR-V shader code");
+
+    uint64_t hash = Hash(stage, code);
+    if (const Shader *shader = Find(stage, code, hash)) return *shader;
+
+    m_copies.emplace_back(code.begin(), code.end());
+    return Add(stage, m_copies.back(), hash);
+}
+
+uint32_t ShaderLibrary::LoadArchive(const char *path) {
+    MappedFile file(path);
+    const char *data = file.GetData();
+    uint64_t size = file.GetSize();
+
+    ShaderArchiveHeader header;
+    if (size < sizeof(header)) throw std::runtime_error(std::string("Shader archive is truncated: ") + path);
+    memcpy(&header, data, sizeof(header));
+    if (header.magic != shaderArchiveMagic || header.version != shaderArchiveVersion)
+        throw std::runtime_error(std::string("Not a shader archive: ") + path);
+    if (sizeof(header) + (uint64_t)header.entryCount * sizeof(ShaderArchiveRecord) > size)
+        throw std::runtime_error(std::string("Shader archive is truncated: ") + path);
+
+    // The mapping is kept once the first module is created from it, data stays valid after the move.
+    bool retained = false;
+    const ShaderArchiveRecord *records = (const ShaderArchiveRecord *)(data + sizeof(header));
+    for (uint32_t i = 0; i < header.entryCount; i++) {
+        const ShaderArchiveRecord &record = records[i];
+        if ((uint64_t)record.nameOffset + record.nameSize > size ||
+            (uint64_t)record.codeOffset + record.codeSize > size || record.codeOffset % sizeof(uint32_t) != 0 ||
+            !Shader::IsValidCode(data + record.codeOffset, record.codeSize))
+            throw std::runtime_error(std::string("Corrupt entry in shader archive: ") + path);
+
+        Span<const uint32_t> code((const uint32_t *)(data + record.codeOffset), record.codeSize / sizeof(uint32_t));
+        uint64_t hash = Hash(record.stage, code);
+        const Shader *shader = Find(record.stage, code, hash);
+        if (!shader) {
+            shader = &Add(record.stage, code, hash);
+            if (!retained) m_files.push_back(std::move(file));
+            retained = true;
+        }
+
+        m_names[std::string(data + record.nameOffset, record.nameSize)] = shader;
+    }
+
+    return header.entryCount;
+}
+
+const Shader &ShaderLibrary::Get(const std::string &name) const { return *m_names.at(name); }
+
+bool ShaderLibrary::Contains(const std::string &name) const { return m_names.contains(name); }
+
+uint32_t ShaderLibrary::GetModuleCount() const { return m_modules.size(); }
+
+void ShaderLibrary::WriteArchive(const char *path, Span<const ArchiveEntry> entries) {
+    std::vector<MappedFile> files;
+    files.reserve(entries.size());
+    for (auto &&entry : entries) {
+        files.emplace_back(entry.path.c_str());
+        if (!Shader::IsValidCode(files.back().GetData(), files.back().GetSize()))
+            throw std::runtime_error("Invalid SPIR-V in shader file: " + entry.path);
+    }
+
+    ShaderArchiveHeader header = {shaderArchiveMagic, shaderArchiveVersion, (uint32_t)entries.size(), 0};
+    std::vector<ShaderArchiveRecord> records(entries.size());
+
+    uint32_t offset = sizeof(header) + sizeof(ShaderArchiveRecord) * records.size();
+    for (uint32_t i = 0; i < entries.size(); i++) {
+        records[i].nameOffset = offset;
+        records[i].nameSize = entries[i].name.size();
+        records[i].stage = entries[i].stage;
+        offset += entries[i].name.size();
+    }
+
+    // SPIR-V is read as words, so the first blob has to start aligned.
+    uint32_t paddingSize = ((offset + 3) & ~3U) - offset;
+    offset += paddingSize;
+    for (uint32_t i = 0; i < entries.size(); i++) {
+        records[i].codeOffset = offset;
+        records[i].codeSize = files[i].GetSize();
+        offset += files[i].GetSize();
+    }
+
+    std::ofstream archive(path, std::ios_base::binary | std::ios_base::out | std::ios_base::trunc);
+    archive.write((const char *)&header, sizeof(header));
+    archive.write((const char *)records.data(), sizeof(ShaderArchiveRecord) * records.size());
+    for (auto &&entry : entries) archive.write(entry.name.data(), entry.name.size());
+
+    const char padding[4] = {};
+    archive.write(padding, paddingSize);
+    for (auto &&file : files) archive.write(file.GetData(), file.GetSize());
+
+    if (!archive) throw std::runtime_error(std::string("Failed to write shader archive: ") + path);
+}
+
+uint64_t ShaderLibrary::Hash(ShaderStage stage, Span<const uint32_t> code) {
+    // FNV-1a over the code, seeded with stage and size.
+    uint64_t hash = 14695981039346656037ULL ^ ((uint64_t)stage << 32 | code.size_bytes());
+    const uint8_t *bytes = (const uint8_t *)code.data();
+    for (uint64_t i = 0; i < code.size_bytes(); i++) {
+        hash ^= bytes[i];
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+const Shader *ShaderLibrary::Find(ShaderStage stage, Span<const uint32_t> code, uint64_t hash) const {
+    auto [begin, end] = m_modules.equal_range(hash);
+    for (auto it = begin; it != end; it++) {
+        const Module &module = it->second;
+        if (module.stage == stage && module.code.size() == code.size() &&
+            std::memcmp(module.code.data(), code.data(), code.size_bytes()) == 0)
+            return &module.shader;
+    }
+    return nullptr;
+}
+
+const Shader &ShaderLibrary::Add(ShaderStage stage, Span<const uint32_t> code, uint64_t hash) {
+    Module module = {stage, code, Shader(stage, code)};
+    return m_modules.emplace(hash, std::move(module))->second.shader;
+}
+} // namespace vg
@@ -0,0 +1,101 @@
+#pragma once
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "MappedFile.h"
+#include "Shader.h"
+#include "Span.h"
+
+namespace vg {
+/**
+ *@brief Loads and owns shader modules, creating each distinct module once
+ * SPIR-V files are memory mapped and handed to the driver without copying. Modules are deduplicated by content hash, so
+ * the same code loaded from different paths or archives shares one module. Mappings backing a module are kept open to
+ * tell colliding hashes apart, code loaded from memory is copied once per new module. Shaders stay valid for the
+ * lifetime of the library.
+ */
+class ShaderLibrary {
+  public:
+    /**
+     *@brief Entry of a shader archive
+     */
+    struct ArchiveEntry {
+        std::string name;
+        ShaderStage stage;
+        std::string path;
+    };
+
+  public:
+    ShaderLibrary();
+    ShaderLibrary(ShaderLibrary &&other) noexcept;
+    ShaderLibrary(const ShaderLibrary &other) = delete;
+
+    ShaderLibrary &operator=(ShaderLibrary &&other) noexcept;
+    ShaderLibrary &operator=(const ShaderLibrary &other) = delete;
+
+    /**
+     *@brief Load a SPIR-V file, files already loaded are not read again
+     *
+     * @param stage Shader stage
+     * @param path Path to the SPIR-V file, throws std::runtime_error if it can't be read or is not valid SPIR-V
+     * @return Shader owned by the library
+     */
+    const Shader &Load(ShaderStage stage, const char *path);
+
+    /**
+     *@brief Load SPIR-V from memory, the code is copied if it creates a new module
+     *
+     * @param stage Shader stage
+     * @param code SPIR-V words, throws std::runtime_error if they are not valid SPIR-V
+     * @return Shader owned by the library
+     */
+    const Shader &Load(ShaderStage stage, Span<const uint32_t> code);
+
+    /**
+     *@brief Load every shader of an archive written by \ref ShaderLibrary::WriteArchive()
+     * The archive is mapped once and modules are created straight from the mapping. Shaders are then available through
+     * \ref ShaderLibrary::Get(). Throws std::runtime_error if the archive is malformed.
+     *
+     * @param path Path to the archive
+     * @return Count of shaders in the archive
+     */
+    uint32_t LoadArchive(const char *path);
+
+    /**
+     *@brief Get shader loaded from an archive by its name, throws std::out_of_range if there is none
+     */
+    const Shader &Get(const std::string &name) const;
+    bool Contains(const std::string &name) const;
+    uint32_t GetModuleCount() const;
+
+    /**
+     *@brief Pack SPIR-V files into a single archive
+     *
+     * @param path Path of the archive to write
+     * @param entries Shaders to pack, throws std::runtime_error if any of them can't be read or is not valid SPIR-V
+     */
+    static void WriteArchive(const char *path, Span<const ArchiveEntry> entries);
+
+  private:
+    struct Module {
+        ShaderStage stage;
+        /**
+         *@brief Code inside a mapping or copy owned by the library, compared on hash hits so colliding modules are
+         * told apart
+         */
+        Span<const uint32_t> code;
+        Shader shader;
+    };
+
+    static uint64_t Hash(ShaderStage stage, Span<const uint32_t> code);
+    const Shader *Find(ShaderStage stage, Span<const uint32_t> code, uint64_t hash) const;
+    const Shader &Add(ShaderStage stage, Span<const uint32_t> code, uint64_t hash);
+
+  private:
+    std::unordered_multimap<uint64_t, Module> m_modules;
+    std::vector<MappedFile> m_files;
+    std::vector<std::vector<uint32_t>> m_copies;
+    std::unordered_map<std::string, const Shader *> m_paths;
+    std::unordered_map<std::string, const Shader *> m_names;
+};
+} // namespace vg
@@ -0,0 +1,454 @@
+#include <vulkan/vulkan.hpp>
+#include "ShaderReflection.h"
+#include "Shader.h"
+#include "MappedFile.h"
+#include "FormatInfo.h"
+#include <algorithm>
+#include <functional>
+#include <map>
+#include <stdexcept>
+#include <string>
+
+namespace vg {
+// Subset of the SPIR-V specification needed for reflection.
+namespace spv {
+enum Op : uint32_t {
+    OpEntryPoint = 15,
+    OpExecutionMode = 16,
+    OpTypeBool = 20,
+    OpTypeInt = 21,
+    OpTypeFloat = 22,
+    OpTypeVector = 23,
+    OpTypeMatrix = 24,
+    OpTypeImage = 25,
+    OpTypeSampler = 26,
+    OpTypeSampledImage = 27,
+    OpTypeArray = 28,
+    OpTypeRuntimeArray = 29,
+    OpTypeStruct = 30,
+    OpTypePointer = 32,
+    OpConstantTrue = 41,
+    OpConstantFalse = 42,
+    OpConstant = 43,
+    OpConstantComposite = 44,
+    OpSpecConstantTrue = 48,
+    OpSpecConstantFalse = 49,
+    OpSpecConstant = 50,
+    OpSpecConstantComposite = 51,
+    OpVariable = 59,
+    OpDecorate = 71,
+    OpMemberDecorate = 72,
+    OpExecutionModeId = 331,
+    OpTypeAccelerationStructureKHR = 5341,
+};
+
+enum Decoration : uint32_t {
+    SpecId = 1,
+    Block = 2,
+    BufferBlock = 3,
+    ArrayStride = 6,
+    MatrixStride = 7,
+    BuiltIn = 11,
+    Location = 30,
+    Binding = 33,
+    DescriptorSet = 34,
+    Offset = 35,
+};
+
+enum StorageClass : uint32_t {
+    UniformConstant = 0,
+    Input = 1,
+    Uniform = 2,
+    PushConstant = 9,
+    StorageBuffer = 12,
+};
+
+const uint32_t BuiltInWorkgroupSize = 25;
+const uint32_t ExecutionModeLocalSize = 17;
+const uint32_t ExecutionModeLocalSizeId = 38;
+const uint32_t DimBuffer = 5;
+const uint32_t DimSubpassData = 6;
+} // namespace spv
+
+static ShaderStage ExecutionModelToStage(uint32_t executionModel) {
+    switch (executionModel) {
+    case 0: return ShaderStage::Vertex;
+    case 1: return ShaderStage::TessellationControl;
+    case 2: return ShaderStage::TessellationEvaluation;
+    case 3: return ShaderStage::Geometry;
+    case 4: return ShaderStage::Fragment;
+    case 5: return ShaderStage::Compute;
+    case 5267:
+    case 5364: return ShaderStage::Task;
+    case 5268:
+    case 5365: return ShaderStage::Mesh;
+    default: throw std::runtime_error("Unsupported SPIR-V execution model: " + std::to_string(executionModel));
+    }
+}
+
+ShaderReflection::ShaderReflection(Span<const uint32_t> code) : ShaderReflection() {
+    if (!Shader::IsValidCode(code.data(), code.size_bytes())) throw std::runtime_error("Invalid SPIR-V shader code");
+
+    Reflect(code.data(), code.size());
+}
+
+ShaderReflection::ShaderReflection(const char *path) : ShaderReflection() {
+    MappedFile file(path);
+    if (!Shader::IsValidCode(file.GetData(), file.GetSize()))
+        throw std::runtime_error(std::string("Invalid SPIR-V in shader file: ") + path);
+
+    Reflect((const uint32_t *)file.GetData(), file.GetSize() / sizeof(uint32_t));
+}
+
+ShaderReflection::ShaderReflection()
+    : m_workgroupSize{1, 1, 1}, m_workgroupSizeSpecializationIds{noSpecializationId, noSpecializationId,
+                                                                  noSpecializationId} {}
+
+ShaderReflection &ShaderReflection::Merge(const ShaderReflection &other) {
+    m_stages |= other.m_stages;
+
+    if (m_descriptorSetLayouts.size() < other.m_descriptorSetLayouts.size())
+        m_descriptorSetLayouts.resize(other.m_descriptorSetLayouts.size());
+    for (uint32_t set = 0; set < other.m_descriptorSetLayouts.size(); set++) {
+        auto &bindings = m_descriptorSetLayouts[set];
+        for (auto &&binding : other.m_descriptorSetLayouts[set]) {
+            auto it = std::find_if(bindings.begin(), bindings.end(), [&](const DescriptorSetLayoutBinding &b) {
+                return b.binding == binding.binding;
+            });
+            if (it == bindings.end()) {
+                bindings.push_back(binding);
+                continue;
+            }
+
+            if (it->descriptorType != binding.descriptorType)
+                throw std::runtime_error(
+                    "Stages disagree on type of set " + std::to_string(set) + " binding " +
+                    std::to_string(binding.binding)
+                );
+            it->stageFlags |= binding.stageFlags;
+            it->descriptorCount = std::max(it->descriptorCount, binding.descriptorCount);
+        }
+        std::sort(bindings.begin(), bindings.end(), [](const auto &a, const auto &b) { return a.binding < b.binding; });
+    }
+
+    // One range visible to all stages using push constants keeps vkCmdPushConstants simple.
+    for (auto &&range : other.m_pushConstantRanges) {
+        if (m_pushConstantRanges.empty()) {
+            m_pushConstantRanges.push_back(range);
+            continue;
+        }
+        PushConstantRange &merged = m_pushConstantRanges[0];
+        uint32_t end = std::max(merged.offset + merged.size, range.offset + range.size);
+        merged.offset = std::min(merged.offset, range.offset);
+        merged.size = end - merged.offset;
+        merged.stageFlags |= range.stageFlags;
+    }
+
+    for (auto &&constant : other.m_specializationConstants) {
+        auto it = std::find_if(
+            m_specializationConstants.begin(), m_specializationConstants.end(),
+            [&](const SpecializationConstant &c) { return c.id == constant.id; }
+        );
+        if (it == m_specializationConstants.end()) m_specializationConstants.push_back(constant);
+    }
+
+    if (other.m_stages.IsSet(ShaderStage::Vertex)) m_vertexInputs = other.m_vertexInputs;
+    if (other.m_stages.IsSet(ShaderStage::Compute)) {
+        m_workgroupSize = other.m_workgroupSize;
+        m_workgroupSizeSpecializationIds = other.m_workgroupSizeSpecializationIds;
+    }
+
+    return *this;
+}
+
+Flags<ShaderStage> ShaderReflection::GetStages() const { return m_stages; }
+
+const std::vector<std::vector<DescriptorSetLayoutBinding>> &ShaderReflection::GetDescriptorSetLayouts() const {
+    return m_descriptorSetLayouts;
+}
+
+const std::vector<PushConstantRange> &ShaderReflection::GetPushConstantRanges() const { return m_pushConstantRanges; }
+
+const std::vector<ShaderReflection::SpecializationConstant> &ShaderReflection::GetSpecializationConstants() const {
+    return m_specializationConstants;
+}
+
+const std::vector<VertexAttribute> &ShaderReflection::GetVertexInputs() const { return m_vertexInputs; }
+
+const std::array<uint32_t, 3> &ShaderReflection::GetWorkgroupSize() const { return m_workgroupSize; }
+
+const std::array<uint32_t, 3> &ShaderReflection::GetWorkgroupSizeSpecializationIds() const {
+    return m_workgroupSizeSpecializationIds;
+}
+
+PipelineLayout ShaderReflection::CreatePipelineLayout() const {
+    return PipelineLayout(m_descriptorSetLayouts, m_pushConstantRanges);
+}
+
+VertexLayout ShaderReflection::CreateVertexLayout(uint32_t binding) const {
+    std::vector<VertexAttribute> attributes(m_vertexInputs);
+    uint32_t offset = 0;
+    for (auto &&attribute : attributes) {
+        attribute.binding = binding;
+        attribute.offset = offset;
+
+        offset += GetFormatResolutions(attribute.format) / 8;
+    }
+
+    return VertexLayout({VertexBinding(binding, offset, InputRate::Vertex)}, attributes);
+}
+
+void ShaderReflection::Reflect(const uint32_t *code, uint64_t wordCount) {
+    uint32_t bound = code[3];
+    std::vector<const uint32_t *> instructions(bound, nullptr);
+
+    std::vector<uint32_t> bindings(bound, ~0U), sets(bound, ~0U), locations(bound, ~0U), specIds(bound, ~0U);
+    std::vector<uint32_t> builtIns(bound, ~0U), arrayStrides(bound, 0);
+    std::vector<bool> blocks(bound, false), bufferBlocks(bound, false);
+    std::map<std::pair<uint32_t, uint32_t>, uint32_t> memberOffsets, memberMatrixStrides;
+    std::vector<uint32_t> variables;
+
+    uint32_t executionModel = ~0U, entryPoint = ~0U;
+    std::array<uint32_t, 3> localSizeIds = {~0U, ~0U, ~0U};
+
+    for (uint64_t i = 5; i < wordCount;) {
+        const uint32_t *instruction = code + i;
+        uint32_t opcode = instruction[0] & 0xFFFF;
+        uint32_t count = instruction[0] >> 16;
+        if (count == 0 || i + count > wordCount) throw std::runtime_error("Malformed SPIR-V instruction");
+        i += count;
+
+        auto setResult = [&](uint32_t resultIndex) {
+            if (instruction[resultIndex] < bound) instructions[instruction[resultIndex]] = instruction;
+        };
+
+        switch (opcode) {
+        case spv::OpEntryPoint:
+            if (entryPoint != ~0U) break;
+            executionModel = instruction[1];
+            entryPoint = instruction[2];
+            break;
+        case spv::OpExecutionMode:
+            if (instruction[1] == entryPoint && instruction[2] == spv::ExecutionModeLocalSize)
+                m_workgroupSize = {instruction[3], instruction[4], instruction[5]};
+            break;
+        case spv::OpExecutionModeId:
+            if (instruction[1] == entryPoint && instruction[2] == spv::ExecutionModeLocalSizeId)
+                localSizeIds = {instruction[3], instruction[4], instruction[5]};
+            break;
+        case spv::OpDecorate: {
+            uint32_t target = instruction[1];
+            if (target >= bound) break;
+            switch (instruction[2]) {
+            case spv::SpecId: specIds[target] = instruction[3]; break;
+            case spv::Block: blocks[target] = true; break;
+            case spv::BufferBlock: bufferBlocks[target] = true; break;
+            case spv::ArrayStride: arrayStrides[target] = instruction[3]; break;
+            case spv::BuiltIn: builtIns[target] = instruction[3]; break;
+            case spv::Location: locations[target] = instruction[3]; break;
+            case spv::Binding: bindings[target] = instruction[3]; break;
+            case spv::DescriptorSet: sets[target] = instruction[3]; break;
+            }
+            break;
+        }
+        case spv::OpMemberDecorate:
+            if (instruction[3] == spv::Offset) memberOffsets[{instruction[1], instruction[2]}] = instruction[4];
+            if (instruction[3] == spv::MatrixStride)
+                memberMatrixStrides[{instruction[1], instruction[2]}] = instruction[4];
+            break;
+        case spv::OpTypeBool:
+        case spv::OpTypeInt:
+        case spv::OpTypeFloat:
+        case spv::OpTypeVector:
+        case spv::OpTypeMatrix:
+        case spv::OpTypeImage:
+        case spv::OpTypeSampler:
+        case spv::OpTypeSampledImage:
+        case spv::OpTypeArray:
+        case spv::OpTypeRuntimeArray:
+        case spv::OpTypeStruct:
+        case spv::OpTypePointer:
+        case spv::OpTypeAccelerationStructureKHR: setResult(1); break;
+        case spv::OpConstantTrue:
+        case spv::OpConstantFalse:
+        case spv::OpConstant:
+        case spv::OpConstantComposite:
+        case spv::OpSpecConstantTrue:
+        case spv::OpSpecConstantFalse:
+        case spv::OpSpecConstant:
+        case spv::OpSpecConstantComposite: setResult(2); break;
+        case spv::OpVariable:
+            setResult(2);
+            variables.push_back(instruction[2]);
+            break;
+        }
+    }
+
+    if (entryPoint == ~0U) throw std::runtime_error("SPIR-V has no entry point");
+    ShaderStage stage = ExecutionModelToStage(executionModel);
+    m_stages = stage;
+
+    auto get = [&](uint32_t id) -> const uint32_t * {
+        if (id >= bound || instructions[id] == nullptr) throw std::runtime_error("SPIR-V references undefined id");
+        return instructions[id];
+    };
+    auto opcodeOf = [&](uint32_t id) { return get(id)[0] & 0xFFFF; };
+    auto constantValue = [&](uint32_t id) -> uint64_t {
+        const uint32_t *constant = get(id);
+        uint32_t op = constant[0] & 0xFFFF;
+        if (op == spv::OpConstantTrue || op == spv::OpSpecConstantTrue) return 1;
+        if (op == spv::OpConstantFalse || op == spv::OpSpecConstantFalse) return 0;
+        if ((constant[0] >> 16) > 4) return constant[3] | (uint64_t)constant[4] << 32;
+        return constant[3];
+    };
+
+    std::function<uint32_t(uint32_t)> sizeOf = [&](uint32_t type) -> uint32_t {
+        const uint32_t *t = get(type);
+        switch (t[0] & 0xFFFF) {
+        case spv::OpTypeBool: return 4;
+        case spv::OpTypeInt:
+        case spv::OpTypeFloat: return t[2] / 8;
+        case spv::OpTypeVector:
+        case spv::OpTypeMatrix: return t[3] * sizeOf(t[2]);
+        case spv::OpTypeArray: {
+            uint32_t stride = arrayStrides[type] ? arrayStrides[type] : sizeOf(t[2]);
+            return constantValue(t[3]) * stride;
+        }
+        case spv::OpTypeStruct: {
+            uint32_t size = 0;
+            for (uint32_t member = 0; member < (t[0] >> 16) - 2; member++) {
+                uint32_t memberType = t[2 + member];
+                uint32_t memberSize = sizeOf(memberType);
+                auto matrixStride = memberMatrixStrides.find({type, member});
+                if (matrixStride != memberMatrixStrides.end() && opcodeOf(memberType) == spv::OpTypeMatrix)
+                    memberSize = matrixStride->second * get(memberType)[3];
+
+                auto offset = memberOffsets.find({type, member});
+                size = std::max(size, (offset != memberOffsets.end() ? offset->second : size) + memberSize);
+            }
+            return size;
+        }
+        default: return 0;
+        }
+    };
+
+    // Specialization constants.
+    for (uint32_t id = 0; id < bound; id++) {
+        if (specIds[id] == ~0U || instructions[id] == nullptr) continue;
+        uint32_t op = opcodeOf(id);
+        if (op != spv::OpSpecConstant && op != spv::OpSpecConstantTrue && op != spv::OpSpecConstantFalse) continue;
+
+        m_specializationConstants.push_back({specIds[id], sizeOf(get(id)[1]), constantValue(id)});
+    }
+    std::sort(m_specializationConstants.begin(), m_specializationConstants.end(), [](const auto &a, const auto &b) {
+        return a.id < b.id;
+    });
+
+    // Workgroup size, the WorkgroupSize built-in overrides the execution mode.
+    auto setWorkgroupSize = [&](uint32_t component, uint32_t id) {
+        m_workgroupSize[component] = constantValue(id);
+        if (specIds[id] != ~0U) m_workgroupSizeSpecializationIds[component] = specIds[id];
+    };
+    if (localSizeIds[0] != ~0U)
+        for (uint32_t i = 0; i < 3; i++) setWorkgroupSize(i, localSizeIds[i]);
+    for (uint32_t id = 0; id < bound; id++) {
+        if (builtIns[id] != spv::BuiltInWorkgroupSize || instructions[id] == nullptr) continue;
+        uint32_t op = opcodeOf(id);
+        if (op != spv::OpConstantComposite && op != spv::OpSpecConstantComposite) continue;
+        for (uint32_t i = 0; i < 3; i++) setWorkgroupSize(i, get(id)[3 + i]);
+    }
+
+    for (uint32_t variable : variables) {
+        const uint32_t *instruction = get(variable);
+        uint32_t storageClass = instruction[3];
+        const uint32_t *pointer = get(instruction[1]);
+        uint32_t type = pointer[3];
+
+        if (storageClass == spv::PushConstant) {
+            const uint32_t *t = get(type);
+            uint32_t offset = ~0U;
+            for (uint32_t member = 0; member < (t[0] >> 16) - 2; member++) {
+                auto memberOffset = memberOffsets.find({type, member});
+                if (memberOffset != memberOffsets.end()) offset = std::min(offset, memberOffset->second);
+            }
+            if (offset == ~0U) offset = 0;
+
+            m_pushConstantRanges.push_back(PushConstantRange(stage, offset, sizeOf(type) - offset));
+            continue;
+        }
+
+        if (storageClass == spv::Input && stage == ShaderStage::Vertex) {
+            if (locations[variable] == ~0U || builtIns[variable] != ~0U) continue;
+
+            // Matrices take one location per column.
+            uint32_t columns = 1;
+            if (opcodeOf(type) == spv::OpTypeMatrix) {
+                columns = get(type)[3];
+                type = get(type)[2];
+            }
+
+            uint32_t componentCount = 1, componentType = type;
+            if (opcodeOf(type) == spv::OpTypeVector) {
+                componentCount = get(type)[3];
+                componentType = get(type)[2];
+            }
+            const uint32_t *component = get(componentType);
+            uint32_t width = component[2];
+            uint32_t kind = (component[0] & 0xFFFF) == spv::OpTypeFloat ? 2 : component[3] ? 1 : 0;
+
+            // Formats of one width are ordered R, RG, RGB, RGBA, each as UINT, SINT, SFLOAT for 32 and 64 bit.
+            Format format;
+            if (width == 64) format = (Format)((uint32_t)Format::R64UINT + kind + 3 * (componentCount - 1));
+            else if (width == 16) format = (Format)((uint32_t)Format::R16UINT + kind + 7 * (componentCount - 1));
+            else format = (Format)((uint32_t)Format::R32UINT + kind + 3 * (componentCount - 1));
+
+            for (uint32_t i = 0; i < columns; i++)
+                m_vertexInputs.push_back(VertexAttribute(locations[variable] + i, 0, format, 0));
+            continue;
+        }
+
+        if (storageClass != spv::UniformConstant && storageClass != spv::Uniform &&
+            storageClass != spv::StorageBuffer)
+            continue;
+        if (bindings[variable] == ~0U) continue;
+
+        // Arrays of resources become descriptor counts, runtime arrays get one descriptor.
+        uint32_t descriptorCount = 1;
+        while (opcodeOf(type) == spv::OpTypeArray || opcodeOf(type) == spv::OpTypeRuntimeArray) {
+            if (opcodeOf(type) == spv::OpTypeArray) descriptorCount *= constantValue(get(type)[3]);
+            type = get(type)[2];
+        }
+
+        DescriptorType descriptorType;
+        const uint32_t *t = get(type);
+        switch (t[0] & 0xFFFF) {
+        case spv::OpTypeSampler: descriptorType = DescriptorType::Sampler; break;
+        case spv::OpTypeSampledImage: descriptorType = DescriptorType::CombinedImageSampler; break;
+        case spv::OpTypeAccelerationStructureKHR: descriptorType = DescriptorType::AccelerationStructure; break;
+        case spv::OpTypeImage:
+            if (t[3] == spv::DimSubpassData) descriptorType = DescriptorType::InputAttachment;
+            else if (t[3] == spv::DimBuffer)
+                descriptorType = t[7] == 2 ? DescriptorType::StorageTexelBuffer : DescriptorType::UniformTexelBuffer;
+            else descriptorType = t[7] == 2 ? DescriptorType::StorageImage : DescriptorType::SampledImage;
+            break;
+        case spv::OpTypeStruct:
+            descriptorType = storageClass == spv::StorageBuffer || bufferBlocks[type] ? DescriptorType::StorageBuffer
+                                                                                      : DescriptorType::UniformBuffer;
+            break;
+        default: continue;
+        }
+
+        uint32_t set = sets[variable] == ~0U ? 0 : sets[variable];
+        if (m_descriptorSetLayouts.size() <= set) m_descriptorSetLayouts.resize(set + 1);
+        m_descriptorSetLayouts[set].push_back(
+            DescriptorSetLayoutBinding(bindings[variable], descriptorType, descriptorCount, stage)
+        );
+    }
+
+    for (auto &&set : m_descriptorSetLayouts)
+        std::sort(set.begin(), set.end(), [](const auto &a, const auto &b) { return a.binding < b.binding; });
+    std::sort(m_vertexInputs.begin(), m_vertexInputs.end(), [](const auto &a, const auto &b) {
+        return a.location < b.location;
+    });
+}
+} // namespace vg
@@ -0,0 +1,97 @@
+#pragma once
+#include <array>
+#include <vector>
+#include "Structs.h"
+#include "Flags.h"
+#include "Span.h"
+#include "PipelineLayout.h"
+
+namespace vg {
+/**
+ *@brief Resource interface of SPIR-V code
+ * Extracts descriptor bindings, push constants, specialization constants, workgroup size and vertex inputs of the first
+ * entry point. Reflections of all stages of a pipeline can be merged and turned into a minimal PipelineLayout.
+ */
+class ShaderReflection {
+  public:
+    struct SpecializationConstant {
+        uint32_t id;
+        uint32_t size;
+        uint64_t defaultValue;
+    };
+
+    static constexpr uint32_t noSpecializationId = ~0U;
+
+  public:
+    /**
+     *@brief Reflect SPIR-V code
+     *
+     * @param code SPIR-V words, throws std::runtime_error if they are not valid SPIR-V
+     */
+    ShaderReflection(Span<const uint32_t> code);
+
+    /**
+     *@brief Reflect SPIR-V file
+     *
+     * @param path Path to the SPIR-V file, throws std::runtime_error if it can't be read or is not valid SPIR-V
+     */
+    ShaderReflection(const char *path);
+
+    ShaderReflection();
+
+    /**
+     *@brief Merge reflection of another stage of the same pipeline
+     * Bindings used by both stages get both stage flags, push constant ranges are joined into one range.
+     */
+    ShaderReflection &Merge(const ShaderReflection &other);
+
+    Flags<ShaderStage> GetStages() const;
+
+    /**
+     *@brief Get bindings of every descriptor set, sorted by binding, sets without bindings are empty
+     */
+    const std::vector<std::vector<DescriptorSetLayoutBinding>> &GetDescriptorSetLayouts() const;
+    const std::vector<PushConstantRange> &GetPushConstantRanges() const;
+    const std::vector<SpecializationConstant> &GetSpecializationConstants() const;
+
+    /**
+     *@brief Get vertex shader inputs sorted by location, binding and offset are zero
+     */
+    const std::vector<VertexAttribute> &GetVertexInputs() const;
+
+    /**
+     *@brief Get local workgroup size of a compute shader
+     */
+    const std::array<uint32_t, 3> &GetWorkgroupSize() const;
+
+    /**
+     *@brief Get specialization constant ids of workgroup size components, noSpecializationId if not specialized
+     */
+    const std::array<uint32_t, 3> &GetWorkgroupSizeSpecializationIds() const;
+
+    /**
+     *@brief Create pipeline layout matching the reflected interface
+     * Layouts come from the device \ref LayoutCache, so shaders with the same interface share them.
+     */
+    PipelineLayout CreatePipelineLayout() const;
+
+    /**
+     *@brief Create vertex layout with all inputs tightly packed in one interleaved binding
+     *
+     * @param binding Index of the vertex binding
+     */
+    VertexLayout CreateVertexLayout(uint32_t binding = 0) const;
+
+  private:
+    void Reflect(const uint32_t *code, uint64_t wordCount);
+
+  private:
+    Flags<ShaderStage> m_stages;
+    std::vector<std::vector<DescriptorSetLayoutBinding>> m_descriptorSetLayouts;
+    std::vector<PushConstantRange> m_pushConstantRanges;
+    std::vector<SpecializationConstant> m_specializationConstants;
+    std::vector<VertexAttribute> m_vertexInputs;
+    std::array<uint32_t, 3> m_workgroupSize;
+    std::array<uint32_t, 3> m_workgroupSizeSpecializationIds;
+};
+} // namespace vg
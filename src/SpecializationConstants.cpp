@@ -0,0 +1,109 @@
+#include "SpecializationConstants.h"
+#include "ShaderReflection.h"
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+namespace vg {
+SpecializationConstants::SpecializationConstants() { UpdateInfo(); }
+
+SpecializationConstants::SpecializationConstants(SpecializationConstants &&other) noexcept
+    : SpecializationConstants() {
+    *this = std::move(other);
+}
+
+SpecializationConstants::SpecializationConstants(const SpecializationConstants &other)
+    : m_entries(other.m_entries), m_data(other.m_data) {
+    UpdateInfo();
+}
+
+SpecializationConstants &SpecializationConstants::operator=(SpecializationConstants &&other) noexcept {
+    if (&other == this) return *this;
+
+    std::swap(m_entries, other.m_entries);
+    std::swap(m_data, other.m_data);
+    UpdateInfo();
+    other.UpdateInfo();
+
+    return *this;
+}
+
+SpecializationConstants &SpecializationConstants::operator=(const SpecializationConstants &other) {
+    if (&other == this) return *this;
+
+    m_entries = other.m_entries;
+    m_data = other.m_data;
+    UpdateInfo();
+
+    return *this;
+}
+
+SpecializationConstants &SpecializationConstants::Set(uint32_t id, const void *value, uint32_t size) {
+    auto it = std::find_if(m_entries.begin(), m_entries.end(), [id](const auto &e) { return e.constantID == id; });
+    if (it != m_entries.end() && it->size == size) {
+        memcpy(m_data.data() + it->offset, value, size);
+        return *this;
+    }
+
+    // Entries are kept sorted with data packed in their order, so equal constants have equal entries and data no
+    // matter the order they were set in.
+    std::vector<SpecializationMapEntry> entries;
+    std::vector<char> data;
+    entries.reserve(m_entries.size() + 1);
+    auto append = [&](uint32_t constantID, const void *bytes, uint32_t byteCount) {
+        entries.push_back(SpecializationMapEntry(constantID, data.size(), byteCount));
+        data.insert(data.end(), (const char *)bytes, (const char *)bytes + byteCount);
+    };
+
+    bool added = false;
+    for (auto &&entry : m_entries) {
+        if (!added && id <= entry.constantID) {
+            append(id, value, size);
+            added = true;
+        }
+        if (entry.constantID != id) append(entry.constantID, m_data.data() + entry.offset, entry.size);
+    }
+    if (!added) append(id, value, size);
+
+    m_entries = std::move(entries);
+    m_data = std::move(data);
+    UpdateInfo();
+
+    return *this;
+}
+
+SpecializationConstants &
+SpecializationConstants::SetWorkgroupSize(const ShaderReflection &reflection, uint32_t x, uint32_t y, uint32_t z) {
+    const auto &ids = reflection.GetWorkgroupSizeSpecializationIds();
+    uint32_t size[3] = {x, y, z};
+    for (uint32_t i = 0; i < 3; i++) {
+        if (size[i] == 0) continue;
+        if (ids[i] == ShaderReflection::noSpecializationId)
+            throw std::runtime_error("Workgroup size component " + std::to_string(i) + " is not specializable");
+
+        Set(ids[i], size[i]);
+    }
+
+    return *this;
+}
+
+bool SpecializationConstants::IsEmpty() const { return m_entries.empty(); }
+
+std::string SpecializationConstants::GetKey() const {
+    std::string key;
+    for (auto &&entry : m_entries) {
+        key.append((const char *)&entry.constantID, sizeof(entry.constantID));
+        key.append(m_data.data() + entry.offset, entry.size);
+    }
+    return key;
+}
+
+const void *SpecializationConstants::GetInfo() const { return &m_info; }
+
+void SpecializationConstants::UpdateInfo() {
+    m_info.mapEntryCount = m_entries.size();
+    m_info.mapEntries = m_entries.data();
+    m_info.dataSize = m_data.size();
+    m_info.data = m_data.data();
+}
+} // namespace vg
@@ -0,0 +1,75 @@
+#pragma once
+#include <string>
+#include <type_traits>
+#include <vector>
+#include "Structs.h"
+
+namespace vg {
+class ShaderReflection;
+
+/**
+ *@brief Values of specialization constants of one shader stage
+ * Constants are baked into the pipeline at creation, so the driver can fold them, unroll loops and size shared memory.
+ */
+class SpecializationConstants {
+  public:
+    SpecializationConstants();
+    SpecializationConstants(SpecializationConstants &&other) noexcept;
+    SpecializationConstants(const SpecializationConstants &other);
+
+    SpecializationConstants &operator=(SpecializationConstants &&other) noexcept;
+    SpecializationConstants &operator=(const SpecializationConstants &other);
+
+    /**
+     *@brief Set value of a constant, setting the same id again overwrites it
+     *
+     * @param id Constant id, constant_id in GLSL
+     * @param value Value, bool is stored as 32 bit as Vulkan requires
+     */
+    template <typename T> SpecializationConstants &Set(uint32_t id, const T &value) {
+        static_assert(std::is_trivially_copyable_v<T>, "Specialization constant has to be trivially copyable");
+        if constexpr (std::is_same_v<T, bool>) return Set(id, (uint32_t)value);
+        else return Set(id, &value, sizeof(T));
+    }
+
+    SpecializationConstants &Set(uint32_t id, const void *value, uint32_t size);
+
+    /**
+     *@brief Specialize the local workgroup size of a compute shader
+     *
+     * @param reflection Reflection of the shader, throws std::runtime_error if a component other than 0 is requested
+     * for a dimension the shader doesn't declare specializable
+     * @param x Workgroup size in x, 0 leaves it unchanged
+     * @param y Workgroup size in y, 0 leaves it unchanged
+     * @param z Workgroup size in z, 0 leaves it unchanged
+     */
+    SpecializationConstants &
+    SetWorkgroupSize(const ShaderReflection &reflection, uint32_t x, uint32_t y = 0, uint32_t z = 0);
+
+    bool IsEmpty() const;
+
+    /**
+     *@brief Get bytes identifying these values, equal keys mean equal specialization
+     */
+    std::string GetKey() const;
+
+    /**
+     *@brief Get pointer to VkSpecializationInfo, valid until this object is modified or destroyed
+     */
+    const void *GetInfo() const;
+
+  private:
+    void UpdateInfo();
+
+  private:
+    std::vector<SpecializationMapEntry> m_entries;
+    std::vector<char> m_data;
+
+    struct {
+        uint32_t mapEntryCount;
+        const SpecializationMapEntry *mapEntries;
+        size_t dataSize;
+        const void *data;
+    } m_info;
+};
+} // namespace vg
@@ -1359,6 +1359,17 @@ struct SubmitInfo {
     VULKAN_NATIVE_CAST_OPERATOR(SubmitInfo);
 };
 
+struct SpecializationMapEntry {
+    uint32_t constantID;
+    uint32_t offset;
+    size_t size;
+
+    SpecializationMapEntry(uint32_t constantID = 0, uint32_t offset = 0, size_t size = 0)
+        : constantID(constantID), offset(offset), size(size) {}
+
+    VULKAN_NATIVE_CAST_OPERATOR(SpecializationMapEntry);
+};
+
 struct PushConstantRange {
     Flags<ShaderStage> stageFlags;
     uint32_t offset;
@@ -1369,4 +1380,85 @@ struct PushConstantRange {
 
     VULKAN_NATIVE_CAST_OPERATOR(PushConstantRange);
 };
+
+struct DescriptorBufferInfo {
+    BufferHandle buffer;
+    uint64_t offset;
+    uint64_t range;
+
+    DescriptorBufferInfo(BufferHandle buffer = {}, uint64_t offset = 0, uint64_t range = ~0ULL)
+        : buffer(buffer), offset(offset), range(range) {}
+
+    VULKAN_NATIVE_CAST_OPERATOR(DescriptorBufferInfo);
+};
+
+struct DescriptorImageInfo {
+    SamplerHandle sampler;
+    ImageViewHandle imageView;
+    ImageLayout imageLayout;
+
+    DescriptorImageInfo(
+        SamplerHandle sampler = {}, ImageViewHandle imageView = {}, ImageLayout imageLayout = ImageLayout::Undefined
+    )
+        : sampler(sampler), imageView(imageView), imageLayout(imageLayout) {}
+
+    VULKAN_NATIVE_CAST_OPERATOR(DescriptorImageInfo);
+};
+
+struct DescriptorUpdateTemplateEntry {
+    uint32_t dstBinding;
+    uint32_t dstArrayElement;
+    uint32_t descriptorCount;
+    DescriptorType descriptorType;
+    size_t offset;
+    size_t stride;
+
+    DescriptorUpdateTemplateEntry(
+        uint32_t dstBinding = 0, DescriptorType descriptorType = DescriptorType::UniformBuffer, size_t offset = 0,
+        uint32_t descriptorCount = 1, size_t stride = 0, uint32_t dstArrayElement = 0
+    )
+        : dstBinding(dstBinding), dstArrayElement(dstArrayElement), descriptorCount(descriptorCount),
+          descriptorType(descriptorType), offset(offset), stride(stride) {}
+
+    VULKAN_NATIVE_CAST_OPERATOR(DescriptorUpdateTemplateEntry);
+};
+
+struct DrawIndexedIndirectCommand {
+    uint32_t indexCount;
+    uint32_t instanceCount;
+    uint32_t firstIndex;
+    int32_t vertexOffset;
+    uint32_t firstInstance;
+
+    DrawIndexedIndirectCommand(
+        uint32_t indexCount = 0, uint32_t instanceCount = 1, uint32_t firstIndex = 0, int32_t vertexOffset = 0,
+        uint32_t firstInstance = 0
+    )
+        : indexCount(indexCount), instanceCount(instanceCount), firstIndex(firstIndex), vertexOffset(vertexOffset),
+          firstInstance(firstInstance) {}
+
+    VULKAN_NATIVE_CAST_OPERATOR(DrawIndexedIndirectCommand);
+};
+
+struct DrawMeshTasksIndirectCommand {
+    uint32_t groupCountX;
+    uint32_t groupCountY;
+    uint32_t groupCountZ;
+
+    DrawMeshTasksIndirectCommand(uint32_t groupCountX = 0, uint32_t groupCountY = 1, uint32_t groupCountZ = 1)
+        : groupCountX(groupCountX), groupCountY(groupCountY), groupCountZ(groupCountZ) {}
+
+    VULKAN_NATIVE_CAST_OPERATOR(DrawMeshTasksIndirectCommandEXT);
+};
+
+struct MultiDrawIndexedInfo {
+    uint32_t firstIndex;
+    uint32_t indexCount;
+    int32_t vertexOffset;
+
+    MultiDrawIndexedInfo(uint32_t indexCount = 0, uint32_t firstIndex = 0, int32_t vertexOffset = 0)
+        : firstIndex(firstIndex), indexCount(indexCount), vertexOffset(vertexOffset) {}
+
+    VULKAN_NATIVE_CAST_OPERATOR(MultiDrawIndexedInfoEXT);
+};
 } // namespace vg
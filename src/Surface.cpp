@@ -1,6 +1,7 @@
 #include <vulkan/vulkan.hpp>
 #include "Surface.h"
 #include "Instance.h"
+#include <stdexcept>
 
 namespace vg {
 Surface::Surface() : m_handle(nullptr) {}
@@ -46,4 +47,18 @@ Surface::operator SurfaceHandle &() { return m_handle; }
 Format Surface::GetFormat() const { return m_format; }
 
 ColorSpace Surface::GetColorSpace() const { return m_colorSpace; }
+
+SurfaceHandle Surface::CreateHeadless() {
+    VkInstance instanceHandle = static_cast<VkInstance>((InstanceHandle)*vg::instance);
+    auto createHeadlessSurface =
+        (PFN_vkCreateHeadlessSurfaceEXT)vkGetInstanceProcAddr(instanceHandle, "vkCreateHeadlessSurfaceEXT");
+    if (!createHeadlessSurface) throw std::runtime_error("VK_EXT_headless_surface is not enabled");
+
+    VkHeadlessSurfaceCreateInfoEXT createInfo = {VK_STRUCTURE_TYPE_HEADLESS_SURFACE_CREATE_INFO_EXT};
+    VkSurfaceKHR surface;
+    if (createHeadlessSurface(instanceHandle, &createInfo, nullptr, &surface) != VK_SUCCESS)
+        throw std::runtime_error("Failed to create headless surface");
+
+    return vk::SurfaceKHR(surface);
+}
 } // namespace vg
@@ -47,6 +47,15 @@ namespace vg
          */
         ColorSpace GetColorSpace() const;
 
+        /**
+         *@brief Create a surface without a window, for rendering benchmarks and tests without a display
+         * Instance has to be created with VK_KHR_surface and VK_EXT_headless_surface extensions. Presented images
+         * aren't displayed anywhere, the surface doesn't dictate its size.
+         *
+         * @return Surface handle to create the Device and Surface with
+         */
+        static SurfaceHandle CreateHeadless();
+
     private:
         SurfaceHandle m_handle;
         Format m_format;
@@ -36,13 +36,16 @@ Swapchain::Swapchain(
         m_width = std::clamp(width, min.width, max.width);
         m_height = std::clamp(height, min.height, max.height);
     }
+
+    // Fifo is the only mode every device supports.
+    if (!supportDetails.presentModes.contains((vk::PresentModeKHR)presentMode)) { presentMode = PresentMode::Fifo; }
+    m_presentMode = presentMode;
+
     if (m_width == 0 || m_height == 0) {
         m_handle = nullptr;
         return;
     }
 
-    if (!supportDetails.presentModes.contains((vk::PresentModeKHR)presentMode)) { presentMode = PresentMode::Fifo; }
-
     // Create Swapchain and get its Images and ImageViews.
     vk::SwapchainCreateInfoKHR createInfo(
         {}, surface, imageCount, (vk::Format)surface.GetFormat(), (vk::ColorSpaceKHR)surface.GetColorSpace(),
@@ -66,7 +69,7 @@ Swapchain::Swapchain(
     }
 }
 
-Swapchain::Swapchain() : m_handle(nullptr) {}
+Swapchain::Swapchain() : m_handle(nullptr), m_width(0), m_height(0), m_presentMode(PresentMode::Fifo) {}
 
 Swapchain::Swapchain(Swapchain &&other) noexcept : Swapchain() { *this = std::move(other); }
 
@@ -90,6 +93,7 @@ Swapchain &Swapchain::operator=(Swapchain &&other) noexcept {
     std::swap(m_imageViews, other.m_imageViews);
     std::swap(m_width, other.m_width);
     std::swap(m_height, other.m_height);
+    std::swap(m_presentMode, other.m_presentMode);
 
     return *this;
 }
@@ -103,6 +107,10 @@ unsigned int Swapchain::GetHeight() const { return m_height; }
 
 Span<const ImageViewHandle> Swapchain::GetImageViews() const { return m_imageViews; }
 
+Span<const ImageHandle> Swapchain::GetImages() const { return m_images; }
+
+PresentMode Swapchain::GetPresentMode() const { return m_presentMode; }
+
 std::tuple<uint32_t, Result> Swapchain::GetNextImageIndex(
     const Semaphore &semaphore, const Fence &fence, uint64_t timeout
 ) {
@@ -72,6 +72,18 @@ namespace vg
          * @return const std::vector<ImageViewHandle>&
          */
         Span<const ImageViewHandle> GetImageViews() const;
+        /**
+         * @brief Get the Images object
+         *
+         * @return Span<const ImageHandle>
+         */
+        Span<const ImageHandle> GetImages() const;
+        /**
+         *@brief Get the Present Mode used, Fifo if the requested one isn't supported
+         *
+         * @return PresentMode
+         */
+        PresentMode GetPresentMode() const;
         /**
          *@brief Get the Next Image Index object
          *
@@ -89,5 +101,6 @@ namespace vg
         std::vector<ImageViewHandle> m_imageViews;
 
         unsigned int m_width, m_height;
+        PresentMode m_presentMode;
     };
 }
\ No newline at end of file
@@ -1,29 +1,55 @@
 #pragma once
+#include "BindlessTable.h"
 #include "Buffer.h"
 #include "CmdBuffer.h"
 #include "CmdPool.h"
 #include "ComputePipeline.h"
+#include "ComputePipelineVariants.h"
+#include "DescriptorAllocator.h"
+#include "DescriptorBuffer.h"
 #include "DescriptorPool.h"
 #include "DescriptorSet.h"
+#include "DescriptorUpdateTemplate.h"
+#include "DescriptorWriter.h"
 #include "Device.h"
 #include "Enums.h"
 #include "Flags.h"
 #include "FormatInfo.h"
+#include "FrameDump.h"
 #include "Framebuffer.h"
+#include "DrawBatcher.h"
+#include "GpuCulling.h"
 #include "GraphicsPipeline.h"
 #include "Handle.h"
 #include "Image.h"
 #include "ImageView.h"
 #include "Instance.h"
+#include "InstanceBuffer.h"
+#include "LayoutCache.h"
+#include "MappedFile.h"
 #include "MemoryManager.h"
+#include "MeshletBuilder.h"
+#include "MeshOptimizer.h"
+#include "MeshPool.h"
+#include "PersistentPipelineCache.h"
 #include "PipelineCache.h"
+#include "PipelineCompiler.h"
 #include "PipelineLayout.h"
+#include "PipelineLibrary.h"
+#include "PipelineRegistry.h"
+#include "Presenter.h"
 #include "Queue.h"
+#include "Readback.h"
 #include "RenderPass.h"
 #include "Sampler.h"
+#include "SamplerCache.h"
 #include "Shader.h"
+#include "ShaderLibrary.h"
+#include "ShaderReflection.h"
+#include "SpecializationConstants.h"
 #include "Structs.h"
 #include "Subpass.h"
 #include "Surface.h"
 #include "Swapchain.h"
 #include "Synchronization.h"
+#include "VertexEncoder.h"
@@ -0,0 +1,277 @@
+#include "VertexEncoder.h"
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <cmath>
+#include <cstring>
+#if defined(__SSE2__) || defined(_M_X64)
+#define VG_VERTEX_ENCODER_SSE2
+#include <emmintrin.h>
+#endif
+#if defined(__F16C__)
+#include <immintrin.h>
+#endif
+
+namespace vg {
+namespace {
+template <typename T> T *Advance(T *pointer, uint64_t bytes) { return (T *)((char *)pointer + bytes); }
+
+// Round to nearest even like the SIMD conversions do with the default rounding mode.
+int32_t Round(float value) { return (int32_t)std::nearbyint(value); }
+
+uint16_t FloatToHalf(float value) {
+    const uint32_t infinity = 255U << 23;
+    const uint32_t halfOverflow = (127U + 16) << 23;
+    const uint32_t halfNormalMin = 113U << 23;
+    const uint32_t denormalMagic = ((127U - 15) + (23 - 10) + 1) << 23;
+
+    uint32_t bits = std::bit_cast<uint32_t>(value);
+    uint32_t sign = bits & 0x80000000U;
+    bits ^= sign;
+
+    uint16_t half;
+    if (bits >= halfOverflow) {
+        half = bits > infinity ? 0x7E00 : 0x7C00;
+    } else if (bits < halfNormalMin) {
+        // Adding the magic number lets the FPU do the denormal rounding.
+        float denormal = std::bit_cast<float>(bits) + std::bit_cast<float>(denormalMagic);
+        half = std::bit_cast<uint32_t>(denormal) - denormalMagic;
+    } else {
+        uint32_t mantissaOdd = (bits >> 13) & 1;
+        bits += ((uint32_t)(15 - 127) << 23) + 0xFFF;
+        bits += mantissaOdd;
+        half = bits >> 13;
+    }
+    return half | (sign >> 16);
+}
+
+void EncodeOctahedral(float x, float y, float z, int16_t *out) {
+    float l1 = std::max(std::abs(x) + std::abs(y) + std::abs(z), 1e-20f);
+    x /= l1;
+    y /= l1;
+    if (z < 0) {
+        float foldedX = (1 - std::abs(y)) * std::copysign(1.0f, x);
+        float foldedY = (1 - std::abs(x)) * std::copysign(1.0f, y);
+        x = foldedX;
+        y = foldedY;
+    }
+    out[0] = Round(std::clamp(x, -1.0f, 1.0f) * 32767.0f);
+    out[1] = Round(std::clamp(y, -1.0f, 1.0f) * 32767.0f);
+}
+} // namespace
+
+PositionBounds PositionBounds::Compute(Span<const float> positions) {
+    assert(positions.size() % 3 == 0);
+
+    PositionBounds bounds;
+    if (positions.empty()) return bounds;
+
+    float min[3] = {positions[0], positions[1], positions[2]};
+    float max[3] = {positions[0], positions[1], positions[2]};
+    for (size_t i = 3; i < positions.size(); i += 3)
+        for (int j = 0; j < 3; j++) {
+            min[j] = std::min(min[j], positions[i + j]);
+            max[j] = std::max(max[j], positions[i + j]);
+        }
+
+    for (int j = 0; j < 3; j++) {
+        bounds.offset[j] = min[j];
+        bounds.scale[j] = max[j] > min[j] ? max[j] - min[j] : 1.0f;
+    }
+    return bounds;
+}
+
+VertexEncoder::VertexEncoder(NormalEncoding normals, bool uvs) : m_normals(normals), m_uvs(uvs) {}
+
+std::vector<char> VertexEncoder::Encode(
+    const PositionBounds &bounds, Span<const float> positions, Span<const float> normals, Span<const float> uvs
+) const {
+    assert(positions.size() % 3 == 0);
+    size_t vertexCount = positions.size() / 3;
+    assert(m_normals == NormalEncoding::None || normals.size() == vertexCount * 3);
+    assert(!m_uvs || uvs.size() == vertexCount * 2);
+
+    uint32_t stride = GetStride();
+    std::vector<char> vertices(vertexCount * stride);
+    char *out = vertices.data();
+
+    EncodePositions(bounds, positions, (uint16_t *)out, stride);
+    uint32_t offset = 8;
+    if (m_normals == NormalEncoding::Octahedral) EncodeOctahedral(normals, (int16_t *)(out + offset), stride);
+    if (m_normals == NormalEncoding::Packed10) EncodePacked10(normals, (uint32_t *)(out + offset), stride);
+    if (m_normals != NormalEncoding::None) offset += 4;
+    if (m_uvs) EncodeHalf(uvs, (uint16_t *)(out + offset), 2, stride);
+
+    return vertices;
+}
+
+uint32_t VertexEncoder::GetStride() const { return 8 + (m_normals != NormalEncoding::None ? 4 : 0) + (m_uvs ? 4 : 0); }
+
+VertexBinding VertexEncoder::GetBinding(uint32_t binding) const { return VertexBinding(binding, GetStride()); }
+
+std::vector<VertexAttribute> VertexEncoder::GetAttributes(uint32_t binding, uint32_t firstLocation) const {
+    std::vector<VertexAttribute> attributes = {VertexAttribute(firstLocation, binding, positionFormat, 0)};
+    uint32_t offset = 8;
+    if (m_normals != NormalEncoding::None) {
+        attributes.push_back(
+            VertexAttribute(attributes.size() + firstLocation, binding, GetNormalFormat(m_normals), offset)
+        );
+        offset += 4;
+    }
+    if (m_uvs) attributes.push_back(VertexAttribute(attributes.size() + firstLocation, binding, uvFormat, offset));
+    return attributes;
+}
+
+Format VertexEncoder::GetNormalFormat(NormalEncoding encoding) {
+    switch (encoding) {
+    case NormalEncoding::Octahedral: return Format::RG16SNORM;
+    case NormalEncoding::Packed10: return Format::A2BGR10SNORMPACK;
+    default: return Format::Undefined;
+    }
+}
+
+void VertexEncoder::EncodePositions(
+    const PositionBounds &bounds, Span<const float> positions, uint16_t *out, uint32_t stride
+) {
+    assert(positions.size() % 3 == 0);
+    size_t vertexCount = positions.size() / 3;
+    float inverseScale[3] = {1 / bounds.scale[0], 1 / bounds.scale[1], 1 / bounds.scale[2]};
+
+    size_t i = 0;
+#ifdef VG_VERTEX_ENCODER_SSE2
+    const __m128 offset = _mm_setr_ps(bounds.offset[0], bounds.offset[1], bounds.offset[2], 0);
+    const __m128 scale = _mm_setr_ps(inverseScale[0], inverseScale[1], inverseScale[2], 0);
+    const __m128 xyzMask = _mm_castsi128_ps(_mm_setr_epi32(-1, -1, -1, 0));
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 unormMax = _mm_set1_ps(65535.0f);
+    const __m128i bias = _mm_set1_epi32(32768);
+    const __m128i unbias = _mm_set1_epi16((short)0x8000);
+
+    // Loading 4 floats reads x of the next vertex, so the last vertex goes through the scalar path.
+    for (; i + 1 < vertexCount; i++) {
+        __m128 position = _mm_and_ps(_mm_loadu_ps(&positions[i * 3]), xyzMask);
+        __m128 unorm = _mm_min_ps(_mm_max_ps(_mm_mul_ps(_mm_sub_ps(position, offset), scale), zero), one);
+        __m128i quantized = _mm_sub_epi32(_mm_cvtps_epi32(_mm_mul_ps(unorm, unormMax)), bias);
+        __m128i packed = _mm_xor_si128(_mm_packs_epi32(quantized, quantized), unbias);
+        _mm_storel_epi64((__m128i *)Advance(out, i * stride), packed);
+    }
+#endif
+    for (; i < vertexCount; i++) {
+        uint16_t *vertex = Advance(out, i * stride);
+        for (int j = 0; j < 3; j++) {
+            float unorm = std::clamp((positions[i * 3 + j] - bounds.offset[j]) * inverseScale[j], 0.0f, 1.0f);
+            vertex[j] = Round(unorm * 65535.0f);
+        }
+        vertex[3] = 0;
+    }
+}
+
+void VertexEncoder::EncodeOctahedral(Span<const float> normals, int16_t *out, uint32_t stride) {
+    assert(normals.size() % 3 == 0);
+    size_t vertexCount = normals.size() / 3;
+
+    size_t i = 0;
+#ifdef VG_VERTEX_ENCODER_SSE2
+    const __m128 signMask = _mm_set1_ps(-0.0f);
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 minusOne = _mm_set1_ps(-1.0f);
+    const __m128 minLength = _mm_set1_ps(1e-20f);
+    const __m128 snormMax = _mm_set1_ps(32767.0f);
+
+    // Four normals at a time in structure of arrays form.
+    for (; i + 4 <= vertexCount; i += 4) {
+        const float *n = &normals[i * 3];
+        __m128 x = _mm_setr_ps(n[0], n[3], n[6], n[9]);
+        __m128 y = _mm_setr_ps(n[1], n[4], n[7], n[10]);
+        __m128 z = _mm_setr_ps(n[2], n[5], n[8], n[11]);
+
+        __m128 l1 = _mm_add_ps(_mm_add_ps(_mm_andnot_ps(signMask, x), _mm_andnot_ps(signMask, y)),
+                               _mm_andnot_ps(signMask, z));
+        l1 = _mm_max_ps(l1, minLength);
+        x = _mm_div_ps(x, l1);
+        y = _mm_div_ps(y, l1);
+
+        __m128 foldedX = _mm_mul_ps(
+            _mm_sub_ps(one, _mm_andnot_ps(signMask, y)), _mm_or_ps(_mm_and_ps(x, signMask), one)
+        );
+        __m128 foldedY = _mm_mul_ps(
+            _mm_sub_ps(one, _mm_andnot_ps(signMask, x)), _mm_or_ps(_mm_and_ps(y, signMask), one)
+        );
+        __m128 lowerHemisphere = _mm_cmplt_ps(z, _mm_setzero_ps());
+        x = _mm_or_ps(_mm_and_ps(lowerHemisphere, foldedX), _mm_andnot_ps(lowerHemisphere, x));
+        y = _mm_or_ps(_mm_and_ps(lowerHemisphere, foldedY), _mm_andnot_ps(lowerHemisphere, y));
+
+        __m128i qx = _mm_cvtps_epi32(_mm_mul_ps(_mm_min_ps(_mm_max_ps(x, minusOne), one), snormMax));
+        __m128i qy = _mm_cvtps_epi32(_mm_mul_ps(_mm_min_ps(_mm_max_ps(y, minusOne), one), snormMax));
+        __m128i interleaved = _mm_unpacklo_epi16(_mm_packs_epi32(qx, qx), _mm_packs_epi32(qy, qy));
+
+        alignas(16) int16_t encoded[8];
+        _mm_store_si128((__m128i *)encoded, interleaved);
+        for (int j = 0; j < 4; j++) std::memcpy(Advance(out, (i + j) * stride), &encoded[j * 2], 4);
+    }
+#endif
+    for (; i < vertexCount; i++)
+        vg::EncodeOctahedral(normals[i * 3], normals[i * 3 + 1], normals[i * 3 + 2], Advance(out, i * stride));
+}
+
+void VertexEncoder::EncodePacked10(Span<const float> normals, uint32_t *out, uint32_t stride) {
+    assert(normals.size() % 3 == 0);
+    size_t vertexCount = normals.size() / 3;
+
+    size_t i = 0;
+#ifdef VG_VERTEX_ENCODER_SSE2
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 minusOne = _mm_set1_ps(-1.0f);
+    const __m128 snormMax = _mm_set1_ps(511.0f);
+    const __m128i mask = _mm_set1_epi32(0x3FF);
+
+    for (; i + 1 < vertexCount; i++) {
+        __m128 normal = _mm_min_ps(_mm_max_ps(_mm_loadu_ps(&normals[i * 3]), minusOne), one);
+        __m128i quantized = _mm_and_si128(_mm_cvtps_epi32(_mm_mul_ps(normal, snormMax)), mask);
+
+        alignas(16) uint32_t components[4];
+        _mm_store_si128((__m128i *)components, quantized);
+        *Advance(out, i * stride) = components[0] | components[1] << 10 | components[2] << 20;
+    }
+#endif
+    for (; i < vertexCount; i++) {
+        uint32_t packed = 0;
+        for (int j = 0; j < 3; j++)
+            packed |= (Round(std::clamp(normals[i * 3 + j], -1.0f, 1.0f) * 511.0f) & 0x3FF) << (j * 10);
+        *Advance(out, i * stride) = packed;
+    }
+}
+
+void VertexEncoder::EncodeHalf(Span<const float> values, uint16_t *out, uint32_t componentCount, uint32_t stride) {
+    assert(componentCount > 0 && values.size() % componentCount == 0);
+    size_t groupCount = values.size() / componentCount;
+
+    size_t i = 0;
+#if defined(__F16C__)
+    // Contiguous output is converted 8 floats at a time, strided output one group of up to 4 components at a time.
+    if (stride == componentCount * 2) {
+        for (; i + 8 <= values.size(); i += 8)
+            _mm_storeu_si128(
+                (__m128i *)(out + i), _mm256_cvtps_ph(_mm256_loadu_ps(&values[i]), _MM_FROUND_TO_NEAREST_INT)
+            );
+        for (; i < values.size(); i++) out[i] = FloatToHalf(values[i]);
+        return;
+    }
+    if (componentCount <= 4) {
+        for (; i < groupCount; i++) {
+            alignas(16) float group[4] = {};
+            std::memcpy(group, &values[i * componentCount], componentCount * sizeof(float));
+            alignas(16) uint16_t halves[8];
+            _mm_store_si128((__m128i *)halves, _mm_cvtps_ph(_mm_load_ps(group), _MM_FROUND_TO_NEAREST_INT));
+            std::memcpy(Advance(out, i * stride), halves, componentCount * sizeof(uint16_t));
+        }
+        return;
+    }
+#endif
+    for (; i < groupCount; i++) {
+        uint16_t *group = Advance(out, i * stride);
+        for (uint32_t j = 0; j < componentCount; j++) group[j] = FloatToHalf(values[i * componentCount + j]);
+    }
+}
+} // namespace vg
@@ -0,0 +1,111 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "Enums.h"
+#include "Structs.h"
+#include "Span.h"
+
+namespace vg {
+/**
+ *@brief Box positions are quantized into, a position is reconstructed as offset + scale * unorm
+ */
+struct PositionBounds {
+    float offset[3];
+    float scale[3];
+
+    PositionBounds() : offset{0, 0, 0}, scale{1, 1, 1} {}
+
+    /**
+     *@brief Compute bounds tightly enclosing the positions
+     *
+     * @param positions xyz triplets
+     */
+    static PositionBounds Compute(Span<const float> positions);
+};
+
+/**
+ *@brief Encodes float vertex data into quantized interleaved vertices
+ * Positions become RGBA16UNORM relative to \ref PositionBounds, normals become octahedral RG16SNORM or A2BGR10SNORMPACK
+ * and texture coordinates become RG16SFLOAT, so a position, normal and uv vertex shrinks from 32 to 16 bytes. Positions
+ * have to be rescaled with the bounds in the vertex shader and octahedral normals decoded there. Encoders use SSE2 and
+ * F16C when the compiler targets them and fall back to scalar code otherwise, results are the same.
+ */
+class VertexEncoder {
+  public:
+    enum class NormalEncoding {
+        None,
+        /**
+         *@brief Octahedral mapping to two 16 bit snorm components, 4 bytes
+         */
+        Octahedral,
+        /**
+         *@brief xyz as 10 bit snorm components, 4 bytes, decoded by the vertex fetch without shader work
+         */
+        Packed10
+    };
+
+  public:
+    /**
+     *@brief Construct a new Vertex Encoder object
+     *
+     * @param normals How normals are encoded, None if vertices have no normals
+     * @param uvs Whether vertices have texture coordinates
+     */
+    VertexEncoder(NormalEncoding normals = NormalEncoding::Octahedral, bool uvs = true);
+
+    /**
+     *@brief Encode interleaved vertices
+     *
+     * @param bounds Bounds positions are quantized into, usually \ref PositionBounds::Compute() of positions
+     * @param positions xyz triplets
+     * @param normals xyz triplets of unit normals, one per position, ignored with NormalEncoding::None
+     * @param uvs uv pairs, one per position, ignored if the encoder has no uvs
+     * @return GetStride() bytes per vertex
+     */
+    std::vector<char> Encode(
+        const PositionBounds &bounds, Span<const float> positions, Span<const float> normals = {},
+        Span<const float> uvs = {}
+    ) const;
+
+    uint32_t GetStride() const;
+    VertexBinding GetBinding(uint32_t binding = 0) const;
+    /**
+     *@brief Attributes matching the encoded vertices, in order position, normal, uv on consecutive locations
+     */
+    std::vector<VertexAttribute> GetAttributes(uint32_t binding = 0, uint32_t firstLocation = 0) const;
+
+    static constexpr Format positionFormat = Format::RGBA16UNORM;
+    static constexpr Format uvFormat = Format::RG16SFLOAT;
+    static Format GetNormalFormat(NormalEncoding encoding);
+
+  public:
+    /**
+     *@brief Quantize positions to four 16 bit unorm components, w is 0
+     * Strides of the encoders are distances in bytes between consecutive vertices in out.
+     */
+    static void EncodePositions(
+        const PositionBounds &bounds, Span<const float> positions, uint16_t *out, uint32_t stride = 8
+    );
+    /**
+     *@brief Encode unit normals to two 16 bit snorm components
+     */
+    static void EncodeOctahedral(Span<const float> normals, int16_t *out, uint32_t stride = 4);
+    /**
+     *@brief Encode unit normals to 10 bit snorm components packed as A2BGR10
+     */
+    static void EncodePacked10(Span<const float> normals, uint32_t *out, uint32_t stride = 4);
+    /**
+     *@brief Convert floats to half floats, rounding to nearest even
+     *
+     * @param values Groups of componentCount floats
+     * @param out Destination of the first group
+     * @param componentCount Count of floats written contiguously per group
+     * @param stride Distance in bytes between groups in out
+     */
+    static void EncodeHalf(Span<const float> values, uint16_t *out, uint32_t componentCount = 1, uint32_t stride = 2);
+
+  private:
+    NormalEncoding m_normals;
+    bool m_uvs;
+};
+} // namespace vg
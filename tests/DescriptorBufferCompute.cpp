@@ -0,0 +1,96 @@
+#include <iostream>
+#include <vector>
+#include "Instance.h"
+#include "Device.h"
+#include "Shader.h"
+#include "Buffer.h"
+#include "MemoryManager.h"
+#include "CmdBuffer.h"
+#include "ComputePipeline.h"
+#include "ComputePipelineVariants.h"
+#include "DescriptorBuffer.h"
+#include "PipelineCompiler.h"
+#include "Readback.h"
+
+using namespace vg;
+
+// Runs the same compute shader through every compute pipeline create path with a descriptor buffer layout. Pipelines
+// missing the descriptor buffer create flag are rejected by the validation layer, or produce wrong results.
+int main() {
+    Instance instance(
+        {},
+        [](MessageSeverity severity, const char *message) {
+            if (severity < MessageSeverity::Warning) return;
+            std::cout << message << '\n' << '\n';
+        },
+        true
+    );
+    vg::instance = &instance;
+
+    Queue computeQueue({QueueType::Compute}, 1.0f);
+    Device computeDevice({&computeQueue}, {"VK_EXT_descriptor_buffer", "VK_KHR_buffer_device_address"});
+    vg::currentDevice = &computeDevice;
+
+    const int n = 2, k = 3, variationCount = 8;
+    Buffer variations(
+        variationCount * k * sizeof(int),
+        {BufferUsage::StorageBuffer, BufferUsage::TransferSrc, BufferUsage::ShaderDeviceAddress}
+    );
+    Allocate(&variations, {MemoryProperty::DeviceLocal});
+    Readback readback(computeQueue, variations.GetSize());
+
+    Shader shader(ShaderStage::Compute, "resources/shaders/wariacje.comp.spv");
+    auto createLayout = []() {
+        return PipelineLayout(
+            {{DescriptorSetLayoutBinding(0, DescriptorType::StorageBuffer, 1, ShaderStage::Compute)}},
+            {PushConstantRange(ShaderStage::Compute, 0, 3 * sizeof(int))}, {DescriptorSetLayoutCreate::DescriptorBuffer}
+        );
+    };
+
+    ComputePipeline pipeline(shader, createLayout());
+    ComputePipelineVariants variants(shader, createLayout());
+    PipelineCompiler compiler(1);
+    const PipelineLayout &layout = pipeline.GetPipelineLayout();
+    std::vector<std::pair<const char *, ComputePipelineHandle>> pipelines = {
+        {"ComputePipeline", pipeline},
+        {"ComputePipelineVariants", variants.Get(SpecializationConstants())},
+        {"PipelineCompiler", compiler.Compile(shader, layout).get()},
+    };
+
+    DescriptorBuffer descriptorBuffer(1024, 1);
+    DescriptorBuffer::Set set = descriptorBuffer.Allocate(layout.GetDescriptorSets()[0]);
+    descriptorBuffer.WriteBuffer(set, 0, DescriptorType::StorageBuffer, variations);
+
+    int failures = 0;
+    for (auto &&[name, handle] : pipelines) {
+        CmdBuffer cmdBuffer(computeQueue);
+        cmdBuffer.Begin({})
+            .Append(
+                cmd::FillBuffer(variations, 0, variations.GetSize(), 0),
+                cmd::PipelineBarier(
+                    PipelineStage::Transfer, PipelineStage::ComputeShader,
+                    std::vector<MemoryBarrier>{MemoryBarrier(Access::TransferWrite, Access::ShaderWrite)}
+                ),
+                cmd::BindPipeline(handle), descriptorBuffer.Bind(),
+                descriptorBuffer.SetOffsets(layout, PipelineBindPoint::Compute, 0, {set}),
+                cmd::PushConstants(layout, ShaderStage::Compute, 0, std::make_tuple(variationCount, n, k)),
+                cmd::Dispatch(1, 1, 1)
+            )
+            .End()
+            .Submit()
+            .Await();
+
+        auto result = readback.Read<int>(variations, variationCount * k);
+        readback.Flush();
+        std::vector<int> values = result.get();
+
+        // Variation i lists the base n digits of i, most significant first, each plus one.
+        bool correct = true;
+        for (int i = 0, divisor = 1; i < variationCount; i++, divisor = 1)
+            for (int j = k - 1; j >= 0; j--, divisor *= n) correct &= values[i * k + j] == (i / divisor) % n + 1;
+
+        std::cout << name << ": " << (correct ? "ok" : "wrong results") << '\n';
+        failures += !correct;
+    }
+    return failures;
+}
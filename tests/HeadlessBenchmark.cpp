@@ -0,0 +1,95 @@
+#include <chrono>
+#include <iostream>
+#include <string>
+#include "CmdBuffer.h"
+#include "Device.h"
+#include "FrameDump.h"
+#include "Instance.h"
+#include "Presenter.h"
+#include "Surface.h"
+
+using namespace vg;
+
+// Runs the full acquire, submit, present loop on a headless surface, so it works without a window, e.g. on lavapipe
+// in CI. Passing a path prefix dumps every 60th frame as a PPM image. Frames ahead are limited with present wait where
+// the device has it, otherwise with fences, the output says which one ran.
+int main(int argc, char **argv) {
+    Instance instance(
+        {"VK_KHR_surface", "VK_EXT_headless_surface"},
+        [](MessageSeverity severity, const char *message) {
+            if (severity < MessageSeverity::Warning) return;
+            std::cout << message << '\n' << '\n';
+        },
+        false
+    );
+    vg::instance = &instance;
+
+    SurfaceHandle headlessSurface = Surface::CreateHeadless();
+    Queue generalQueue({QueueType::General}, 1.0f);
+    Device device(
+        {&generalQueue}, {"VK_KHR_swapchain"}, {}, headlessSurface,
+        [](auto id, auto supportedQueues, auto supportedExtensions, auto type, DeviceLimits limits,
+           DeviceFeatures features) { return (type == DeviceType::Dedicated) ? 2 : 1; },
+        {"VK_KHR_present_id", "VK_KHR_present_wait"}
+    );
+    vg::currentDevice = &device;
+
+    Surface surface(headlessSurface, {Format::BGRA8UNORM, ColorSpace::SRGBNL});
+    Presenter presenter(
+        surface, generalQueue, 640, 480, 2, 3, PresentMode::Fifo,
+        {Usage::ColorAttachment, Usage::TransferDst, Usage::TransferSrc}
+    );
+    presenter.SetMaxFramesAhead(1);
+    PerFrame<CmdBuffer> commandBuffer(presenter, generalQueue);
+    FrameDump frameDump;
+    if (argc > 1) frameDump = FrameDump(presenter, argv[1], 60);
+
+    const int frameCount = 600;
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int frame = 0; frame < frameCount; frame++) {
+        if (!presenter.Acquire()) continue;
+        ImageHandle image = presenter.GetSwapchain().GetImages()[presenter.GetImageIndex()];
+
+        float t = (float)(frame % 120) / 120.0f;
+        commandBuffer->Clear().Begin();
+        commandBuffer->Append(
+            cmd::PipelineBarier(
+                PipelineStage::Transfer, PipelineStage::Transfer,
+                std::vector<ImageMemoryBarrier>{ImageMemoryBarrier(
+                    image, ImageLayout::Undefined, ImageLayout::TransferDstOptimal, {}, Access::TransferWrite,
+                    ImageAspect::Color
+                )}
+            ),
+            cmd::ClearColorImage(
+                image, ImageLayout::TransferDstOptimal, ClearColor(t, 1.0f - t, 0.5f, 1.0f), {ImageAspect::Color}
+            ),
+            cmd::PipelineBarier(
+                PipelineStage::Transfer, PipelineStage::BottomOfPipe,
+                std::vector<ImageMemoryBarrier>{ImageMemoryBarrier(
+                    image, ImageLayout::TransferDstOptimal, ImageLayout::PresentSrc, Access::TransferWrite, {},
+                    ImageAspect::Color
+                )}
+            )
+        );
+        if (argc > 1) frameDump.Record(*commandBuffer);
+        commandBuffer->End();
+
+        presenter.Submit(*commandBuffer, PipelineStage::Transfer);
+        presenter.Present();
+    }
+    presenter.WaitIdle();
+    auto end = std::chrono::high_resolution_clock::now();
+    frameDump.Flush();
+
+    auto time = std::chrono::duration_cast<std::chrono::microseconds>(end - start);
+    std::cout << "Presented " << frameCount << " frames in "
+              << std::chrono::duration_cast<std::chrono::milliseconds>(time) << ", "
+              << frameCount * 1e6 / time.count() << " fps\n";
+    Presenter::Stats stats = presenter.GetStats();
+    std::cout << "Present mode " << (int)presenter.GetSwapchain().GetPresentMode() << ", frames ahead limited by "
+              << (presenter.IsPresentWaitSupported() ? "present wait" : "fences") << '\n'
+              << "Last " << stats.frameCount << " frames: cpu " << stats.averageCpuTime << " ms (max "
+              << stats.maxCpuTime << "), wait " << stats.averageWaitTime << " ms, present interval "
+              << stats.averagePresentInterval << " ms (max " << stats.maxPresentInterval << ")\n";
+    if (argc > 1) std::cout << "Dumped " << frameDump.GetWrittenCount() << " frames\n";
+}
@@ -0,0 +1,114 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <numbers>
+#include <random>
+#include <string>
+#include <vector>
+#include "MeshletBuilder.h"
+#include "MeshOptimizer.h"
+
+using namespace vg;
+
+struct TestMesh {
+    std::string name;
+    std::vector<float> positions;
+    std::vector<uint32_t> indices;
+};
+
+TestMesh Grid(uint32_t size) {
+    TestMesh mesh{"grid " + std::to_string(size) + "x" + std::to_string(size), {}, {}};
+    for (uint32_t y = 0; y <= size; y++)
+        for (uint32_t x = 0; x <= size; x++) mesh.positions.insert(mesh.positions.end(), {(float)x, (float)y, 0.0f});
+    for (uint32_t y = 0; y < size; y++)
+        for (uint32_t x = 0; x < size; x++) {
+            uint32_t i = y * (size + 1) + x;
+            mesh.indices.insert(mesh.indices.end(), {i, i + 1, i + size + 1, i + 1, i + size + 2, i + size + 1});
+        }
+    return mesh;
+}
+
+TestMesh Sphere(uint32_t rings, uint32_t segments) {
+    TestMesh mesh{"sphere " + std::to_string(rings) + "x" + std::to_string(segments), {}, {}};
+    for (uint32_t r = 0; r <= rings; r++)
+        for (uint32_t s = 0; s <= segments; s++) {
+            float theta = std::numbers::pi_v<float> * r / rings;
+            float phi = 2 * std::numbers::pi_v<float> * s / segments;
+            mesh.positions.insert(
+                mesh.positions.end(),
+                {std::sin(theta) * std::cos(phi), std::cos(theta), std::sin(theta) * std::sin(phi)}
+            );
+        }
+    for (uint32_t r = 0; r < rings; r++)
+        for (uint32_t s = 0; s < segments; s++) {
+            uint32_t i = r * (segments + 1) + s;
+            uint32_t below = i + segments + 1;
+            mesh.indices.insert(mesh.indices.end(), {i, below, i + 1, i + 1, below, below + 1});
+        }
+    return mesh;
+}
+
+TestMesh Shuffled(TestMesh mesh) {
+    std::mt19937 random(42);
+    uint32_t triangleCount = mesh.indices.size() / 3;
+    for (uint32_t i = triangleCount - 1; i > 0; i--) {
+        uint32_t j = random() % (i + 1);
+        std::swap_ranges(&mesh.indices[i * 3], &mesh.indices[i * 3 + 3], &mesh.indices[j * 3]);
+    }
+    mesh.name += " shuffled";
+    return mesh;
+}
+
+// No meshes are bundled with the repository, so typical topologies are generated, once in authored order and once
+// with shuffled triangles like a careless exporter would produce.
+int main() {
+    std::vector<TestMesh> meshes = {Grid(256), Shuffled(Grid(256)), Sphere(256, 512), Shuffled(Sphere(256, 512)),
+                                    Shuffled(Grid(1024))};
+
+    uint32_t maxThreads = std::max(std::thread::hardware_concurrency(), 1U);
+    for (auto &&mesh : meshes) {
+        uint32_t vertexCount = mesh.positions.size() / 3;
+        auto before = MeshOptimizer::AnalyzeVertexCache(mesh.indices, vertexCount);
+
+        std::vector<uint32_t> singleThreaded = mesh.indices;
+        auto start = std::chrono::high_resolution_clock::now();
+        MeshOptimizer::OptimizeVertexCache(singleThreaded, vertexCount, 1);
+        auto end = std::chrono::high_resolution_clock::now();
+        auto singleTime = std::chrono::duration_cast<std::chrono::milliseconds>(end - start);
+
+        std::vector<uint32_t> multiThreaded = mesh.indices;
+        start = std::chrono::high_resolution_clock::now();
+        MeshOptimizer::OptimizeVertexCache(multiThreaded, vertexCount, maxThreads);
+        end = std::chrono::high_resolution_clock::now();
+        auto multiTime = std::chrono::duration_cast<std::chrono::milliseconds>(end - start);
+
+        auto after = MeshOptimizer::AnalyzeVertexCache(multiThreaded, vertexCount);
+        bool deterministic = singleThreaded == multiThreaded;
+
+        std::vector<char> vertices(
+            (char *)mesh.positions.data(), (char *)(mesh.positions.data() + mesh.positions.size())
+        );
+        uint32_t usedVertices = MeshOptimizer::OptimizeVertexFetch(multiThreaded, vertices, sizeof(float) * 3);
+        std::vector<uint32_t> lod =
+            MeshOptimizer::Simplify(multiThreaded, vertices, sizeof(float) * 3, 0, multiThreaded.size() / 4);
+
+        start = std::chrono::high_resolution_clock::now();
+        Meshlets meshlets = MeshletBuilder().Build(multiThreaded, vertices, sizeof(float) * 3);
+        end = std::chrono::high_resolution_clock::now();
+        auto meshletTime = std::chrono::duration_cast<std::chrono::milliseconds>(end - start);
+
+        std::cout << mesh.name << ": " << mesh.indices.size() / 3 << " triangles, " << vertexCount << " vertices\n"
+                  << "  ACMR " << before.acmr << " -> " << after.acmr << ", ATVR " << before.atvr << " -> "
+                  << after.atvr << '\n'
+                  << "  optimized in " << singleTime << " on 1 thread, " << multiTime << " on " << maxThreads
+                  << " threads, results " << (deterministic ? "identical" : "DIFFERENT") << '\n'
+                  << "  " << usedVertices << " vertices after fetch optimization, LOD with "
+                  << lod.size() / 3 << " triangles\n"
+                  << "  " << meshlets.meshlets.size() << " meshlets, "
+                  << (float)meshlets.vertices.size() / (multiThreaded.size() / 3)
+                  << " meshlet vertices per triangle, built in " << meshletTime << '\n';
+
+    }
+}
@@ -0,0 +1,69 @@
+#include <iostream>
+#include <chrono>
+#include <algorithm>
+#include <vector>
+#include "Instance.h"
+#include "Device.h"
+#include "Shader.h"
+#include "MappedFile.h"
+#include "ComputePipeline.h"
+#include "PipelineCompiler.h"
+
+using namespace vg;
+
+int main() {
+    Instance instance(
+        {},
+        [](MessageSeverity severity, const char *message) {
+            if (severity < MessageSeverity::Warning) return;
+            std::cout << message << '\n' << '\n';
+        },
+        false
+    );
+    vg::instance = &instance;
+    Queue computeQueue({QueueType::Compute}, 1.0f);
+    Device computeDevice(
+        {&computeQueue}, {}, {},
+        [](auto id, auto supportedQueues, auto supportedExtensions, auto type, DeviceLimits limits,
+           DeviceFeatures features) { return (type == DeviceType::Dedicated) ? 2 : 1; }
+    );
+    vg::currentDevice = &computeDevice;
+
+    PipelineLayout pipelineLayout(
+        {{DescriptorSetLayoutBinding(0, DescriptorType::StorageBuffer, 1, ShaderStage::Compute)}},
+        {PushConstantRange(ShaderStage::Compute, 0, sizeof(int) * 3)}
+    );
+
+    uint32_t maxThreads = std::max(std::thread::hardware_concurrency(), 1U);
+    std::vector<uint32_t> threadCounts;
+    for (uint32_t threadCount = 1; threadCounts.empty() || threadCounts.back() < maxThreads; threadCount *= 2)
+        threadCounts.push_back(std::min(threadCount, maxThreads));
+
+    // Every pipeline in every round gets its own workgroup size, so no compiled pipeline can be reused within a run.
+    // Drivers with an on disk shader cache may still hit it on later runs.
+    DeviceLimits limits = computeDevice.GetLimits();
+    uint32_t maxWorkgroupSize = std::min(limits.maxComputeWorkGroupInvocations, limits.maxComputeWorkGroupSize[0]);
+    uint32_t pipelineCount = maxWorkgroupSize / threadCounts.size();
+    MappedFile code("resources/shaders/wariacje.comp.spv");
+    Span<const uint32_t> words((const uint32_t *)code.GetData(), code.GetSize() / sizeof(uint32_t));
+
+    for (uint32_t round = 0; round < threadCounts.size(); round++) {
+        std::vector<Shader> shaders;
+        shaders.reserve(pipelineCount);
+        for (uint32_t i = 0; i < pipelineCount; i++) {
+            shaders.emplace_back(ShaderStage::Compute, words);
+            shaders.back().SetSpecialization(SpecializationConstants().Set(0, round * pipelineCount + i + 1));
+        }
+
+        auto start = std::chrono::high_resolution_clock::now();
+        {
+            PipelineCompiler compiler(threadCounts[round]);
+            for (auto &&shader : shaders) compiler.Compile(shader, pipelineLayout);
+            compiler.WaitIdle();
+        }
+        auto end = std::chrono::high_resolution_clock::now();
+
+        std::cout << "Threads: " << threadCounts[round] << " compiled " << pipelineCount << " pipelines in "
+                  << std::chrono::duration_cast<std::chrono::milliseconds>(end - start) << '\n';
+    }
+}
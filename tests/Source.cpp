@@ -5,6 +5,7 @@
 #include "CmdPool.h"
 #include "ComputePipeline.h"
 #include "DescriptorPool.h"
+#include "DescriptorWriter.h"
 #include "Device.h"
 #include "Flags.h"
 #include "FormatInfo.h"
@@ -12,8 +13,13 @@
 #include "Image.h"
 #include "ImageView.h"
 #include "Instance.h"
+#include "InstanceBuffer.h"
 #include "MemoryManager.h"
+#include "MeshOptimizer.h"
+#include "MeshPool.h"
 #include "PipelineCache.h"
+#include "PersistentPipelineCache.h"
+#include "Presenter.h"
 #include "QueryPool.h"
 #include "RenderPass.h"
 #include "Sampler.h"
@@ -149,7 +155,8 @@ int main() {
     msaaSampleCount = (msaaSampleCount >> 1) ^ msaaSampleCount;
 
     Surface surface(windowSurface, {Format::BGRA8SRGB, ColorSpace::SRGBNL});
-    Swapchain swapchain(surface, 2, w, h);
+    Presenter presenter(surface, generalQueue, w, h, 2, 2);
+    const Swapchain &swapchain = presenter.GetSwapchain();
 
     Image colorImage(
         {swapchain.GetWidth(), swapchain.GetHeight()}, surface.GetFormat(),
@@ -165,7 +172,7 @@ int main() {
     ImageView colorImageView(colorImage, {ImageAspect::Color});
     ImageView depthImageView(depthImage, {ImageAspect::Depth});
 
-    PipelineCache pipelineCache("pipelineCache.txt");
+    PersistentPipelineCache pipelineCache("pipelineCache");
     Shader vertexShader(ShaderStage::Vertex, "resources/shaders/shader.vert.spv");
     Shader fragmentShader(ShaderStage::Fragment, "resources/shaders/shader.frag.spv");
 
@@ -269,8 +276,7 @@ int main() {
          )},
         pipelineCache
     );
-    std::vector<char> data = pipelineCache.GetData();
-    std::ofstream("pipelineCache.txt", std::ios_base::binary | std::ios_base::out).write(data.data(), data.size());
+    pipelineCache.Save();
 
     std::vector<Framebuffer> swapChainFramebuffers;
     swapChainFramebuffers.resize(swapchain.GetImageCount());
@@ -280,30 +286,16 @@ int main() {
             swapchain.GetHeight()
         );
 
-    // Allocate buffer in DeviceLocal memory.
-    Buffer vertexBuffer(
-        sizeof(vertices[0]) * vertices.size() + sizeof(indices[0]) * indices.size(),
-        {vg::BufferUsage::VertexBuffer, vg::BufferUsage::IndexBuffer, vg::BufferUsage::TransferDst}
+    // Optimize the mesh, then suballocate it from shared vertex and index buffers.
+    std::vector<uint32_t> optimizedIndices(indices.begin(), indices.end());
+    std::vector<char> optimizedVertices(
+        (const char *)vertices.data(), (const char *)(vertices.data() + vertices.size())
     );
-    vg::Allocate({&vertexBuffer}, {MemoryProperty::DeviceLocal});
-    {
-        // Allocate staging buffer in HostVisible memory.
-        Buffer stagingBuffer(vertexBuffer.GetSize(), vg::BufferUsage::TransferSrc);
-        vg::Allocate({&stagingBuffer}, {MemoryProperty::HostVisible});
-        memcpy(stagingBuffer.MapMemory(), vertices.data(), sizeof(vertices[0]) * vertices.size());
-        memcpy(
-            stagingBuffer.MapMemory() + sizeof(vertices[0]) * vertices.size(), indices.data(),
-            sizeof(indices[0]) * indices.size()
-        );
+    MeshOptimizer::Optimize(optimizedIndices, optimizedVertices, sizeof(Vertex));
 
-        // Copy staging data to vertex buffer
-        vg::CmdBuffer(generalQueue)
-            .Begin()
-            .Append(cmd::CopyBuffer(stagingBuffer, vertexBuffer, {BufferCopyRegion{vertexBuffer.GetSize()}}))
-            .End()
-            .Submit()
-            .Await();
-    }
+    MeshPool meshPool(sizeof(Vertex), 1024, 4096, IndexType::Uint16);
+    Mesh mesh = meshPool.Add(optimizedVertices, optimizedIndices);
+    meshPool.Flush(generalQueue);
 
     Buffer uniformBuffers(sizeof(UniformBufferObject) * swapchain.GetImageCount(), BufferUsage::UniformBuffer);
     vg::Debug::SetName(uniformBuffers, "uniformBuffers");
@@ -374,15 +366,18 @@ int main() {
     std::vector<vg::DescriptorSet> descriptorSets = descriptorPool.Allocate(layouts);
 
     uint64_t offsetAlignment = currentDevice->GetLimits().minUniformBufferOffsetAlignment;
+    DescriptorWriter descriptorWriter;
     for (size_t i = 0; i < descriptorSets.size(); i++) {
-        descriptorSets[i].AttachBuffer(
-            DescriptorType::UniformBuffer, uniformBuffers,
-            (sizeof(UniformBufferObject) * i / offsetAlignment) * offsetAlignment, sizeof(UniformBufferObject), 0, 0
+        descriptorWriter.WriteBuffer(
+            descriptorSets[i], 0, DescriptorType::UniformBuffer, uniformBuffers,
+            (sizeof(UniformBufferObject) * i / offsetAlignment) * offsetAlignment, sizeof(UniformBufferObject)
         );
-        descriptorSets[i].AttachImage(
-            DescriptorType::CombinedImageSampler, ImageLayout::ShaderReadOnlyOptimal, imageView, sampler, 1, 0
+        descriptorWriter.WriteImage(
+            descriptorSets[i], 1, DescriptorType::CombinedImageSampler, ImageLayout::ShaderReadOnlyOptimal, imageView,
+            sampler
         );
     }
+    descriptorWriter.Flush();
 
     /// Compute part
     Queue computeQueue({QueueType::Compute}, 1);
@@ -441,68 +436,58 @@ int main() {
     );
 
     for (size_t i = 0; i < descriptorSets1.size(); i++) {
-        descriptorSets1[i].AttachBuffer(
-            DescriptorType::StorageBuffer, shaderStorageBuffers[(i - 1) % swapchain.GetImageCount()], 0,
-            shaderStorageBuffers[i].GetSize(), 0, 0
+        descriptorWriter.WriteBuffer(
+            descriptorSets1[i], 0, DescriptorType::StorageBuffer,
+            shaderStorageBuffers[(i - 1) % swapchain.GetImageCount()], 0, shaderStorageBuffers[i].GetSize()
         );
-        descriptorSets1[i].AttachBuffer(
-            DescriptorType::StorageBuffer, shaderStorageBuffers[i], 0, shaderStorageBuffers[i].GetSize(), 1, 0
+        descriptorWriter.WriteBuffer(
+            descriptorSets1[i], 1, DescriptorType::StorageBuffer, shaderStorageBuffers[i], 0,
+            shaderStorageBuffers[i].GetSize()
         );
     }
+    descriptorWriter.Flush();
     CmdBuffer computeCmdBuffer(computeQueue);
     QueryPool query(vg::QueryType::Timestamp, 2);
     SCOPED_DEVICE_CHANGE(&rendererDevice);
-    Buffer particleBuffer(sizeof(Particle) * particleCount, {BufferUsage::VertexBuffer});
-    vg::Allocate(&particleBuffer, {MemoryProperty::HostVisible, MemoryProperty::HostCoherent});
-
-    std::vector<CmdBuffer> commandBuffer(swapchain.GetImageCount());
-    std::vector<Semaphore> renderFinishedSemaphore(swapchain.GetImageCount()),
-        imageAvailableSemaphore(swapchain.GetImageCount());
-    std::vector<Fence> inFlightFence(swapchain.GetImageCount());
-    for (int i = 0; i < swapchain.GetImageCount(); i++) {
-        commandBuffer[i] = CmdBuffer(generalQueue);
-        renderFinishedSemaphore[i] = Semaphore();
-        imageAvailableSemaphore[i] = Semaphore();
-        inFlightFence[i] = Fence(true);
-    }
+    InstanceBuffer particleBuffer(
+        sizeof(Particle), particleCount, swapchain.GetImageCount(), BufferUsage::VertexBuffer,
+        PipelineStage::VertexInput
+    );
+
+    PerFrame<CmdBuffer> commandBuffer(presenter, generalQueue);
+    presenter.SetRecreateCallback([&](const Swapchain &swapchain) {
+        colorImage = Image(
+            {swapchain.GetWidth(), swapchain.GetHeight()}, surface.GetFormat(),
+            {ImageUsage::ColorAttachment, ImageUsage::TransientAttachment}, 1, 1, ImageTiling::Optimal,
+            ImageLayout::Undefined, msaaSampleCount
+        );
+        depthImage = Image(
+            {swapchain.GetWidth(), swapchain.GetHeight()}, depthImage.GetFormat(), {ImageUsage::DepthStencilAttachment},
+            1, 1, ImageTiling::Optimal, ImageLayout::Undefined, msaaSampleCount
+        );
+        Allocate(Span<Image *const>{&depthImage, &colorImage}, {MemoryProperty::DeviceLocal});
+        colorImageView = ImageView(colorImage, {ImageAspect::Color});
+        depthImageView = ImageView(depthImage, {ImageAspect::Depth});
+        swapChainFramebuffers.resize(swapchain.GetImageCount());
+        for (int i = 0; i < swapchain.GetImageCount(); i++)
+            swapChainFramebuffers[i] = Framebuffer(
+                renderPass, {colorImageView, depthImageView, swapchain.GetImageViews()[i]}, swapchain.GetWidth(),
+                swapchain.GetHeight()
+            );
+    });
 
     UniformBufferObject ubo{glm::mat4(1.0f)};
-    uint32_t currentFrame = 0;
     while (!glfwWindowShouldClose(window)) {
         glfwPollEvents();
         if (glfwGetKey(window, GLFW_KEY_ESCAPE)) glfwSetWindowShouldClose(window, true);
 
-        inFlightFence[currentFrame].Await(true);
-
-        // Swapchain resize.
-        Swapchain oldSwapchain;
         if (recreateFramebuffer) {
-            currentDevice->WaitUntilIdle();
             recreateFramebuffer = false;
             glfwGetFramebufferSize(window, &w, &h);
-            std::swap(oldSwapchain, swapchain);
-            swapchain = Swapchain(surface, 2, w, h, oldSwapchain);
-            colorImage = Image(
-                {swapchain.GetWidth(), swapchain.GetHeight()}, surface.GetFormat(),
-                {ImageUsage::ColorAttachment, ImageUsage::TransientAttachment}, 1, 1, ImageTiling::Optimal,
-                ImageLayout::Undefined, msaaSampleCount
-            );
-            depthImage = Image(
-                {swapchain.GetWidth(), swapchain.GetHeight()}, depthImage.GetFormat(),
-                {ImageUsage::DepthStencilAttachment}, 1, 1, ImageTiling::Optimal, ImageLayout::Undefined,
-                msaaSampleCount
-            );
-            Allocate(Span<Image *const>{&depthImage, &colorImage}, {MemoryProperty::DeviceLocal});
-            colorImageView = ImageView(colorImage, {ImageAspect::Color});
-            depthImageView = ImageView(depthImage, {ImageAspect::Depth});
-            for (int i = 0; i < swapchain.GetImageCount(); i++)
-                swapChainFramebuffers[i] = Framebuffer(
-                    renderPass, {colorImageView, depthImageView, swapchain.GetImageViews()[i]}, swapchain.GetWidth(),
-                    swapchain.GetHeight()
-                );
+            presenter.Resize(w, h);
         }
-
-        auto [imageIndex, result] = swapchain.GetNextImageIndex(imageAvailableSemaphore[currentFrame]);
+        if (!presenter.Acquire()) continue;
+        uint32_t imageIndex = presenter.GetImageIndex();
 
         currentDevice = &computeDevice;
         computeCmdBuffer.Begin({})
@@ -520,7 +505,8 @@ int main() {
         auto [start, end] = query.GetResults<uint64_t, uint64_t>(2, 0, vg::QueryResult::_64Bit);
 
         currentDevice = &rendererDevice;
-        memcpy(particleBuffer.MapMemory(), shaderStorageBuffers[imageIndex].MapMemory(), particleBuffer.GetSize());
+        Buffer &particles = shaderStorageBuffers[imageIndex];
+        particleBuffer.Write(0, Span<const char>(particles.MapMemory(), particles.GetSize()));
 
         ubo.model = glm::rotate(ubo.model, glm::radians(0.3f), glm::vec3(0.0f, 0.0f, 1.0f));
         ubo.view = glm::lookAt(glm::vec3(2.0f, 2.0f, 2.0f), glm::vec3(0.0f, 0.0f, 0.0f), glm::vec3(0.0f, 0.0f, 1.0f));
@@ -529,10 +515,10 @@ int main() {
         ubo.proj[1][1] *= -1;
         memcpy(uniformBuffers.MapMemory() + imageIndex * sizeof(ubo), &ubo, sizeof(ubo));
 
-        commandBuffer[currentFrame]
-            .Clear()
-            .Begin()
-            .Append(
+        commandBuffer->Clear().Begin();
+        particleBuffer.Upload(*commandBuffer);
+        commandBuffer
+            ->Append(
                 cmd::BeginRenderpass(
                     renderPass, swapChainFramebuffers[imageIndex], {0, 0},
                     {swapchain.GetWidth(), swapchain.GetHeight()},
@@ -543,26 +529,22 @@ int main() {
                 cmd::BindDescriptorSets(
                     renderPass.GetPipelineLayouts()[0], PipelineBindPoint::Graphics, 0, {descriptorSets[imageIndex]}
                 ),
-                cmd::BindVertexBuffers(vertexBuffer, 0),
-                cmd::BindIndexBuffer(vertexBuffer, sizeof(vertices[0]) * vertices.size(), IndexType::Uint16),
+                meshPool.Bind(),
                 cmd::SetViewport(Viewport(swapchain.GetWidth(), swapchain.GetHeight())),
                 cmd::SetScissor(Scissor(swapchain.GetWidth(), swapchain.GetHeight())),
                 cmd::PushConstants(renderPass.GetPipelineLayouts()[0], {ShaderStage::Vertex}, 0, glm::vec3(-2, 0, 0)),
-                cmd::DrawIndexed(indices.size()),
+                mesh.Draw(),
                 cmd::PushConstants(renderPass.GetPipelineLayouts()[0], {ShaderStage::Vertex}, 0, glm::vec3(0, 0, 0)),
-                cmd::DrawIndexed(indices.size()), cmd::NextSubpass(SubpassContents::Inline),
-                cmd::BindPipeline(renderPass.GetPipelines()[1]), cmd::BindVertexBuffers(particleBuffer, 0),
+                mesh.Draw(), cmd::NextSubpass(SubpassContents::Inline),
+                cmd::BindPipeline(renderPass.GetPipelines()[1]), cmd::BindVertexBuffers(particleBuffer.GetBuffer(), 0),
                 cmd::Draw(particleCount), cmd::EndRenderpass()
             )
-            .End()
-            .Submit(
-                {{PipelineStage::ColorAttachmentOutput, imageAvailableSemaphore[currentFrame]}},
-                {renderFinishedSemaphore[currentFrame]}, inFlightFence[currentFrame]
-            );
-        generalQueue.Present({renderFinishedSemaphore[currentFrame]}, {swapchain}, {imageIndex});
+            .End();
+        presenter.Submit(*commandBuffer);
+        presenter.Present();
 
-        currentFrame = (currentFrame + 1) % swapchain.GetImageCount();
+        particleBuffer.NextFrame();
     }
-    Fence::AwaitAll(inFlightFence);
+    presenter.WaitIdle();
     vg::currentDevice->WaitUntilIdle();
 }
@@ -15,6 +15,8 @@
 #include "ComputePipeline.h"
 #include "PipelineCache.h"
 #include "QueryPool.h"
+#include "Readback.h"
+#include "ShaderReflection.h"
 
 using namespace std::chrono_literals;
 using namespace vg;
@@ -43,16 +45,18 @@ int main() {
     int iloscWariacji = pow(n, k);
 
     // Stwórz buffer dla wariacji.
-    Buffer bufferWariacji(iloscWariacji * k * sizeof(int), {BufferUsage::StorageBuffer});
-    Allocate(&bufferWariacji, {MemoryProperty::HostVisible, MemoryProperty::HostCoherent});
+    Buffer bufferWariacji(iloscWariacji * k * sizeof(int), {BufferUsage::StorageBuffer, BufferUsage::TransferSrc});
+    Allocate(&bufferWariacji, {MemoryProperty::DeviceLocal});
+    Readback readback(computeQueue, bufferWariacji.GetSize());
 
     // Stwórz pipeline i descriptory.
     Shader computeShader(ShaderStage::Compute, "resources/shaders/wariacje.comp.spv");
+    // Layout jest odczytany z shadera, rozmiar grupy jest ustawiony przy tworzeniu pipelinu.
+    ShaderReflection computeReflection("resources/shaders/wariacje.comp.spv");
+    const uint32_t rozmiarGrupy = 256;
     ComputePipeline computePipeline(
-        computeShader, PipelineLayout(
-                           {{DescriptorSetLayoutBinding(0, DescriptorType::StorageBuffer, 1, ShaderStage::Compute)}},
-                           {PushConstantRange(ShaderStage::Compute, 0, sizeof(int) * 3)}
-                       )
+        computeShader, computeReflection.CreatePipelineLayout(),
+        SpecializationConstants().SetWorkgroupSize(computeReflection, rozmiarGrupy)
     );
 
     DescriptorPool descriptorPool(1, {{DescriptorType::StorageBuffer, 1}});
@@ -60,7 +64,7 @@ int main() {
     descriptorPool.Allocate(computePipeline.GetPipelineLayout().GetDescriptorSets()[0], &descriptorSet);
     descriptorSet.AttachBuffer(DescriptorType::StorageBuffer, bufferWariacji, 0, bufferWariacji.GetSize(), 0, 0);
 
-    int threadGroupCount = std::ceil(iloscWariacji / 1024.0); // dzielone przez 1024 bo taki jest rozmiar grupy
+    int threadGroupCount = std::ceil(iloscWariacji / (float)rozmiarGrupy);
     auto start = std::chrono::high_resolution_clock::now();
     CmdBuffer cmdBuffer(computeQueue);
     cmdBuffer.Begin({})
@@ -84,7 +88,9 @@ int main() {
               << "Czas na wariacje: "
               << std::chrono::duration_cast<std::chrono::nanoseconds>(end - start) / float(iloscWariacji) << '\n';
 
-    int *wariacje = (int *)bufferWariacji.MapMemory();
+    auto wyniki = readback.Read<int>(bufferWariacji, iloscWariacji * k);
+    readback.Flush();
+    std::vector<int> wariacje = wyniki.get();
     if (n <= 4 && k <= 4) {
         for (int i = 0; i < iloscWariacji; i++) {
             for (int j = 0; j < k - 1; j++) std::cout << (int)wariacje[i * k + j] << ", ";